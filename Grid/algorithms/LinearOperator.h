@@ -277,6 +277,14 @@ template<class Matrix,class Field>
       axpy(out,-1.0,tmp,out);
     }
 };
+// Same operator through the fused per site path of the matrix (Cayley fifth dimension, compact clover)
+template<class Matrix,class Field>
+  class SchurDiagMooeeFusedOperator :  public SchurDiagMooeeOperator<Matrix,Field> {
+ public:
+    SchurDiagMooeeFusedOperator (Matrix &Mat): SchurDiagMooeeOperator<Matrix,Field>(Mat){};
+    virtual void Mpc      (const Field &in, Field &out) { this->_Mat.MpcFused(in,out);    }
+    virtual void MpcDag   (const Field &in, Field &out) { this->_Mat.MpcDagFused(in,out); }
+};
 template<class Matrix,class Field>
   class SchurDiagOneOperator :  public SchurOperatorBase<Field> {
  protected:
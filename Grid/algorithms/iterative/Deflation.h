@@ -74,12 +74,15 @@ public:
   } 
 
   virtual void operator()(const Field &src,Field &guess) {
-    guess = Zero();
-    for (int i=0;i<N;i++) {
-      const Field& tmp = evec[i];
-      axpy(guess,TensorRemove(innerProduct(tmp,src)) / eval[i],tmp,guess);
-    }
-    guess.Checkerboard() = src.Checkerboard();
+    std::vector<Field> src_v(1,src);
+    std::vector<Field> guess_v(1,src.Grid());
+    (*this)(src_v,guess_v);
+    guess = std::move(guess_v[0]);
+  }
+
+  // All N x Nsrc inner products in one blocked sweep and a single global sum
+  virtual void operator()(const std::vector<Field> &src,std::vector<Field> &guess) {
+    basisDeflate(evec,eval,N,src,guess);
   }
 };
 
@@ -129,16 +132,8 @@ public:
     blockProject(src_coarse[j],src[j],subspace);
     }
     //deflation set up for eigen vector batchsize 1 and source batch size equal number of sources
-    std::cout << GridLogMessage << "Start ProjectAccum for loop" << std::endl;
-    for (int i=0;i<Nevec;i++)
-    {
-      std::cout << GridLogMessage << "ProjectAccum Nvec: " << i << std::endl;
-      const CoarseField & tmp = evec_coarse[i];
-      for (int j=0;j<Nsrc;j++)
-      {
-        axpy(guess_coarse[j],TensorRemove(innerProduct(tmp,src_coarse[j])) / eval_coarse[i],tmp,guess_coarse[j]);
-      }
-    }
+    std::cout << GridLogMessage << "Start ProjectAccum" << std::endl;
+    basisDeflate(evec_coarse,eval_coarse,Nevec,src_coarse,guess_coarse);
     //postprocessing
     std::cout << GridLogMessage << "Start BlockPromote for loop" << std::endl;
     for (int j=0;j<Nsrc;j++)
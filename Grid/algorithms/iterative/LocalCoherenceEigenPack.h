@@ -0,0 +1,295 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./lib/algorithms/iterative/LocalCoherenceEigenPack.h
+
+    Copyright (C) 2015
+
+Author: paboyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+*************************************************************************************/
+/*  END LEGAL */
+#ifndef GRID_LOCAL_COHERENCE_EIGENPACK_H
+#define GRID_LOCAL_COHERENCE_EIGENPACK_H
+
+NAMESPACE_BEGIN(Grid);
+
+////////////////////////////////////////////////////////////////////////////////
+// Compressed storage of the LocalCoherenceLanczos output.
+//
+// The nbasis fine block vectors plus neig coarse coefficient vectors represent
+// neig fine eigenvectors. On disk this is three files sharing a stem:
+//
+//   stem.basis   nbasis fine fields, full precision, BinaryIO lexicographic
+//   stem.coarse  neig coarse fields; the first nfull in full precision,
+//                the remainder (higher modes) truncated to single precision
+//   stem.xml     header with sizes, formats, evals and per-vector checksums
+//
+// Fine eigenvectors are only ever rebuilt one at a time via blockPromote;
+// deflation works on the coarse coefficients and needs none of them.
+////////////////////////////////////////////////////////////////////////////////
+struct LocalCoherenceEigenPackHeader : Serializable {
+public:
+  GRID_SERIALIZABLE_CLASS_MEMBERS(LocalCoherenceEigenPackHeader,
+				  int, nbasis,
+				  int, neig,
+				  int, nfull,
+				  std::string, basis_format,
+				  std::string, coarse_format,
+				  std::string, coarse_reduced_format,
+				  std::vector<RealD>, eval,
+				  std::vector<uint32_t>, basis_checksuma,
+				  std::vector<uint32_t>, basis_checksumb,
+				  std::vector<uint32_t>, coarse_checksuma,
+				  std::vector<uint32_t>, coarse_checksumb);
+};
+
+template<class Fobj,class CComplex,int nbasis>
+class LocalCoherenceEigenPack
+{
+public:
+  typedef iVector<CComplex,nbasis >                         CoarseSiteVector;
+  typedef Lattice<CoarseSiteVector>                         CoarseField;
+  typedef Lattice<Fobj>                                     FineField;
+
+  typedef typename Fobj::scalar_object                      FineSobj;
+  typedef typename CoarseSiteVector::scalar_object          CoarseSobj;
+  typedef iVector<ComplexF,nbasis>                          CoarseSobjF;
+  typedef typename Fobj::Realified::scalar_type             FineWord;
+  typedef typename CoarseSiteVector::Realified::scalar_type CoarseWord;
+
+  std::vector<RealD>       eval;
+  std::vector<FineField>   subspace;
+  std::vector<CoarseField> evec_coarse;
+
+private:
+  GridBase *_FineGrid;
+  GridBase *_CoarseGrid;
+  int _checkerboard;
+
+  static std::string ioFormat(int wordsize) { return (wordsize==sizeof(float)) ? std::string("IEEE32BIG") : std::string("IEEE64BIG"); }
+
+public:
+
+  LocalCoherenceEigenPack(GridBase *FineGrid,GridBase *CoarseGrid,int checkerboard) :
+    _FineGrid(FineGrid),
+    _CoarseGrid(CoarseGrid),
+    _checkerboard(checkerboard)
+  {};
+
+  int size(void) const { return evec_coarse.size(); }
+
+  void resize(int neig)
+  {
+    eval.resize(neig);
+    subspace.resize(nbasis,_FineGrid);
+    evec_coarse.resize(neig,_CoarseGrid);
+    for(int b=0;b<nbasis;b++) subspace[b].Checkerboard()=_checkerboard;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  // Fine eigenvector i, rebuilt on demand from its coarse coefficients
+  ////////////////////////////////////////////////////////////////////////////
+  void reconstruct(int i,FineField &evec) const
+  {
+    assert(i<evec_coarse.size());
+    assert(subspace.size()==nbasis);
+    evec.Checkerboard()=_checkerboard;
+    blockPromote(evec_coarse[i],evec,subspace);
+  }
+  void reconstruct(std::vector<FineField> &evec,int N) const
+  {
+    assert(N<=evec_coarse.size());
+    evec.resize(N,_FineGrid);
+    for(int i=0;i<N;i++) reconstruct(i,evec[i]);
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  // Parallel write; coarse vectors i>=nfull are stored in single precision.
+  // nfull<0 keeps every coarse vector in full precision.
+  ////////////////////////////////////////////////////////////////////////////
+  void write(const std::string &stem,int nfull=-1)
+  {
+    int neig = evec_coarse.size();
+    if ( (nfull<0) || (nfull>neig) ) nfull = neig;
+    assert(subspace.size()==nbasis);
+    assert(eval.size()==neig);
+
+    LocalCoherenceEigenPackHeader header;
+    header.nbasis = nbasis;
+    header.neig   = neig;
+    header.nfull  = nfull;
+    header.basis_format          = ioFormat(sizeof(FineWord));
+    header.coarse_format         = ioFormat(sizeof(CoarseWord));
+    header.coarse_reduced_format = ioFormat(sizeof(float));
+    header.eval = eval;
+
+    uint32_t nersc_csum,scidac_csuma,scidac_csumb;
+    GridStopWatch timer;
+
+    timer.Start();
+    std::string file = stem + ".basis";
+    uint64_t offset = 0;
+    for(int b=0;b<nbasis;b++){
+      BinarySimpleUnmunger<FineSobj,FineSobj> munge;
+      BinaryIO::writeLatticeObject<Fobj,FineSobj>(subspace[b],file,munge,offset,header.basis_format,
+						   nersc_csum,scidac_csuma,scidac_csumb);
+      header.basis_checksuma.push_back(scidac_csuma);
+      header.basis_checksumb.push_back(scidac_csumb);
+      offset += _FineGrid->gSites()*sizeof(FineSobj);
+    }
+
+    file = stem + ".coarse";
+    offset = 0;
+    for(int i=0;i<neig;i++){
+      if ( i<nfull ) {
+	BinarySimpleUnmunger<CoarseSobj,CoarseSobj> munge;
+	BinaryIO::writeLatticeObject<CoarseSiteVector,CoarseSobj>(evec_coarse[i],file,munge,offset,header.coarse_format,
+								  nersc_csum,scidac_csuma,scidac_csumb);
+	offset += _CoarseGrid->gSites()*sizeof(CoarseSobj);
+      } else {
+	BinarySimpleUnmunger<CoarseSobjF,CoarseSobj> munge;
+	BinaryIO::writeLatticeObject<CoarseSiteVector,CoarseSobjF>(evec_coarse[i],file,munge,offset,header.coarse_reduced_format,
+								   nersc_csum,scidac_csuma,scidac_csumb);
+	offset += _CoarseGrid->gSites()*sizeof(CoarseSobjF);
+      }
+      header.coarse_checksuma.push_back(scidac_csuma);
+      header.coarse_checksumb.push_back(scidac_csumb);
+    }
+    timer.Stop();
+
+    if ( _FineGrid->IsBoss() ) {
+      XmlWriter WR(stem + ".xml");
+      Grid::write(WR,"LocalCoherenceEigenPack",header);
+    }
+    _FineGrid->Barrier();
+
+    std::cout << GridLogMessage << "LocalCoherenceEigenPack: wrote "<<nbasis<<" basis and "<<neig
+	      <<" coarse vectors ("<<neig-nfull<<" single precision) to "<<stem<<" in "<<timer.Elapsed()<<std::endl;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  // Parallel read, checksums verified against the header
+  ////////////////////////////////////////////////////////////////////////////
+  void read(const std::string &stem)
+  {
+    LocalCoherenceEigenPackHeader header;
+    {
+      XmlReader RD(stem + ".xml");
+      Grid::read(RD,"LocalCoherenceEigenPack",header);
+    }
+    assert(header.nbasis==nbasis);
+    assert(header.eval.size()==header.neig);
+    assert(header.basis_format ==ioFormat(sizeof(FineWord)));
+    assert(header.coarse_format==ioFormat(sizeof(CoarseWord)));
+
+    int neig  = header.neig;
+    int nfull = header.nfull;
+    resize(neig);
+    eval = header.eval;
+
+    uint32_t nersc_csum,scidac_csuma,scidac_csumb;
+    GridStopWatch timer;
+
+    timer.Start();
+    std::string file = stem + ".basis";
+    uint64_t offset = 0;
+    for(int b=0;b<nbasis;b++){
+      BinarySimpleMunger<FineSobj,FineSobj> munge;
+      BinaryIO::readLatticeObject<Fobj,FineSobj>(subspace[b],file,munge,offset,header.basis_format,
+						  nersc_csum,scidac_csuma,scidac_csumb);
+      if ( (scidac_csuma!=header.basis_checksuma[b]) || (scidac_csumb!=header.basis_checksumb[b]) ) {
+	std::cout << GridLogError << "LocalCoherenceEigenPack: checksum mismatch on basis vector "<<b<<" in "<<file<<std::endl;
+	exit(EXIT_FAILURE);
+      }
+      offset += _FineGrid->gSites()*sizeof(FineSobj);
+    }
+
+    file = stem + ".coarse";
+    offset = 0;
+    for(int i=0;i<neig;i++){
+      if ( i<nfull ) {
+	BinarySimpleMunger<CoarseSobj,CoarseSobj> munge;
+	BinaryIO::readLatticeObject<CoarseSiteVector,CoarseSobj>(evec_coarse[i],file,munge,offset,header.coarse_format,
+								 nersc_csum,scidac_csuma,scidac_csumb);
+	offset += _CoarseGrid->gSites()*sizeof(CoarseSobj);
+      } else {
+	BinarySimpleMunger<CoarseSobjF,CoarseSobj> munge;
+	BinaryIO::readLatticeObject<CoarseSiteVector,CoarseSobjF>(evec_coarse[i],file,munge,offset,header.coarse_reduced_format,
+								  nersc_csum,scidac_csuma,scidac_csumb);
+	offset += _CoarseGrid->gSites()*sizeof(CoarseSobjF);
+      }
+      if ( (scidac_csuma!=header.coarse_checksuma[i]) || (scidac_csumb!=header.coarse_checksumb[i]) ) {
+	std::cout << GridLogError << "LocalCoherenceEigenPack: checksum mismatch on coarse vector "<<i<<" in "<<file<<std::endl;
+	exit(EXIT_FAILURE);
+      }
+    }
+    timer.Stop();
+
+    std::cout << GridLogMessage << "LocalCoherenceEigenPack: read "<<nbasis<<" basis and "<<neig
+	      <<" coarse vectors from "<<stem<<" in "<<timer.Elapsed()<<std::endl;
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Fine grid deflation from the compressed representation, equivalent to
+// DeflatedGuesser on the promoted vectors. With evec_i = P c_i the overlaps are
+// <c_i, P^dag src>, so the source is projected once, the deflation is done on
+// the coarse grid and the result promoted once.
+////////////////////////////////////////////////////////////////////////////////
+template<class Fobj,class CComplex,int nbasis>
+class LocalCoherenceEigenPackGuesser: public LinearFunction<Lattice<Fobj> > {
+public:
+  typedef Lattice<Fobj> FineField;
+  typedef typename LocalCoherenceEigenPack<Fobj,CComplex,nbasis>::CoarseField CoarseField;
+  using LinearFunction<FineField>::operator();
+private:
+  const LocalCoherenceEigenPack<Fobj,CComplex,nbasis> &pack;
+  const unsigned int N;
+public:
+  LocalCoherenceEigenPackGuesser(const LocalCoherenceEigenPack<Fobj,CComplex,nbasis> &_pack)
+    : LocalCoherenceEigenPackGuesser(_pack,_pack.size())
+  {}
+
+  LocalCoherenceEigenPackGuesser(const LocalCoherenceEigenPack<Fobj,CComplex,nbasis> &_pack,const unsigned int _N)
+    : pack(_pack), N(_N)
+  {
+    assert(N <= pack.size());
+  }
+
+  virtual void operator()(const FineField &src,FineField &guess) {
+    guess = Zero();
+    guess.Checkerboard() = src.Checkerboard();
+    if ( N==0 ) return;
+
+    GridBase *coarse = pack.evec_coarse[0].Grid();
+    CoarseField src_coarse(coarse);
+    CoarseField guess_coarse(coarse);
+    blockProject(src_coarse,src,pack.subspace);
+    guess_coarse = Zero();
+    for (int i=0;i<N;i++) {
+      axpy(guess_coarse,TensorRemove(innerProduct(pack.evec_coarse[i],src_coarse)) / pack.eval[i],pack.evec_coarse[i],guess_coarse);
+    }
+    blockPromote(guess_coarse,guess,pack.subspace);
+    guess.Checkerboard() = src.Checkerboard();
+  }
+};
+
+NAMESPACE_END(Grid);
+#endif
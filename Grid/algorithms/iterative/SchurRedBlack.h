@@ -100,12 +100,14 @@ namespace Grid {
     int CBfactorise;
     bool subGuess;
     bool useSolnAsInitGuess; // if true user-supplied solution vector is used as initial guess for solver
+    Matrix *_SplitMatrix;    // same operator built on a split grid, or NULL
   public:
 
     SchurRedBlackBase(OperatorFunction<Field> &HermitianRBSolver, const bool initSubGuess = false,
         const bool _solnAsInitGuess = false)  :
     _HermitianRBSolver(HermitianRBSolver),
-    useSolnAsInitGuess(_solnAsInitGuess)
+    useSolnAsInitGuess(_solnAsInitGuess),
+    _SplitMatrix(nullptr)
     { 
       CBfactorise = 0;
       subtractGuess(initSubGuess);
@@ -143,8 +145,72 @@ namespace Grid {
     }
     // James can write his own deflated guesser
     // with optimised code for the inner products
-    //    RedBlackSolveSplitGrid();
-    //    RedBlackSolve(_Matrix,src_o,sol_o); 
+
+    /////////////////////////////////////////////////////////////
+    // Split grid multi-RHS.
+    // SplitMatrix is the same operator constructed on a grid with the same
+    // global volume whose communicator is split into Nsplit subcommunicators
+    // (e.g. gauge field moved over with Grid_split). Each batch of Nsplit
+    // sources is redistributed, solved concurrently one per subcommunicator,
+    // and merged back; leftover sources are solved on the full grid.
+    /////////////////////////////////////////////////////////////
+    void SetSplitGridMatrix(Matrix &SplitMatrix) { _SplitMatrix = &SplitMatrix; }
+    void ClearSplitGridMatrix(void)              { _SplitMatrix = nullptr; }
+
+    int SplitGridCount(Matrix &_Matrix)
+    {
+      if ( _SplitMatrix == nullptr ) return 1;
+      GridBase *grid  = _Matrix.RedBlackGrid();
+      GridBase *sgrid = _SplitMatrix->RedBlackGrid();
+      int nsplit = grid->_Nprocessors / sgrid->_Nprocessors;
+      assert(nsplit*sgrid->_Nprocessors == grid->_Nprocessors);
+      return nsplit;
+    }
+
+    void RedBlackSolveSplitGrid(Matrix &_Matrix, std::vector<Field> &src_o, std::vector<Field> &sol_o)
+    {
+      GridBase *grid  = _Matrix.RedBlackGrid();
+      GridBase *sgrid = _SplitMatrix->RedBlackGrid();
+      int nsplit = SplitGridCount(_Matrix);
+      int nblock = src_o.size();
+      int nbatch = nblock/nsplit;
+
+      std::vector<Field> b_src(nsplit,grid);
+      std::vector<Field> b_sol(nsplit,grid);
+      Field s_src(sgrid);
+      Field s_sol(sgrid);
+
+      for(int batch=0;batch<nbatch;batch++){
+	int b0 = batch*nsplit;
+	std::cout<<GridLogMessage << "SchurRedBlackBase split grid solve for RHS "<<b0<<".."<<b0+nsplit-1
+		 <<" on "<<nsplit<<" subcommunicators" <<std::endl;
+	for(int s=0;s<nsplit;s++){
+	  b_src[s] = src_o[b0+s];
+	  b_sol[s] = sol_o[b0+s];
+	}
+	Grid_split  (b_src,s_src);
+	Grid_split  (b_sol,s_sol);
+	RedBlackSolve(*_SplitMatrix,s_src,s_sol);
+	Grid_unsplit(b_sol,s_sol);
+	for(int s=0;s<nsplit;s++){
+	  sol_o[b0+s] = b_sol[s];
+	}
+      }
+
+      int nleft = nblock - nbatch*nsplit;
+      if ( nleft ) {
+	std::vector<Field> l_src(nleft,grid);
+	std::vector<Field> l_sol(nleft,grid);
+	for(int s=0;s<nleft;s++){
+	  l_src[s] = src_o[nbatch*nsplit+s];
+	  l_sol[s] = sol_o[nbatch*nsplit+s];
+	}
+	RedBlackSolve(_Matrix,l_src,l_sol);
+	for(int s=0;s<nleft;s++){
+	  sol_o[nbatch*nsplit+s] = l_sol[s];
+	}
+      }
+    }
 
     void RedBlackSolution(Matrix &_Matrix, const std::vector<Field> &in, const std::vector<Field> &sol_o, std::vector<Field> &out)
     {
@@ -203,7 +269,11 @@ namespace Grid {
       // Call the block solver
       //////////////////////////////////////////////////////////////
       std::cout<<GridLogMessage << "SchurRedBlackBase calling the solver for "<<nblock<<" RHS" <<std::endl;
-      RedBlackSolve(_Matrix,src_o,sol_o);
+      if ( SplitGridCount(_Matrix) > 1 ) {
+	RedBlackSolveSplitGrid(_Matrix,src_o,sol_o);
+      } else {
+	RedBlackSolve(_Matrix,src_o,sol_o);
+      }
 
       ////////////////////////////////////////////////
       // A2A boolean behavioural control & reconstruct other checkerboard
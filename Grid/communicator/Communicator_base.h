@@ -184,6 +184,14 @@ public:
   }
   void AllToAll(int dim  ,void *in,void *out,uint64_t words,uint64_t bytes);
   void AllToAll(void  *in,void *out,uint64_t words         ,uint64_t bytes);
+
+  ////////////////////////////////////////////////////////////
+  // Irregular All2All over the whole communicator; counts and
+  // displacements are per rank, in units of "bytes" sized words
+  ////////////////////////////////////////////////////////////
+  void AllToAllv(void *in ,const std::vector<int> &scounts,const std::vector<int> &sdispls,
+		 void *out,const std::vector<int> &rcounts,const std::vector<int> &rdispls,
+		 uint64_t bytes);
   
   template<class obj> void Broadcast(int root,obj &data)
   {
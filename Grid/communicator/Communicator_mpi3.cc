@@ -478,5 +478,21 @@ void CartesianCommunicator::AllToAll(void  *in,void *out,uint64_t words,uint64_t
   MPI_Alltoall(in,iwords,object,out,iwords,object,communicator);
   MPI_Type_free(&object);
 }
+void CartesianCommunicator::AllToAllv(void *in ,const std::vector<int> &scounts,const std::vector<int> &sdispls,
+				      void *out,const std::vector<int> &rcounts,const std::vector<int> &rdispls,
+				      uint64_t bytes)
+{
+  assert(scounts.size()==_Nprocessors);
+  assert(rcounts.size()==_Nprocessors);
+  MPI_Datatype object;
+  int ibytes = bytes;
+  assert(bytes == ibytes); // safe to cast to int ?
+  MPI_Type_contiguous(ibytes,MPI_BYTE,&object);
+  MPI_Type_commit(&object);
+  int ierr = MPI_Alltoallv(in ,&scounts[0],&sdispls[0],object,
+			   out,&rcounts[0],&rdispls[0],object,communicator);
+  assert(ierr==0);
+  MPI_Type_free(&object);
+}
 
 NAMESPACE_END(Grid);
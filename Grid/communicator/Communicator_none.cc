@@ -97,6 +97,14 @@ void CartesianCommunicator::AllToAll(void  *in,void *out,uint64_t words,uint64_t
 {
   bcopy(in,out,bytes*words);
 }
+void CartesianCommunicator::AllToAllv(void *in ,const std::vector<int> &scounts,const std::vector<int> &sdispls,
+				      void *out,const std::vector<int> &rcounts,const std::vector<int> &rdispls,
+				      uint64_t bytes)
+{
+  assert(scounts.size()==1);
+  assert(scounts[0]==rcounts[0]);
+  bcopy((char *)in+sdispls[0]*bytes,(char *)out+rdispls[0]*bytes,bytes*scounts[0]);
+}
 
 int  CartesianCommunicator::RankWorld(void){return 0;}
 void CartesianCommunicator::Barrier(void){}
@@ -33,18 +33,103 @@ directory
 
 NAMESPACE_BEGIN(Grid);
 
+//////////////////////////////////////////////////////////////////////////////////////
+// The basis kernels below tile over sites; a tile of the "narrow" operand(s)
+// (sources, results, rotated vectors) is sized to stay cache resident while the
+// wide basis streams through it contiguously, once per sweep.
+//////////////////////////////////////////////////////////////////////////////////////
+template<class vobj>
+inline uint64_t basisSiteBlock(int Nvec,uint64_t oSites)
+{
+  const uint64_t tile_bytes = 256*1024;
+  uint64_t siteBlock = tile_bytes/(sizeof(vobj)*Nvec);
+  if ( siteBlock < 1      ) siteBlock = 1;
+  if ( siteBlock > oSites ) siteBlock = oSites;
+  return siteBlock;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////
+// One classical Gram-Schmidt pass: all k inner products against the same w,
+// taken in one sweep with a single global sum, then w updated in a second sweep.
+//////////////////////////////////////////////////////////////////////////////////////
 template<class Field>
-void basisOrthogonalize(std::vector<Field> &basis,Field &w,int k) 
+void basisOrthogonalizePass(std::vector<Field> &basis,Field &w,int k) 
 {
-  // If assume basis[j] are already orthonormal,
-  // can take all inner products in parallel saving 2x bandwidth
-  // Save 3x bandwidth on the second line of loop.
-  // perhaps 2.5x speed up.
-  // 2x overall in Multigrid Lanczos  
-  for(int j=0; j<k; ++j){
-    auto ip = innerProduct(basis[j],w);
-    w = w - ip*basis[j];
+#if defined(GRID_CUDA)||defined(GRID_HIP)||defined(GRID_SYCL)
+  std::vector<ComplexD> ip(k);
+  for(int j=0; j<k; ++j) ip[j] = innerProduct(basis[j],w);
+  for(int j=0; j<k; ++j) w = w - ip[j]*basis[j];
+#else
+  typedef typename Field::vector_object vobj;
+  typedef typename vobj::vector_typeD vector_typeD;
+  typedef typename vobj::scalar_type scalar_type;
+  typedef decltype(basis[0].View(CpuRead)) View;
+
+  GridBase *grid  = w.Grid();
+  uint64_t oSites = grid->oSites();
+  uint64_t siteBlock = basisSiteBlock<vobj>(1,oSites);
+  uint64_t nblock    = (oSites+siteBlock-1)/siteBlock;
+
+  Vector<View> basis_v; basis_v.reserve(k);
+  for(int j=0;j<k;j++) basis_v.push_back(basis[j].View(CpuRead));
+
+  std::vector<ComplexD> ip(k,ComplexD(0.0));
+  {
+    autoView( w_v , w, CpuRead);
+    thread_region
+    {
+      Vector<vector_typeD> acc(k);
+      for(int j=0;j<k;j++) zeroit(acc[j]);
+      thread_for_in_region(b,nblock,{
+	uint64_t s0 = b*siteBlock;
+	uint64_t s1 = MIN(s0+siteBlock,oSites);
+	for(int j=0;j<k;j++){
+	  vector_typeD a = acc[j];
+	  for(uint64_t ss=s0;ss<s1;ss++){
+	    a = a + TensorRemove(innerProductD(basis_v[j][ss],w_v[ss]));
+	  }
+	  acc[j] = a;
+	}
+      });
+      thread_critical
+      {
+	for(int j=0;j<k;j++) ip[j] += Reduce(acc[j]);
+      }
+    }
   }
+  grid->GlobalSumVector(&ip[0],k);
+
+  Vector<scalar_type> c(k);
+  for(int j=0;j<k;j++) c[j] = scalar_type(real(ip[j]),imag(ip[j]));
+  scalar_type *c_p = &c[0];
+  {
+    autoView( w_v , w, CpuWrite);
+    thread_for(b,nblock,{
+      uint64_t s0 = b*siteBlock;
+      uint64_t s1 = MIN(s0+siteBlock,oSites);
+      for(int j=0;j<k;j++){
+	for(uint64_t ss=s0;ss<s1;ss++){
+	  w_v[ss] = w_v[ss] - c_p[j]*basis_v[j][ss];
+	}
+      }
+    });
+  }
+  for(int j=0;j<k;j++) basis_v[j].ViewClose();
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////////////////
+// Assume basis[j] are already orthonormal. A single classical pass loses
+// orthogonality with the square of the condition number, so it is applied
+// twice (CGS2), which is as orthogonal as modified Gram-Schmidt; 4 passes over
+// w and 2 reductions rather than 3k passes and k reductions.
+//////////////////////////////////////////////////////////////////////////////////////
+template<class Field>
+void basisOrthogonalize(std::vector<Field> &basis,Field &w,int k) 
+{
+  if ( k==0 ) return;
+  basisOrthogonalizePass(basis,w,k);
+  basisOrthogonalizePass(basis,w,k);
 }
 
 template<class VField, class Matrix>
@@ -63,21 +148,51 @@ void basisRotate(VField &basis,Matrix& Qt,int j0, int j1, int k0,int k1,int Nm)
   }
 
 #if ( (!defined(GRID_CUDA)) )
+  int nrot = j1-j0;
+  if (!nrot) {
+    for(int k=0;k<basis.size();k++) basis_v[k].ViewClose();
+    return;
+  }
+
+  // Flat copy of the active block of Qt, k-major so the inner j loop is unit stride
+  int nk = k1-k0;
+  Vector<Coeff_t> Qt_kv(nk*nrot);
+  for(int k=0;k<nk;k++){
+    for(int j=0;j<nrot;j++){
+      Qt_kv[k*nrot+j] = Qt(j0+j,k0+k);
+    }
+  }
+  Coeff_t *Qt_p = &Qt_kv[0];
+
+  // Tile of siteBlock sites x nrot rotated vectors per thread; in place rotation
+  // needs the whole j range before any site is written back, so only sites are tiled.
+  uint64_t oSites    = grid->oSites();
+  uint64_t siteBlock = basisSiteBlock<vobj>(nrot,oSites);
+  uint64_t nblock    = (oSites+siteBlock-1)/siteBlock;
+
   int max_threads = thread_max();
-  Vector < vobj > Bt(Nm * max_threads);
+  Vector < vobj > Bt(siteBlock * nrot * max_threads);
   thread_region
     {
-      vobj* B = &Bt[Nm * thread_num()];
-      thread_for_in_region(ss, grid->oSites(),{
-	  for(int j=j0; j<j1; ++j) B[j]=0.;
-      
-	  for(int j=j0; j<j1; ++j){
-	    for(int k=k0; k<k1; ++k){
-	      B[j] +=Qt(j,k) * basis_v[k][ss];
+      vobj* B = &Bt[siteBlock * nrot * thread_num()];
+      thread_for_in_region(b, nblock,{
+	  uint64_t s0 = b*siteBlock;
+	  uint64_t ns = MIN(siteBlock,oSites-s0);
+
+	  for(uint64_t s=0;s<ns*nrot;s++) B[s]=Zero();
+
+	  for(int k=0; k<nk; ++k){
+	    for(uint64_t s=0;s<ns;s++){
+	      const vobj &bk = basis_v[k0+k][s0+s];
+	      for(int j=0; j<nrot; ++j){
+		B[s*nrot+j] += Qt_p[k*nrot+j] * bk;
+	      }
 	    }
 	  }
-	  for(int j=j0; j<j1; ++j){
-	    basis_v[j][ss] = B[j];
+	  for(uint64_t s=0;s<ns;s++){
+	    for(int j=0; j<nrot; ++j){
+	      basis_v[j0+j][s0+s] = B[s*nrot+j];
+	    }
 	  }
 	});
     }
@@ -240,9 +355,164 @@ void basisDeflate(const std::vector<Field> &_v,const std::vector<RealD>& eval,co
   assert(_v.size()==eval.size());
   int N = (int)_v.size();
   for (int i=0;i<N;i++) {
-    Field& tmp = _v[i];
+    const Field& tmp = _v[i];
     axpy(result,TensorRemove(innerProduct(tmp,src_orig)) / eval[i],tmp,result);
   }
 }
 
+//////////////////////////////////////////////////////////////////////////////////////
+// Many vectors against many sources, as two matrix-matrix like sweeps:
+//   ip(i,j)   = <basis[i]|src[j]>                  one pass, one GlobalSumVector
+//   result[j] = sum_i coef(i,j) basis[i]           one pass
+// Sites are tiled so that a tile of every source (or result) stays cache resident
+// while each basis vector streams through exactly once.
+//////////////////////////////////////////////////////////////////////////////////////
+template<class Field>
+void basisInnerProductMatrix(Eigen::MatrixXcd &ip,const std::vector<Field> &basis,int N,const std::vector<Field> &src)
+{
+  typedef typename Field::vector_object vobj;
+  typedef typename vobj::vector_typeD vector_typeD;
+
+  int Nsrc = src.size();
+  assert(N<=basis.size());
+  ip = Eigen::MatrixXcd::Zero(N,Nsrc);
+  if ( (N==0) || (Nsrc==0) ) return;
+
+  GridBase *grid = src[0].Grid();
+
+#if defined(GRID_CUDA)||defined(GRID_HIP)||defined(GRID_SYCL)
+  for(int i=0;i<N;i++){
+  for(int j=0;j<Nsrc;j++){
+    ip(i,j) = rankInnerProduct(basis[i],src[j]);
+  }}
+#else
+  typedef decltype(basis[0].View(CpuRead)) View;
+  Vector<View> basis_v; basis_v.reserve(N);
+  Vector<View> src_v;   src_v.reserve(Nsrc);
+  for(int i=0;i<N;i++)    basis_v.push_back(basis[i].View(CpuRead));
+  for(int j=0;j<Nsrc;j++) src_v.push_back(src[j].View(CpuRead));
+
+  uint64_t oSites    = grid->oSites();
+  uint64_t siteBlock = basisSiteBlock<vobj>(Nsrc,oSites);
+  uint64_t nblock    = (oSites+siteBlock-1)/siteBlock;
+
+  thread_region
+  {
+    std::vector<vector_typeD> acc(N*Nsrc);
+    for(int ij=0;ij<N*Nsrc;ij++) zeroit(acc[ij]);
+
+    thread_for_in_region(b,nblock,{
+      uint64_t s0 = b*siteBlock;
+      uint64_t s1 = MIN(s0+siteBlock,oSites);
+      for(int i=0;i<N;i++){
+	for(uint64_t ss=s0;ss<s1;ss++){
+	  const vobj &e = basis_v[i][ss];
+	  for(int j=0;j<Nsrc;j++){
+	    acc[i*Nsrc+j] = acc[i*Nsrc+j] + TensorRemove(innerProductD(e,src_v[j][ss]));
+	  }
+	}
+      }
+    });
+
+    Eigen::MatrixXcd ip_thread(N,Nsrc);
+    for(int i=0;i<N;i++){
+    for(int j=0;j<Nsrc;j++){
+      auto red = Reduce(acc[i*Nsrc+j]);
+      ip_thread(i,j) = std::complex<double>(real(red),imag(red));
+    }}
+    thread_critical
+    {
+      ip += ip_thread;
+    }
+  }
+
+  for(int i=0;i<N;i++)    basis_v[i].ViewClose();
+  for(int j=0;j<Nsrc;j++) src_v[j].ViewClose();
+#endif
+
+  grid->GlobalSumVector((RealD *)ip.data(),2*N*Nsrc);
+}
+
+template<class Field>
+void basisMatrixAccumulate(std::vector<Field> &result,const std::vector<Field> &basis,int N,const Eigen::MatrixXcd &coef)
+{
+  typedef typename Field::vector_object vobj;
+  typedef typename vobj::scalar_type scalar_type;
+
+  int Nsrc = result.size();
+  assert(N<=basis.size());
+  assert(coef.rows()==N);
+  assert(coef.cols()==Nsrc);
+  if ( Nsrc==0 ) return;
+
+#if defined(GRID_CUDA)||defined(GRID_HIP)||defined(GRID_SYCL)
+  for(int j=0;j<Nsrc;j++){
+    result[j] = Zero();
+    for(int i=0;i<N;i++){
+      ComplexD c = coef(i,j);
+      axpy(result[j],c,basis[i],result[j]);
+    }
+  }
+#else
+  GridBase *grid = result[0].Grid();
+
+  Vector<scalar_type> c(N*Nsrc);
+  for(int i=0;i<N;i++){
+  for(int j=0;j<Nsrc;j++){
+    c[i*Nsrc+j] = scalar_type(coef(i,j).real(),coef(i,j).imag());
+  }}
+  scalar_type *c_p = &c[0];
+
+  typedef decltype(basis[0].View(CpuRead))   View;
+  typedef decltype(result[0].View(CpuWrite)) WView;
+  Vector<View>  basis_v;  basis_v.reserve(N);
+  Vector<WView> result_v; result_v.reserve(Nsrc);
+  for(int i=0;i<N;i++)    basis_v.push_back(basis[i].View(CpuRead));
+  for(int j=0;j<Nsrc;j++) result_v.push_back(result[j].View(CpuWrite));
+
+  uint64_t oSites    = grid->oSites();
+  uint64_t siteBlock = basisSiteBlock<vobj>(Nsrc,oSites);
+  uint64_t nblock    = (oSites+siteBlock-1)/siteBlock;
+
+  thread_for(b,nblock,{
+    uint64_t s0 = b*siteBlock;
+    uint64_t s1 = MIN(s0+siteBlock,oSites);
+    for(uint64_t ss=s0;ss<s1;ss++){
+      for(int j=0;j<Nsrc;j++){
+	result_v[j][ss] = Zero();
+      }
+    }
+    for(int i=0;i<N;i++){
+      for(uint64_t ss=s0;ss<s1;ss++){
+	const vobj &e = basis_v[i][ss];
+	for(int j=0;j<Nsrc;j++){
+	  result_v[j][ss] = result_v[j][ss] + c_p[i*Nsrc+j]*e;
+	}
+      }
+    }
+  });
+
+  for(int i=0;i<N;i++)    basis_v[i].ViewClose();
+  for(int j=0;j<Nsrc;j++) result_v[j].ViewClose();
+#endif
+}
+
+template<class Field>
+void basisDeflate(const std::vector<Field> &_v,const std::vector<RealD>& eval,int N,
+		  const std::vector<Field>& src,std::vector<Field>& result)
+{
+  assert(N<=eval.size());
+  int Nsrc = src.size();
+  Eigen::MatrixXcd ip;
+  basisInnerProductMatrix(ip,_v,N,src);
+  for(int i=0;i<N;i++){
+    ip.row(i) = ip.row(i) / eval[i];
+  }
+  result.resize(Nsrc,src[0].Grid());
+  basisMatrixAccumulate(result,_v,N,ip);
+  for(int j=0;j<Nsrc;j++){
+    result[j].Checkerboard() = src[j].Checkerboard();
+  }
+}
+
 NAMESPACE_END(Grid);
@@ -1176,7 +1176,7 @@ void precisionChange(Lattice<VobjOut> &out, const Lattice<VobjIn> &in)
  *  etc...
  */
 template<class Vobj>
-void Grid_split(std::vector<Lattice<Vobj> > & full,Lattice<Vobj>   & split)
+void Grid_split_dimwise(std::vector<Lattice<Vobj> > & full,Lattice<Vobj>   & split)
 {
   typedef typename Vobj::scalar_object Sobj;
 
@@ -1290,6 +1290,255 @@ void Grid_split(std::vector<Lattice<Vobj> > & full,Lattice<Vobj>   & split)
   vectorizeFromLexOrdArray(alldata,split);    
 }
 
+//////////////////////////////////////////////////////////////////////////////////
+// Single phase split/unsplit.
+//
+// A full grid local volume always lies entirely within one split grid local volume,
+// so full[v] on a full grid rank goes whole to a single rank of subcommunicator v,
+// and each split grid rank receives one full grid local volume from each of the
+// Nvec full grid ranks that tile its own. Vector v is placed on the subcommunicator
+// whose coordinate, processor_coor/split_processors, has lexicographic index v;
+// this is the placement of the per dimension path above.
+//
+// The (oSite,lane) -> buffer offset maps and the AllToAllv counts are built once per
+// (full,split) layout pair and kept in a small cache keyed on the layout, not on the
+// grid pointers, which are reused once a grid is freed; data moves straight from and
+// to the SIMD layout with a single AllToAllv on the full grid communicator.
+//////////////////////////////////////////////////////////////////////////////////
+class GridSplitMap {
+public:
+  std::vector<int> key;
+  Coordinate full_ldims, split_ldims, full_pcoor, split_pcoor;
+
+  int      nvector;
+  uint64_t lsites;              // full grid local sites, the unit of every message
+  std::vector<int> full_lex;    // full  [osite*Nsimd+lane] -> lexicographic site in full local volume
+  std::vector<int> split_off;   // split [osite*Nsimd+lane] -> offset in nvector*lsites buffer
+  std::vector<int> scounts, sdispls, rcounts, rdispls; // split direction; unsplit swaps them
+
+  // Everything the maps and counts depend on
+  static std::vector<int> LayoutKey(GridBase *fg,GridBase *sg) {
+    std::vector<int> key;
+    for(GridBase *g : {fg,sg}) {
+      key.push_back(g->_ndimension);
+      key.push_back(g->_isCheckerBoarded);
+      for(auto c : {&g->_gdimensions,&g->_fdimensions,&g->_ldimensions,&g->_processors,
+	            &g->_processor_coor,&g->_simd_layout,&g->_checker_dim_mask}) {
+	key.push_back(c->size());
+	for(int d=0;d<c->size();d++) key.push_back((*c)[d]);
+      }
+    }
+    return key;
+  }
+
+  GridSplitMap(GridBase *fg,GridBase *sg) : key(LayoutKey(fg,sg))
+  {
+    full_ldims = fg->_ldimensions;    split_ldims = sg->_ldimensions;
+    full_pcoor = fg->_processor_coor; split_pcoor = sg->_processor_coor;
+
+    int ndim = fg->_ndimension;
+    assert(sg->_ndimension==ndim);
+
+    nvector = fg->_Nprocessors/sg->_Nprocessors;
+    assert(nvector*sg->_Nprocessors == fg->_Nprocessors);
+    lsites  = fg->lSites();
+    assert(lsites*nvector == sg->lSites());
+    assert(lsites*nvector < (1ULL<<31));
+
+    Coordinate ratio(ndim);
+    for(int d=0;d<ndim;d++){
+      ratio[d] = fg->_processors[d]/sg->_processors[d];
+      assert(ratio[d]*sg->_processors[d]==fg->_processors[d]);
+      assert(ratio[d]*full_ldims[d]==split_ldims[d]);
+    }
+
+    //////////////////////////////////////////
+    // Where my full[v] go, and where my split pieces come from
+    //////////////////////////////////////////
+    int nrank = fg->_Nprocessors;
+    scounts.resize(nrank,0); sdispls.resize(nrank,0);
+    rcounts.resize(nrank,0); rdispls.resize(nrank,0);
+
+    Coordinate scoor(ndim), pcoor(ndim);
+    for(int v=0;v<nvector;v++){
+      Lexicographic::CoorFromIndex(scoor,v,ratio);
+      for(int d=0;d<ndim;d++){
+	pcoor[d] = scoor[d]*sg->_processors[d] + full_pcoor[d]/ratio[d];
+      }
+      int dest = fg->RankFromProcessorCoor(pcoor);
+      scounts[dest] = lsites;
+      sdispls[dest] = v*lsites;
+    }
+    for(int k=0;k<nvector;k++){
+      Lexicographic::CoorFromIndex(scoor,k,ratio);
+      for(int d=0;d<ndim;d++){
+	pcoor[d] = split_pcoor[d]*ratio[d] + scoor[d];
+      }
+      int from = fg->RankFromProcessorCoor(pcoor);
+      rcounts[from] = lsites;
+      rdispls[from] = k*lsites;
+    }
+
+    //////////////////////////////////////////
+    // Site maps in the SIMD layouts
+    //////////////////////////////////////////
+    int fNsimd = fg->Nsimd();
+    full_lex.resize(fg->oSites()*fNsimd);
+    thread_for(oidx,fg->oSites(),{
+      Coordinate ocoor(ndim), icoor(ndim), lcoor(ndim);
+      fg->oCoorFromOindex(ocoor,oidx);
+      for(int lane=0;lane<fNsimd;lane++){
+	fg->iCoorFromIindex(icoor,lane);
+	for(int d=0;d<ndim;d++) lcoor[d] = ocoor[d] + fg->_rdimensions[d]*icoor[d];
+	int lex; Lexicographic::IndexFromCoor(lcoor,lex,full_ldims);
+	full_lex[oidx*fNsimd+lane] = lex;
+      }
+    });
+
+    int sNsimd = sg->Nsimd();
+    split_off.resize(sg->oSites()*sNsimd);
+    thread_for(oidx,sg->oSites(),{
+      Coordinate ocoor(ndim), icoor(ndim), fcoor(ndim), blk(ndim);
+      sg->oCoorFromOindex(ocoor,oidx);
+      for(int lane=0;lane<sNsimd;lane++){
+	sg->iCoorFromIindex(icoor,lane);
+	for(int d=0;d<ndim;d++) {
+	  int l   = ocoor[d] + sg->_rdimensions[d]*icoor[d];
+	  blk[d]  = l / full_ldims[d];
+	  fcoor[d]= l % full_ldims[d];
+	}
+	int k;   Lexicographic::IndexFromCoor(blk,k,ratio);
+	int lex; Lexicographic::IndexFromCoor(fcoor,lex,full_ldims);
+	split_off[oidx*sNsimd+lane] = k*lsites+lex;
+      }
+    });
+  }
+};
+
+// Most recently used last; the oldest layout is dropped beyond GridSplitMapCacheSize
+static const int GridSplitMapCacheSize = 8;
+inline GridSplitMap & Grid_split_map(GridBase *full_grid,GridBase *split_grid)
+{
+  static std::vector<std::unique_ptr<GridSplitMap> > cache;
+  std::vector<int> key = GridSplitMap::LayoutKey(full_grid,split_grid);
+  for(int m=0;m<cache.size();m++) {
+    if ( cache[m]->key == key ) {
+      std::rotate(cache.begin()+m,cache.begin()+m+1,cache.end());
+      return *cache.back();
+    }
+  }
+  if ( cache.size() >= GridSplitMapCacheSize ) cache.erase(cache.begin());
+  cache.push_back(std::unique_ptr<GridSplitMap>(new GridSplitMap(full_grid,split_grid)));
+  return *cache.back();
+}
+
+template<class Vobj>
+void Grid_split(std::vector<Lattice<Vobj> > & full,Lattice<Vobj>   & split)
+{
+  typedef typename Vobj::scalar_object Sobj;
+
+  int full_vecs   = full.size();
+  assert(full_vecs>=1);
+
+  GridBase * full_grid = full[0].Grid();
+  GridBase *split_grid = split.Grid();
+
+  int cb = full[0].Checkerboard();
+  split.Checkerboard() = cb;
+
+  assert(full_grid->_ndimension==split_grid->_ndimension);
+  for(int n=0;n<full_vecs;n++){
+    assert(full[n].Checkerboard() == cb);
+    assert(full[n].Grid() == full_grid);
+  }
+  for(int d=0;d<full_grid->_ndimension;d++){
+    assert(full_grid->_gdimensions[d]==split_grid->_gdimensions[d]);
+    assert(full_grid->_fdimensions[d]==split_grid->_fdimensions[d]);
+  }
+
+  GridSplitMap &map = Grid_split_map(full_grid,split_grid);
+  assert(map.nvector == full_vecs);
+
+  uint64_t lsites = map.lsites;
+  std::vector<Sobj> sendbuf(lsites*full_vecs);
+  std::vector<Sobj> recvbuf(lsites*full_vecs);
+
+  const int Nsimd = Vobj::Nsimd();
+  for(int v=0;v<full_vecs;v++){
+    autoView( full_v , full[v], CpuRead);
+    Sobj *buf = &sendbuf[v*lsites];
+    thread_for(oidx,full_grid->oSites(),{
+      ExtractPointerArray<Sobj> ptrs(Nsimd);
+      for(int lane=0;lane<Nsimd;lane++) ptrs[lane] = &buf[map.full_lex[oidx*Nsimd+lane]];
+      extract(full_v[oidx],ptrs,0);
+    });
+  }
+
+  full_grid->AllToAllv((void *)&sendbuf[0],map.scounts,map.sdispls,
+		       (void *)&recvbuf[0],map.rcounts,map.rdispls,sizeof(Sobj));
+
+  autoView( split_v , split, CpuWrite);
+  thread_for(oidx,split_grid->oSites(),{
+    ExtractPointerArray<Sobj> ptrs(Nsimd);
+    for(int lane=0;lane<Nsimd;lane++) ptrs[lane] = &recvbuf[map.split_off[oidx*Nsimd+lane]];
+    merge(split_v[oidx],ptrs,0);
+  });
+}
+
+template<class Vobj>
+void Grid_unsplit(std::vector<Lattice<Vobj> > & full,Lattice<Vobj>   & split)
+{
+  typedef typename Vobj::scalar_object Sobj;
+
+  int full_vecs   = full.size();
+  assert(full_vecs>=1);
+
+  GridBase * full_grid = full[0].Grid();
+  GridBase *split_grid = split.Grid();
+
+  int cb = split.Checkerboard();
+
+  assert(full_grid->_ndimension==split_grid->_ndimension);
+  for(int n=0;n<full_vecs;n++){
+    assert(full[n].Grid() == full_grid);
+  }
+  for(int d=0;d<full_grid->_ndimension;d++){
+    assert(full_grid->_gdimensions[d]==split_grid->_gdimensions[d]);
+    assert(full_grid->_fdimensions[d]==split_grid->_fdimensions[d]);
+  }
+
+  GridSplitMap &map = Grid_split_map(full_grid,split_grid);
+  assert(map.nvector == full_vecs);
+
+  uint64_t lsites = map.lsites;
+  std::vector<Sobj> sendbuf(lsites*full_vecs);
+  std::vector<Sobj> recvbuf(lsites*full_vecs);
+
+  const int Nsimd = Vobj::Nsimd();
+  {
+    autoView( split_v , split, CpuRead);
+    thread_for(oidx,split_grid->oSites(),{
+      ExtractPointerArray<Sobj> ptrs(Nsimd);
+      for(int lane=0;lane<Nsimd;lane++) ptrs[lane] = &sendbuf[map.split_off[oidx*Nsimd+lane]];
+      extract(split_v[oidx],ptrs,0);
+    });
+  }
+
+  full_grid->AllToAllv((void *)&sendbuf[0],map.rcounts,map.rdispls,
+		       (void *)&recvbuf[0],map.scounts,map.sdispls,sizeof(Sobj));
+
+  for(int v=0;v<full_vecs;v++){
+    full[v].Checkerboard() = cb;
+    autoView( full_v , full[v], CpuWrite);
+    Sobj *buf = &recvbuf[v*lsites];
+    thread_for(oidx,full_grid->oSites(),{
+      ExtractPointerArray<Sobj> ptrs(Nsimd);
+      for(int lane=0;lane<Nsimd;lane++) ptrs[lane] = &buf[map.full_lex[oidx*Nsimd+lane]];
+      merge(full_v[oidx],ptrs,0);
+    });
+  }
+}
+
 template<class Vobj>
 void Grid_split(Lattice<Vobj> &full,Lattice<Vobj>   & split)
 {
@@ -1302,7 +1551,7 @@ void Grid_split(Lattice<Vobj> &full,Lattice<Vobj>   & split)
 }
 
 template<class Vobj>
-void Grid_unsplit(std::vector<Lattice<Vobj> > & full,Lattice<Vobj>   & split)
+void Grid_unsplit_dimwise(std::vector<Lattice<Vobj> > & full,Lattice<Vobj>   & split)
 {
   typedef typename Vobj::scalar_object Sobj;
 
@@ -1320,15 +1569,13 @@ void Grid_unsplit(std::vector<Lattice<Vobj> > & full,Lattice<Vobj>   & split)
   ////////////////////////////////
   // Checkerboard management
   ////////////////////////////////
-  int cb = full[0].Checkerboard();
-  split.Checkerboard() = cb;
+  int cb = split.Checkerboard();
 
   //////////////////////////////
   // Checks
   //////////////////////////////
   assert(full_grid->_ndimension==split_grid->_ndimension);
   for(int n=0;n<full_vecs;n++){
-    assert(full[n].Checkerboard() == cb);
     for(int d=0;d<ndim;d++){
       assert(full[n].Grid()->_gdimensions[d]==split.Grid()->_gdimensions[d]);
       assert(full[n].Grid()->_fdimensions[d]==split.Grid()->_fdimensions[d]);
@@ -1419,6 +1666,7 @@ void Grid_unsplit(std::vector<Lattice<Vobj> > & full,Lattice<Vobj>   & split)
       scalardata[site] = alldata[v*lsites+site];
     });
     vectorizeFromLexOrdArray(scalardata,full[v]);    
+    full[v].Checkerboard() = cb;
   }
 }
 
@@ -1,4 +1,13 @@
 #include <Grid/GridCore.h>
 
 int                    Grid::BinaryIO::latticeWriteMaxRetry = -1;
+uint64_t               Grid::BinaryIO::latticeIOChunkBytes  = 256*1024*1024;
+int                    Grid::BinaryIO::ioAggregators        = 0;
+uint64_t               Grid::BinaryIO::ioStripeBytes        = 1024*1024;
+bool                   Grid::BinaryIO::latticeReadMapped    = false;
+int                    Grid::BinaryIO::latticeWriteVerify   = Grid::BinaryIO::VerifyFull;
+double                 Grid::BinaryIO::latticeWriteVerifyFraction   = 0.05;
+uint64_t               Grid::BinaryIO::latticeWriteVerifyChunkBytes = 1024*1024;
+uint64_t               Grid::BinaryIO::latticeCompressChunkBytes    = 4*1024*1024;
+int                    Grid::BinaryIO::latticeCompressLevel         = 1;
 Grid::BinaryIO::IoPerf Grid::BinaryIO::lastPerf;
@@ -39,7 +39,12 @@
 #endif
 
 #include <arpa/inet.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <algorithm>
+#include <cstring>
 
 NAMESPACE_BEGIN(Grid);
 
@@ -67,6 +72,91 @@ inline uint64_t Grid_ntohll(uint64_t A) {
 }
 #endif
 
+/////////////////////////////////////////////////////////////////////////////////
+// CRC-32 with the zlib polynomial, sixteen bytes a step through sixteen lookup
+// tables (slicing by 16); the value is zlib's crc32(0,p,len). On the few hundred
+// byte site objects of the SciDAC checksum it runs well ahead of zlib, whose
+// per call set up dominates there; kilobyte and larger objects go to zlib.
+/////////////////////////////////////////////////////////////////////////////////
+struct GridCrc32Table {
+  uint32_t t[16][256];
+  GridCrc32Table() {
+    for(uint32_t i=0;i<256;i++){
+      uint32_t c = i;
+      for(int k=0;k<8;k++) c = (c&1) ? (0xEDB88320U^(c>>1)) : (c>>1);
+      t[0][i] = c;
+    }
+    for(int i=0;i<256;i++){
+      for(int s=1;s<16;s++) t[s][i] = (t[s-1][i]>>8) ^ t[0][t[s-1][i]&0xFF];
+    }
+  }
+};
+
+inline uint32_t Grid_crc32(const unsigned char *p,uint64_t len)
+{
+  if ( len >= 1024 ) return crc32(0,p,len);
+  static const GridCrc32Table table;
+  const uint32_t (*t)[256] = table.t;
+  uint32_t crc = 0xFFFFFFFFU;
+  uint32_t w[4];
+  while ( len >= 16 ) {
+    memcpy(w,p,16);
+#if BYTE_ORDER == BIG_ENDIAN
+    for(int i=0;i<4;i++) w[i] = byte_reverse32(w[i]);
+#endif
+    w[0] ^= crc;
+    crc = t[15][w[0]&0xFF] ^ t[14][(w[0]>>8)&0xFF] ^ t[13][(w[0]>>16)&0xFF] ^ t[12][w[0]>>24]
+        ^ t[11][w[1]&0xFF] ^ t[10][(w[1]>>8)&0xFF] ^ t[ 9][(w[1]>>16)&0xFF] ^ t[ 8][w[1]>>24]
+        ^ t[ 7][w[2]&0xFF] ^ t[ 6][(w[2]>>8)&0xFF] ^ t[ 5][(w[2]>>16)&0xFF] ^ t[ 4][w[2]>>24]
+        ^ t[ 3][w[3]&0xFF] ^ t[ 2][(w[3]>>8)&0xFF] ^ t[ 1][(w[3]>>16)&0xFF] ^ t[ 0][w[3]>>24];
+    p+=16; len-=16;
+  }
+  while ( len-- ) crc = (crc>>8) ^ t[0][(crc^*p++)&0xFF];
+  return ~crc;
+}
+
+/////////////////////////////////////////////////////////////////////////////////
+// Simple classes for precision conversion
+/////////////////////////////////////////////////////////////////////////////////
+template <class fobj, class sobj>
+struct BinarySimpleUnmunger {
+  typedef typename getPrecision<fobj>::real_scalar_type fobj_stype;
+  typedef typename getPrecision<sobj>::real_scalar_type sobj_stype;
+  
+  void operator()(sobj &in, fobj &out) {
+    // take word by word and transform accoding to the status
+    fobj_stype *out_buffer = (fobj_stype *)&out;
+    sobj_stype *in_buffer = (sobj_stype *)&in;
+    size_t fobj_words = sizeof(out) / sizeof(fobj_stype);
+    size_t sobj_words = sizeof(in) / sizeof(sobj_stype);
+    assert(fobj_words == sobj_words);
+    
+    for (unsigned int word = 0; word < sobj_words; word++)
+      out_buffer[word] = in_buffer[word];  // type conversion on the fly
+    
+  }
+};
+
+template <class fobj, class sobj>
+struct BinarySimpleMunger {
+  typedef typename getPrecision<fobj>::real_scalar_type fobj_stype;
+  typedef typename getPrecision<sobj>::real_scalar_type sobj_stype;
+
+  void operator()(fobj &in, sobj &out) {
+    // take word by word and transform accoding to the status
+    fobj_stype *in_buffer = (fobj_stype *)&in;
+    sobj_stype *out_buffer = (sobj_stype *)&out;
+    size_t fobj_words = sizeof(in) / sizeof(fobj_stype);
+    size_t sobj_words = sizeof(out) / sizeof(sobj_stype);
+    assert(fobj_words == sobj_words);
+    
+    for (unsigned int word = 0; word < sobj_words; word++)
+      out_buffer[word] = in_buffer[word];  // type conversion on the fly
+    
+  }
+};
+
+
 // A little helper
 inline void removeWhitespace(std::string &key)
 {
@@ -87,6 +177,20 @@ class BinaryIO {
 
   static IoPerf lastPerf;
   static int latticeWriteMaxRetry;
+  static uint64_t latticeIOChunkBytes; // per rank buffer budget of the lattice read/write; 0 is unbounded
+  static int      ioAggregators;       // >0: lexicographic I/O through this many aggregator ranks, not MPI-IO
+  static uint64_t ioStripeBytes;       // aggregator file domains start on multiples of this
+  static bool     latticeReadMapped;   // readLatticeObject vectorises straight from an mmap of the file
+
+  // How writeLatticeObject checks the file when latticeWriteMaxRetry >= 0
+  enum { VerifyNone=0, VerifySampled=1, VerifyFull=2 };
+  static int      latticeWriteVerify;
+  static double   latticeWriteVerifyFraction; // of the chunks re-read by VerifySampled
+  static uint64_t latticeWriteVerifyChunkBytes;
+
+  // writeLatticeCompressed: file object bytes per chunk, and zlib level
+  static uint64_t latticeCompressChunkBytes;
+  static int      latticeCompressLevel;
 
   /////////////////////////////////////////////////////////////////////////////
   // more byte manipulation helpers
@@ -110,11 +214,7 @@ class BinaryIO {
   {
     const uint64_t size32 = sizeof(fobj) / sizeof(uint32_t);
 
-    uint64_t lsites = grid->lSites();
-    if (fbuf.size() == 1)
-    {
-      lsites = 1;
-    }
+    uint64_t lsites = fbuf.size();
 
     thread_region
     {
@@ -136,14 +236,13 @@ class BinaryIO {
     }
   }
 
-  template<class fobj> static inline void ScidacChecksum(GridBase *grid,std::vector<fobj> &fbuf,uint32_t &scidac_csuma,uint32_t &scidac_csumb)
+  // fbuf[0] is local lexicographic site site0; the buffer may hold a slab of the local volume
+  template<class fobj> static inline void ScidacChecksum(GridBase *grid,std::vector<fobj> &fbuf,uint32_t &scidac_csuma,uint32_t &scidac_csumb,
+							 uint64_t site0=0)
   {
     int nd = grid->_ndimension;
 
-    uint64_t lsites              =grid->lSites();
-    if (fbuf.size()==1) {
-      lsites=1;
-    }
+    uint64_t lsites              =fbuf.size();
     Coordinate local_vol   =grid->LocalDimensions();
     Coordinate local_start =grid->LocalStarts();
     Coordinate global_vol  =grid->FullDimensions();
@@ -167,7 +266,7 @@ class BinaryIO {
 	
 	int global_site;
 
-	Lexicographic::CoorFromIndex(coor,local_site,local_vol);
+	Lexicographic::CoorFromIndex(coor,site0+local_site,local_vol);
 
 	for(int d=0;d<nd;d++) {
 	  coor[d] = coor[d]+local_start[d];
@@ -178,7 +277,7 @@ class BinaryIO {
 	uint32_t gsite29   = global_site%29;
 	uint32_t gsite31   = global_site%31;
 	
-	site_crc = crc32(0,(unsigned char *)site_buf,sizeof(fobj));
+	site_crc = Grid_crc32((unsigned char *)site_buf,sizeof(fobj));
 	//	std::cout << "Site "<<local_site << " crc "<<std::hex<<site_crc<<std::dec<<std::endl;
 	//	std::cout << "Site "<<local_site << std::hex<<site_buf[0] <<site_buf[1]<<std::dec <<std::endl;
 	scidac_csuma_thr ^= site_crc<<gsite29 | site_crc>>(32-gsite29);
@@ -193,64 +292,344 @@ class BinaryIO {
     }
   }
 
+  /////////////////////////////////////////////////////////////////////////////
+  // Byte order. Between file and host order every word is byte reversed, or
+  // nothing is done, depending on the host; the reversal loops vectorise to
+  // byte shuffles.
+  /////////////////////////////////////////////////////////////////////////////
+  static inline void byteSwapSite(void *site,uint64_t bytes,int word)
+  {
+    if ( word==sizeof(uint32_t) ) {
+      uint32_t *f = (uint32_t *)site;
+      for(uint64_t i=0;i<bytes/sizeof(uint32_t);i++) f[i] = __builtin_bswap32(f[i]);
+    }
+    if ( word==sizeof(uint64_t) ) {
+      uint64_t *f = (uint64_t *)site;
+      for(uint64_t i=0;i<bytes/sizeof(uint64_t);i++) f[i] = __builtin_bswap64(f[i]);
+    }
+  }
+  static inline void byteSwap_v(void *file_object,uint64_t bytes,int word)
+  {
+    const uint64_t block = 4096;
+    uint64_t nblock = (bytes+block-1)/block;
+    thread_for( b, nblock, {
+      uint64_t lo = b*block;
+      byteSwapSite((char *)file_object+lo,std::min(block,bytes-lo),word);
+    });
+  }
+  // Word size to reverse between a file format and this host; 0 for none
+  static inline int formatSwapWord(const std::string &format)
+  {
+    int ieee32big = (format == std::string("IEEE32BIG"));
+    int ieee32    = (format == std::string("IEEE32"));
+    int ieee64big = (format == std::string("IEEE64BIG"));
+    int ieee64    = (format == std::string("IEEE64") || format == std::string("IEEE64LITTLE"));
+    assert((ieee64+ieee32+ieee64big+ieee32big)==1);
+#if BYTE_ORDER == BIG_ENDIAN
+    return ieee32 ? sizeof(uint32_t) : ( ieee64 ? sizeof(uint64_t) : 0 );
+#else
+    return ieee32big ? sizeof(uint32_t) : ( ieee64big ? sizeof(uint64_t) : 0 );
+#endif
+  }
+
   // Network is big endian
   static inline void htobe32_v(void *file_object,uint32_t bytes){ be32toh_v(file_object,bytes);} 
   static inline void htobe64_v(void *file_object,uint32_t bytes){ be64toh_v(file_object,bytes);} 
   static inline void htole32_v(void *file_object,uint32_t bytes){ le32toh_v(file_object,bytes);} 
   static inline void htole64_v(void *file_object,uint32_t bytes){ le64toh_v(file_object,bytes);} 
 
-  static inline void be32toh_v(void *file_object,uint64_t bytes)
+#if BYTE_ORDER == BIG_ENDIAN
+  static inline void be32toh_v(void *file_object,uint64_t bytes) { }
+  static inline void be64toh_v(void *file_object,uint64_t bytes) { }
+  static inline void le32toh_v(void *file_object,uint64_t bytes) { byteSwap_v(file_object,bytes,sizeof(uint32_t)); }
+  static inline void le64toh_v(void *file_object,uint64_t bytes) { byteSwap_v(file_object,bytes,sizeof(uint64_t)); }
+#else
+  static inline void be32toh_v(void *file_object,uint64_t bytes) { byteSwap_v(file_object,bytes,sizeof(uint32_t)); }
+  static inline void be64toh_v(void *file_object,uint64_t bytes) { byteSwap_v(file_object,bytes,sizeof(uint64_t)); }
+  static inline void le32toh_v(void *file_object,uint64_t bytes) { }
+  static inline void le64toh_v(void *file_object,uint64_t bytes) { }
+#endif
+
+  /////////////////////////////////////////////////////////////////////////////
+  // Byte order conversion fused with both checksums in one pass, each site
+  // converted and checksummed while it is in cache. The SciDAC crc is of the file
+  // order bytes, the NERSC sum of the host order words; to_host says fbuf holds
+  // file order (read) rather than host order (write) data. Sites go in lines of
+  // the innermost dimension so the global index is found once a line.
+  //////////////////////////////////////////////////////////////////////////////////////
+  template<class fobj>
+  static inline void ConvertChecksum(GridBase *grid,std::vector<fobj> &fbuf,const std::string &format,bool to_host,
+				     uint32_t &nersc_csum,uint32_t &scidac_csuma,uint32_t &scidac_csumb,
+				     uint64_t site0=0)
   {
-    uint32_t * f = (uint32_t *)file_object;
-    uint64_t count = bytes/sizeof(uint32_t);
-    thread_for( i, count, {  
-      f[i] = ntohl(f[i]);
-    });
+    ConvertChecksum(grid,fbuf.data(),fbuf.size(),format,to_host,nersc_csum,scidac_csuma,scidac_csumb,site0);
   }
-  // LE must Swap and switch to host
-  static inline void le32toh_v(void *file_object,uint64_t bytes)
+  template<class fobj>
+  static inline void ConvertChecksum(GridBase *grid,fobj *fbuf,uint64_t lsites,const std::string &format,bool to_host,
+				     uint32_t &nersc_csum,uint32_t &scidac_csuma,uint32_t &scidac_csumb,
+				     uint64_t site0=0)
   {
-    uint32_t *fp = (uint32_t *)file_object;
+    const uint64_t size32 = sizeof(fobj) / sizeof(uint32_t);
+    int word = formatSwapWord(format);
+    int nd   = grid->_ndimension;
 
-    uint64_t count = bytes/sizeof(uint32_t);
-    thread_for(i,count,{
-      uint32_t f;
-      f = fp[i];
-      // got network order and the network to host
-      f = ((f&0xFF)<<24) | ((f&0xFF00)<<8) | ((f&0xFF0000)>>8) | ((f&0xFF000000UL)>>24) ; 
-      fp[i] = ntohl(f);
-    });
+    Coordinate local_vol   =grid->LocalDimensions();
+    Coordinate local_start =grid->LocalStarts();
+    Coordinate global_vol  =grid->FullDimensions();
+
+    uint64_t run = local_vol[0];
+    if ( (lsites%run) || (site0%run) ) run = 1;
+    uint64_t nrun = lsites/run;
+
+    thread_region
+    {
+      Coordinate coor(nd);
+      uint32_t nersc_csum_thr=0;
+      uint32_t scidac_csuma_thr=0;
+      uint32_t scidac_csumb_thr=0;
+
+      thread_for_in_region( r, nrun, {
+	int global_site;
+	Lexicographic::CoorFromIndex(coor,site0+r*run,local_vol);
+	for(int d=0;d<nd;d++) coor[d] += local_start[d];
+	Lexicographic::IndexFromCoor(coor,global_site,global_vol);
+	uint32_t gsite29 = global_site%29;
+	uint32_t gsite31 = global_site%31;
+
+	for(uint64_t x=0;x<run;x++){
+	  uint32_t *site_buf = (uint32_t *)&fbuf[r*run+x];
+	  uint32_t  site_crc;
+	  if ( to_host ) {
+	    site_crc = Grid_crc32((unsigned char *)site_buf,sizeof(fobj));
+	    byteSwapSite(site_buf,sizeof(fobj),word);
+	  }
+	  for(uint64_t j=0;j<size32;j++) nersc_csum_thr += site_buf[j];
+	  if ( !to_host ) {
+	    byteSwapSite(site_buf,sizeof(fobj),word);
+	    site_crc = Grid_crc32((unsigned char *)site_buf,sizeof(fobj));
+	  }
+	  scidac_csuma_thr ^= site_crc<<gsite29 | site_crc>>((32-gsite29)&31);
+	  scidac_csumb_thr ^= site_crc<<gsite31 | site_crc>>((32-gsite31)&31);
+	  gsite29 = (gsite29==28) ? 0 : gsite29+1;
+	  gsite31 = (gsite31==30) ? 0 : gsite31+1;
+	}
+      });
+
+      thread_critical
+      {
+	nersc_csum  += nersc_csum_thr;
+	scidac_csuma^= scidac_csuma_thr;
+	scidac_csumb^= scidac_csumb_thr;
+      }
+    }
   }
 
-  // BE is same as network
-  static inline void be64toh_v(void *file_object,uint64_t bytes)
+  /////////////////////////////////////////////////////////////////////////////
+  // The lexicographic sub-block lLattice at gStart of the global array gLattice,
+  // stored from offset with bytes per site, in runs contiguous in both the local
+  // and the file order. Returns the run length in sites; runs holds the local
+  // site index and the file position of each run.
+  //////////////////////////////////////////////////////////////////////////////////////
+  static inline uint64_t fileRuns(const Coordinate &gLattice,const Coordinate &lLattice,const Coordinate &gStart,
+				  uint64_t offset,uint64_t bytes,std::vector<std::pair<uint64_t,uint64_t> > &runs)
   {
-    uint64_t * f = (uint64_t *)file_object;
-    uint64_t count = bytes/sizeof(uint64_t);
-    thread_for( i, count, {
-      f[i] = Grid_ntohll(f[i]);
-    });
+    int nd = gLattice.size();
+    uint64_t lsites = 1;
+    for(int d=0;d<nd;d++) lsites *= lLattice[d];
+    uint64_t run = 1;
+    for(int d=0;d<nd;d++){
+      run *= lLattice[d];
+      if ( lLattice[d]!=gLattice[d] ) break;
+    }
+    runs.resize(0);
+    Coordinate lcoor(nd);
+    for(uint64_t r=0;r<lsites;r+=run){
+      Lexicographic::CoorFromIndex(lcoor,r,lLattice);
+      uint64_t gidx   = 0;
+      uint64_t stride = 1;
+      for(int d=0;d<nd;d++){
+	gidx   += stride*(lcoor[d]+gStart[d]);
+	stride *= gLattice[d];
+      }
+      runs.push_back(std::make_pair(r,offset+gidx*bytes));
+    }
+    return run;
   }
-  
-  // LE must swap and switch;
-  static inline void le64toh_v(void *file_object,uint64_t bytes)
-  {
-    uint64_t *fp = (uint64_t *)file_object;
-    uint64_t count = bytes/sizeof(uint64_t);
-    thread_for( i, count, {
-      uint64_t f,g;
-      f = fp[i];
-      // got network order and the network to host
-      g = ((f&0xFF)<<24) | ((f&0xFF00)<<8) | ((f&0xFF0000)>>8) | ((f&0xFF000000UL)>>24) ; 
-      g = g << 32;
-      f = f >> 32;
-      g|= ((f&0xFF)<<24) | ((f&0xFF00)<<8) | ((f&0xFF0000)>>8) | ((f&0xFF000000UL)>>24) ; 
-      fp[i] = Grid_ntohll(g);
-    });
+
+#ifdef USE_MPI_IO
+  /////////////////////////////////////////////////////////////////////////////
+  // Two phase lexicographic I/O through aggregator ranks.
+  //
+  // The file range of the global array is cut into ioAggregators contiguous
+  // domains whose boundaries fall on multiples of ioStripeBytes; aggregator a is
+  // rank a*nrank/ioAggregators, so with ranks numbered node by node one per node
+  // is picked when ioAggregators is the node count. Each rank cuts its runs
+  // (local sites contiguous in the file) at the domain boundaries and ships the
+  // pieces to their owners, which issue one write (or read) per contiguous
+  // extent they hold: the whole domain when the full volume goes at once.
+  // The aggregator holds a single file ordered copy of what it gathers.
+  // Only collective MPI and std::fstream are used; MPI-IO is bypassed.
+  //////////////////////////////////////////////////////////////////////////////////////
+  static inline void IOaggregated(GridBase *grid,char *data,uint64_t bytes,
+				  const Coordinate &gLattice,const Coordinate &lLattice,const Coordinate &gStart,
+				  std::string file,uint64_t offset,int control)
+  {
+    MPI_Comm comm = grid->communicator;
+    int nrank  = grid->ProcessorCount();
+    int myrank = grid->ThisRank();
+    int nd     = gLattice.size();
+    int nagg   = std::min(ioAggregators,nrank);
+    uint64_t stripe = std::max(ioStripeBytes,(uint64_t)1);
+
+    uint64_t gsites=1, lsites=1;
+    for(int d=0;d<nd;d++){ gsites*=gLattice[d]; lsites*=lLattice[d]; }
+
+    // Domain a is [start[a],start[a+1]) of the file
+    uint64_t lo = offset;
+    uint64_t hi = offset+gsites*bytes;
+    uint64_t first   = lo/stripe;
+    uint64_t nstripe = (hi-1)/stripe - first + 1;
+    std::vector<uint64_t> start(nagg+1);
+    for(int a=0;a<nagg;a++) start[a] = std::max(lo,(first + (a*nstripe)/nagg)*stripe);
+    start[nagg] = hi;
+
+    //////////////////////////////////////////////
+    // Pieces of the local runs, by destination
+    //////////////////////////////////////////////
+    const uint64_t piece_max = 1ULL<<30; // block lengths of the exchange types are int
+    std::vector<std::pair<uint64_t,uint64_t> > runs;
+    uint64_t run = fileRuns(gLattice,lLattice,gStart,offset,bytes,runs);
+    std::vector<std::vector<uint64_t> > meta (nrank); // file position and length
+    std::vector<std::vector<uint64_t> > where(nrank); // position in data
+    for(auto &rp : runs){
+      uint64_t pos = rp.second;
+      uint64_t len = run*bytes;
+      uint64_t loc = rp.first*bytes;
+      while ( len ) {
+	int a = std::upper_bound(start.begin(),start.end(),pos) - start.begin() - 1;
+	uint64_t n = std::min(std::min(len,start[a+1]-pos),piece_max);
+	int dest = (a*nrank)/nagg;
+	meta[dest].push_back(pos);
+	meta[dest].push_back(n);
+	where[dest].push_back(loc);
+	pos+=n; loc+=n; len-=n;
+      }
+    }
+
+    //////////////////////////////////////////////
+    // Aggregators learn what they hold
+    //////////////////////////////////////////////
+    std::vector<int> scount(nrank), sdispl(nrank), rcount(nrank), rdispl(nrank);
+    std::vector<uint64_t> smeta;
+    for(int p=0;p<nrank;p++){
+      scount[p] = meta[p].size();
+      sdispl[p] = smeta.size();
+      smeta.insert(smeta.end(),meta[p].begin(),meta[p].end());
+    }
+    MPI_Alltoall(&scount[0],1,MPI_INT,&rcount[0],1,MPI_INT,comm);
+    int nrmeta = 0;
+    for(int p=0;p<nrank;p++){ rdispl[p] = nrmeta; nrmeta += rcount[p]; }
+    std::vector<uint64_t> rmeta(nrmeta);
+    MPI_Alltoallv(smeta.data(),&scount[0],&sdispl[0],MPI_UINT64_T,
+		  rmeta.data(),&rcount[0],&rdispl[0],MPI_UINT64_T,comm);
+
+    // Pieces in file order, packed back to back in the aggregator's buffer
+    int npiece = nrmeta/2;
+    std::vector<int> order(npiece);
+    for(int i=0;i<npiece;i++) order[i] = i;
+    std::sort(order.begin(),order.end(),[&](int i,int j){ return rmeta[2*i]<rmeta[2*j]; });
+    std::vector<MPI_Aint> eloc(npiece);
+    uint64_t etotal=0;
+    for(int i=0;i<npiece;i++){
+      eloc[order[i]] = etotal;
+      etotal += rmeta[2*order[i]+1];
+    }
+
+    //////////////////////////////////////////////
+    // The exchange moves pieces straight between data and the aggregator's
+    // file ordered buffer through indexed types, so neither side packs a copy
+    // and no byte count or displacement is held in an int.
+    //////////////////////////////////////////////
+    std::vector<int> scounts(nrank,0), rcounts(nrank,0), displs(nrank,0);
+    std::vector<MPI_Datatype> stypes(nrank,MPI_BYTE), rtypes(nrank,MPI_BYTE);
+    for(int p=0;p<nrank;p++){
+      int ns = where[p].size();
+      if ( ns ) {
+	std::vector<int>      len(ns);
+	std::vector<MPI_Aint> disp(ns);
+	for(int i=0;i<ns;i++){ len[i] = meta[p][2*i+1]; disp[i] = where[p][i]; }
+	MPI_Type_create_hindexed(ns,&len[0],&disp[0],MPI_BYTE,&stypes[p]);
+	MPI_Type_commit(&stypes[p]);
+	scounts[p] = 1;
+      }
+      int nr = rcount[p]/2;
+      if ( nr ) {
+	int i0 = rdispl[p]/2;
+	std::vector<int> len(nr);
+	for(int i=0;i<nr;i++) len[i] = rmeta[2*(i0+i)+1];
+	MPI_Type_create_hindexed(nr,&len[0],&eloc[i0],MPI_BYTE,&rtypes[p]);
+	MPI_Type_commit(&rtypes[p]);
+	rcounts[p] = 1;
+      }
+    }
+
+    std::vector<char> extent(etotal);
+    std::fstream fio;
+    fio.exceptions ( std::fstream::failbit | std::fstream::badbit );
+
+    // One file access per run of pieces contiguous in the file
+    auto extents = [&](std::function<void(uint64_t pos,char *buf,uint64_t len)> access) {
+      uint64_t e=0;
+      for(int i=0;i<npiece;){
+	uint64_t pos = rmeta[2*order[i]];
+	uint64_t len = 0;
+	int j=i;
+	while ( j<npiece && rmeta[2*order[j]]==pos+len ) len += rmeta[2*order[j++]+1];
+	access(pos,&extent[e],len);
+	e+=len; i=j;
+      }
+    };
+
+    try {
+      if ( control & BINARYIO_WRITE ) {
+	MPI_Alltoallw(data,&scounts[0],&displs[0],&stypes[0],
+		      extent.data(),&rcounts[0],&displs[0],&rtypes[0],comm);
+	// Create without truncating, as MPI_MODE_CREATE
+	if ( grid->IsBoss() ) std::ofstream(file,std::ios::binary|std::ios::app);
+	grid->Barrier();
+	if ( npiece ) {
+	  fio.open(file,std::ios::binary|std::ios::out|std::ios::in);
+	  extents([&](uint64_t pos,char *buf,uint64_t len){ fio.seekp(pos); fio.write(buf,len); });
+	  fio.close();
+	}
+      } else {
+	if ( npiece ) {
+	  fio.open(file,std::ios::binary|std::ios::in);
+	  extents([&](uint64_t pos,char *buf,uint64_t len){ fio.seekg(pos); fio.read(buf,len); });
+	  fio.close();
+	}
+	MPI_Alltoallw(extent.data(),&rcounts[0],&displs[0],&rtypes[0],
+		      data,&scounts[0],&displs[0],&stypes[0],comm);
+      }
+      for(int p=0;p<nrank;p++){
+	if ( scounts[p] ) MPI_Type_free(&stypes[p]);
+	if ( rcounts[p] ) MPI_Type_free(&rtypes[p]);
+      }
+    } catch (const std::fstream::failure& exc) {
+      std::cout << GridLogError << "Error in aggregated I/O on file " << file << " rank " << myrank << std::endl;
+      std::cout << GridLogError << "Exception description: " << exc.what() << std::endl;
+      MPI_Abort(MPI_COMM_WORLD,1);
+    }
   }
+#endif
+
   /////////////////////////////////////////////////////////////////////////////
   // Real action:
   // Read or Write distributed lexico array of ANY object to a specific location in file 
+  //
+  // By default iodata is the whole local volume. With slab_slices>=0 it is only the
+  // local slices [slab_begin,slab_begin+slab_slices) of the outermost dimension,
+  // which are contiguous in both the local and the file lexicographic order.
   //////////////////////////////////////////////////////////////////////////////////////
 
   static const int BINARYIO_MASTER_APPEND = 0x10;
@@ -268,7 +647,9 @@ class BinaryIO {
 			      const std::string &format, int control,
 			      uint32_t &nersc_csum,
 			      uint32_t &scidac_csuma,
-			      uint32_t &scidac_csumb)
+			      uint32_t &scidac_csumb,
+			      int slab_begin=0,
+			      int slab_slices=-1)
   {
     grid->Barrier();
     GridStopWatch timer; 
@@ -292,16 +673,26 @@ class BinaryIO {
 
     // Flatten the file
     uint64_t lsites = grid->lSites();
-    if ( control & BINARYIO_MASTER_APPEND )  {
-      assert(iodata.size()==1);
-    } else {
-      assert(lsites==iodata.size());
-    }
     for(int d=0;d<ndim;d++){
       gStart[d] = lLattice[d]*pcoor[d];
       lStart[d] = 0;
     }
 
+    // Restrict to the slab of outermost slices
+    int tdim = ndim-1;
+    if ( slab_slices < 0 ) slab_slices = lLattice[tdim];
+    assert(slab_begin>=0 && slab_begin+slab_slices<=lLattice[tdim]);
+    uint64_t slice   = lsites/lLattice[tdim];
+    uint64_t site0   = slice*slab_begin;
+    gStart[tdim]    += slab_begin;
+    lLattice[tdim]   = slab_slices;
+
+    if ( control & BINARYIO_MASTER_APPEND )  {
+      assert(iodata.size()==1);
+    } else {
+      assert(slice*slab_slices==iodata.size());
+    }
+
 #ifdef USE_MPI_IO
     std::vector<int> distribs(ndim,MPI_DISTRIBUTE_BLOCK);
     std::vector<int> dargs   (ndim,MPI_DISTRIBUTE_DFLT_DARG);
@@ -360,11 +751,17 @@ class BinaryIO {
 
       if ( (control & BINARYIO_LEXICOGRAPHIC) && (nrank > 1) ) {
 #ifdef USE_MPI_IO
+	if ( ioAggregators > 0 ) {
+	  std::cout<< GridLogMessage<<"IOobject: aggregated read I/O "<< file<<" through "
+		   << std::min(ioAggregators,nrank)<<" ranks"<< std::endl;
+	  IOaggregated(grid,(char *)&iodata[0],sizeof(fobj),gLattice,lLattice,gStart,file,offset,BINARYIO_READ);
+	} else {
 	std::cout<< GridLogMessage<<"IOobject: MPI read I/O "<< file<< std::endl;
 	ierr=MPI_File_open(grid->communicator,(char *) file.c_str(), MPI_MODE_RDONLY, MPI_INFO_NULL, &fh);    assert(ierr==0);
 	ierr=MPI_File_set_view(fh, disp, mpiObject, fileArray, "native", MPI_INFO_NULL);    assert(ierr==0);
 	ierr=MPI_File_read_all(fh, &iodata[0], 1, localArray, &status);    assert(ierr==0);
 	MPI_File_close(&fh);
+	}
 	MPI_Type_free(&fileArray);
 	MPI_Type_free(&localArray);
 #else 
@@ -381,7 +778,7 @@ class BinaryIO {
         }
         else
         {
-          fin.seekg(offset + myrank * lsites * sizeof(fobj));
+          fin.seekg(offset + (myrank * lsites + site0) * sizeof(fobj));
         }
         fin.read((char *)&iodata[0], iodata.size() * sizeof(fobj));
         assert(fin.fail() == 0);
@@ -392,24 +789,14 @@ class BinaryIO {
       grid->Barrier();
 
       bstimer.Start();
-      ScidacChecksum(grid,iodata,scidac_csuma,scidac_csumb);
-      if (ieee32big) be32toh_v((void *)&iodata[0], sizeof(fobj)*iodata.size());
-      if (ieee32)    le32toh_v((void *)&iodata[0], sizeof(fobj)*iodata.size());
-      if (ieee64big) be64toh_v((void *)&iodata[0], sizeof(fobj)*iodata.size());
-      if (ieee64)    le64toh_v((void *)&iodata[0], sizeof(fobj)*iodata.size());
-      NerscChecksum(grid,iodata,nersc_csum);
+      ConvertChecksum(grid,iodata,format,true,nersc_csum,scidac_csuma,scidac_csumb,site0);
       bstimer.Stop();
     }
     
     if ( control & BINARYIO_WRITE ) { 
 
       bstimer.Start();
-      NerscChecksum(grid,iodata,nersc_csum);
-      if (ieee32big) htobe32_v((void *)&iodata[0], sizeof(fobj)*iodata.size());
-      if (ieee32)    htole32_v((void *)&iodata[0], sizeof(fobj)*iodata.size());
-      if (ieee64big) htobe64_v((void *)&iodata[0], sizeof(fobj)*iodata.size());
-      if (ieee64)    htole64_v((void *)&iodata[0], sizeof(fobj)*iodata.size());
-      ScidacChecksum(grid,iodata,scidac_csuma,scidac_csumb);
+      ConvertChecksum(grid,iodata,format,false,nersc_csum,scidac_csuma,scidac_csumb,site0);
       bstimer.Stop();
 
       grid->Barrier();
@@ -417,6 +804,14 @@ class BinaryIO {
       timer.Start();
       if ( (control & BINARYIO_LEXICOGRAPHIC) && (nrank > 1) ) {
 #ifdef USE_MPI_IO
+	if ( ioAggregators > 0 ) {
+	  std::cout << GridLogMessage <<"IOobject: aggregated write I/O " << file<<" through "
+		    << std::min(ioAggregators,nrank)<<" ranks"<< std::endl;
+	  IOaggregated(grid,(char *)&iodata[0],sizeof(fobj),gLattice,lLattice,gStart,file,offset,BINARYIO_WRITE);
+	  uint64_t gsites=1;
+	  for(int d=0;d<ndim;d++) gsites*=gLattice[d];
+	  offset = offset+gsites*sizeof(fobj);
+	} else {
         std::cout << GridLogMessage <<"IOobject: MPI write I/O " << file << std::endl;
         ierr = MPI_File_open(grid->communicator, (char *)file.c_str(), MPI_MODE_RDWR | MPI_MODE_CREATE, MPI_INFO_NULL, &fh);
 	//        std::cout << GridLogMessage << "Checking for errors" << std::endl;
@@ -448,6 +843,7 @@ class BinaryIO {
 
 
         MPI_File_close(&fh);
+	}
         MPI_Type_free(&fileArray);
         MPI_Type_free(&localArray);
 #else 
@@ -461,7 +857,7 @@ class BinaryIO {
 	std::ofstream fout; 
 	fout.exceptions ( std::fstream::failbit | std::fstream::badbit );
 	try {
-	  if (offset) { // Must already exist and contain data
+	  if (offset || site0) { // Must already exist and contain data
 	    fout.open(file,std::ios::binary|std::ios::out|std::ios::in);
 	  } else {     // Allow create
 	    fout.open(file,std::ios::binary|std::ios::out);
@@ -485,7 +881,7 @@ class BinaryIO {
 	  }
 	} else {
 	  try { 
-	    fout.seekp(offset+myrank*lsites*sizeof(fobj));
+	    fout.seekp(offset+(myrank*lsites+site0)*sizeof(fobj));
 	  } catch (const std::fstream::failure& exc) {
 	    std::cout << "Exception in seeking file " << file <<" offset "<< offset << std::endl;
 	  }
@@ -534,6 +930,197 @@ class BinaryIO {
     }
   }
 
+  /////////////////////////////////////////////////////////////////////////////
+  // Streamed lattice I/O. The local volume is moved in slabs of whole outermost
+  // slices, as many as fit in latticeIOChunkBytes of scalar plus file order buffer
+  // (at least one), so the I/O memory overhead does not grow with the field.
+  // A field that fits goes in one slab exactly as before.
+  //////////////////////////////////////////////////////////////////////////////////////
+  template<class sobj,class fobj>
+  static inline int SlabSlices(GridBase *grid)
+  {
+    int      Lt    = grid->LocalDimensions()[grid->Nd()-1];
+    uint64_t bytes = grid->lSites()/Lt*(sizeof(sobj)+sizeof(fobj));
+    if ( latticeIOChunkBytes==0 ) return Lt;
+    return (int) std::max((uint64_t)1,std::min((uint64_t)Lt,latticeIOChunkBytes/bytes));
+  }
+
+  template<class vobj,class sobj>
+  static inline void unvectorizeSlab(std::vector<sobj> &out,const Lattice<vobj> &in,int slab_begin,int slab_slices)
+  {
+    GridBase *grid = in.Grid();
+    Coordinate ldims = grid->LocalDimensions();
+    int tdim = grid->Nd()-1;
+    if ( slab_slices==ldims[tdim] ) {
+      unvectorizeToLexOrdArray(out,in);
+      return;
+    }
+    uint64_t site0 = grid->lSites()/ldims[tdim]*slab_begin;
+    autoView(in_v,in,CpuRead);
+    thread_for(x,out.size(),{
+      Coordinate lcoor;
+      Lexicographic::CoorFromIndex(lcoor,site0+x,ldims);
+      peekLocalSite(out[x],in_v,lcoor);
+    });
+  }
+
+  template<class vobj,class sobj>
+  static inline void vectorizeSlab(std::vector<sobj> &in,Lattice<vobj> &out,int slab_begin,int slab_slices)
+  {
+    GridBase *grid = out.Grid();
+    Coordinate ldims = grid->LocalDimensions();
+    int tdim = grid->Nd()-1;
+    if ( slab_slices==ldims[tdim] ) {
+      vectorizeFromLexOrdArray(in,out);
+      return;
+    }
+    uint64_t site0 = grid->lSites()/ldims[tdim]*slab_begin;
+    autoView(out_v,out,CpuWrite);
+    thread_for(x,in.size(),{
+      Coordinate lcoor;
+      Lexicographic::CoorFromIndex(lcoor,site0+x,ldims);
+      pokeLocalSite(in[x],out_v,lcoor);
+    });
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  // Write verification by chunk digests. While a lattice is written, the file
+  // order bytes of each rank are cut into chunks (file contiguous, at most
+  // latticeWriteVerifyChunkBytes) and their crc32 kept; verifyChunks then re-reads the
+  // chunks, or a seeded random sample of them, straight from the file and
+  // compares. No second field sized buffer, and the sampled mode reads a fraction
+  // of the volume instead of all of it.
+  //////////////////////////////////////////////////////////////////////////////////////
+  struct ChunkDigest {
+    uint64_t pos, len;
+    uint32_t crc;
+  };
+  // Digests of a slab of outermost local slices, in file order in iodata
+  template<class fobj>
+  static inline void chunkDigests(GridBase *grid,std::vector<fobj> &iodata,uint64_t offset,
+				  int slab_begin,int slab_slices,std::vector<ChunkDigest> &digests)
+  {
+    int ndim = grid->Nd();
+    int tdim = ndim-1;
+    Coordinate gLattice = grid->GlobalDimensions();
+    Coordinate lLattice = grid->LocalDimensions();
+    Coordinate pcoor    = grid->ThisProcessorCoor();
+    Coordinate gStart(ndim);
+    for(int d=0;d<ndim;d++) gStart[d] = lLattice[d]*pcoor[d];
+    gStart[tdim]  += slab_begin;
+    lLattice[tdim] = slab_slices;
+
+    std::vector<std::pair<uint64_t,uint64_t> > runs;
+    uint64_t run = fileRuns(gLattice,lLattice,gStart,offset,sizeof(fobj),runs);
+    std::vector<uint64_t> data;
+    uint64_t first = digests.size();
+    for(auto &rp : runs){
+      for(uint64_t b=0;b<run*sizeof(fobj);b+=latticeWriteVerifyChunkBytes){
+	ChunkDigest c;
+	c.pos = rp.second+b;
+	c.len = std::min(latticeWriteVerifyChunkBytes,run*sizeof(fobj)-b);
+	digests.push_back(c);
+	data.push_back(rp.first*sizeof(fobj)+b);
+      }
+    }
+    unsigned char *base = (unsigned char *)&iodata[0];
+    thread_for(c,data.size(),{
+      digests[first+c].crc = crc32(0,base+data[c],digests[first+c].len);
+    });
+  }
+
+  // Collective; true when every re-read chunk matches on every rank
+  static inline bool verifyChunks(GridBase *grid,const std::string &file,std::vector<ChunkDigest> &digests,int attempt)
+  {
+    GridStopWatch timer;
+    timer.Start();
+
+    std::vector<int> check;
+    if ( latticeWriteVerify==VerifySampled ) {
+      std::mt19937 rng(0x9e3779b9U ^ (grid->ThisRank()*7919U + attempt));
+      std::uniform_real_distribution<double> uniform(0.0,1.0);
+      for(int c=0;c<digests.size();c++) if ( uniform(rng) < latticeWriteVerifyFraction ) check.push_back(c);
+      if ( check.empty() && digests.size() ) check.push_back(rng()%digests.size());
+    } else {
+      for(int c=0;c<digests.size();c++) check.push_back(c);
+    }
+
+    uint64_t failed = 0;
+    uint64_t bytes  = 0;
+    uint64_t total  = 0;
+    for(auto &d : digests) total += d.len;
+    std::vector<unsigned char> buf(latticeWriteVerifyChunkBytes);
+    std::ifstream fin(file,std::ios::binary);
+    for(auto c : check){
+      ChunkDigest &d = digests[c];
+      fin.seekg(d.pos);
+      fin.read((char *)&buf[0],d.len);
+      if ( fin.fail() || crc32(0,&buf[0],d.len)!=d.crc ) {
+	failed++;
+	fin.clear();
+      }
+      bytes += d.len;
+    }
+    grid->GlobalSum(failed);
+    grid->GlobalSum(bytes);
+    grid->GlobalSum(total);
+    timer.Stop();
+
+    std::cout << GridLogMessage << "writeLatticeObject: verify "
+	      << ((latticeWriteVerify==VerifySampled) ? "sampled " : "full ")
+	      << bytes << " of " << total << " bytes in " << timer.Elapsed()
+	      << ", " << failed << " bad chunks" << std::endl;
+    return failed==0;
+  }
+
+  // IOobject slab by slab. slab_op(slab_begin,slab_slices) fills iodata before each
+  // slab is written, or consumes it after each slab is read. Digests of the written
+  // chunks are appended to digests when given.
+  template<class word,class fobj,class SlabOp>
+  static inline void IOobjectSlabs(word w,
+				   GridBase *grid,
+				   std::vector<fobj> &iodata,
+				   int nslice,
+				   std::string file,
+				   uint64_t offset,
+				   const std::string &format, int control,
+				   uint32_t &nersc_csum,
+				   uint32_t &scidac_csuma,
+				   uint32_t &scidac_csumb,
+				   SlabOp slab_op,
+				   std::vector<ChunkDigest> *digests=nullptr)
+  {
+    int      Lt    = grid->LocalDimensions()[grid->Nd()-1];
+    uint64_t slice = grid->lSites()/Lt;
+    IoPerf   perf;
+
+    nersc_csum=0;
+    scidac_csuma=0;
+    scidac_csumb=0;
+
+    iodata.reserve(slice*nslice);
+    for(int t0=0;t0<Lt;t0+=nslice){
+      int nt = std::min(nslice,Lt-t0);
+      uint64_t slab_offset = offset;
+      uint32_t slab_nersc, slab_scidaca, slab_scidacb;
+
+      iodata.resize(slice*nt);
+      if ( control & BINARYIO_WRITE ) slab_op(t0,nt);
+      IOobject(w,grid,iodata,file,slab_offset,format,control,
+	       slab_nersc,slab_scidaca,slab_scidacb,t0,nt);
+      if ( control & BINARYIO_READ )  slab_op(t0,nt);
+      if ( digests ) chunkDigests(grid,iodata,offset,t0,nt,*digests);
+
+      nersc_csum   += slab_nersc;
+      scidac_csuma ^= slab_scidaca;
+      scidac_csumb ^= slab_scidacb;
+      perf.size    += lastPerf.size;
+      perf.time    += lastPerf.time;
+    }
+    perf.mbytesPerSecond = perf.size/1024./1024./(perf.time/1.0e6);
+    lastPerf = perf;
+  }
+
   /////////////////////////////////////////////////////////////////////////////
   // Read a Lattice of object
   //////////////////////////////////////////////////////////////////////////////////////
@@ -550,25 +1137,182 @@ class BinaryIO {
     typedef typename vobj::scalar_object sobj;
     typedef typename vobj::Realified::scalar_type word;    word w=0;
 
+    if ( latticeReadMapped ) {
+      readLatticeObjectMapped<vobj,fobj>(Umu,file,munge,offset,format,nersc_csum,scidac_csuma,scidac_csumb);
+      return;
+    }
+
     GridBase *grid = Umu.Grid();
-    uint64_t lsites = grid->lSites();
+    int nslice = SlabSlices<sobj,fobj>(grid);
 
-    std::vector<sobj> scalardata(lsites); 
-    std::vector<fobj>     iodata(lsites); // Munge, checksum, byte order in here
+    std::vector<sobj> scalardata; 
+    std::vector<fobj>     iodata; // Munge, checksum, byte order in here
     
-    IOobject(w,grid,iodata,file,offset,format,BINARYIO_READ|BINARYIO_LEXICOGRAPHIC,
-	     nersc_csum,scidac_csuma,scidac_csumb);
-
     GridStopWatch timer; 
-    timer.Start();
+    IOobjectSlabs(w,grid,iodata,nslice,file,offset,format,BINARYIO_READ|BINARYIO_LEXICOGRAPHIC,
+		  nersc_csum,scidac_csuma,scidac_csumb,
+		  [&](int t0,int nt) {
+		    timer.Start();
+		    scalardata.resize(iodata.size());
+		    thread_for(x,iodata.size(), { munge(iodata[x], scalardata[x]); });
+		    vectorizeSlab(scalardata,Umu,t0,nt);
+		    timer.Stop();
+		  });
+    grid->Barrier();
+
+    std::cout<<GridLogMessage<<"readLatticeObject: vectorize overhead "<<timer.Elapsed()  <<std::endl;
+  }
 
-    thread_for(x,lsites, { munge(iodata[x], scalardata[x]); });
+  /////////////////////////////////////////////////////////////////////////////
+  // Read a Lattice of object from a read only mapping of the file.
+  //
+  // Only the file range spanned by the local sub-volume is mapped. Each site is
+  // copied out of the mapped pages, checksummed, put in host order, munged and
+  // merged into its SIMD lanes, so there is no file order or scalar buffer. The
+  // pages live in the OS page cache, shared by the ranks on a node that read
+  // the same file.
+  //////////////////////////////////////////////////////////////////////////////////////
+  template<class vobj,class fobj,class munger>
+  static inline void readLatticeObjectMapped(Lattice<vobj> &Umu,
+					     std::string file,
+					     munger munge,
+					     uint64_t offset,
+					     const std::string &format,
+					     uint32_t &nersc_csum,
+					     uint32_t &scidac_csuma,
+					     uint32_t &scidac_csumb)
+  {
+    typedef typename vobj::scalar_object sobj;
 
-    vectorizeFromLexOrdArray(scalardata,Umu);    
+    GridBase *grid = Umu.Grid();
     grid->Barrier();
+    GridStopWatch timer;
+    timer.Start();
 
+    int word = formatSwapWord(format);
+
+    nersc_csum=0;
+    scidac_csuma=0;
+    scidac_csumb=0;
+
+    int nd = grid->Nd();
+    const int nsimd = vobj::vector_type::Nsimd();
+    Coordinate gdims  = grid->FullDimensions();
+    Coordinate ldims  = grid->LocalDimensions();
+    Coordinate lstart = grid->LocalStarts();
+
+    // File range of the local sub-volume, from its first to its last site
+    auto gindex = [&](const Coordinate &gcoor) {
+      uint64_t idx=0, stride=1;
+      for(int d=0;d<nd;d++){
+	idx    += stride*gcoor[d];
+	stride *= gdims[d];
+      }
+      return idx;
+    };
+    Coordinate last(nd);
+    for(int d=0;d<nd;d++) last[d] = lstart[d]+ldims[d]-1;
+    uint64_t gfirst = gindex(lstart);
+    uint64_t glast  = gindex(last);
+    uint64_t page  = sysconf(_SC_PAGESIZE);
+    uint64_t begin = offset + gfirst*sizeof(fobj);
+    uint64_t end   = offset + (glast+1)*sizeof(fobj);
+    uint64_t mbase = (begin/page)*page;
+
+    int fd = ::open(file.c_str(),O_RDONLY);
+    struct stat st;
+    if ( fd<0 || fstat(fd,&st) || (uint64_t)st.st_size < end ) {
+      std::cout << GridLogError << "readLatticeObjectMapped: cannot open " << file
+		<< " or shorter than " << end << " bytes" << std::endl;
+#ifdef USE_MPI_IO
+      MPI_Abort(MPI_COMM_WORLD,1);
+#else
+      exit(1);
+#endif
+    }
+    void *map = mmap(NULL,end-mbase,PROT_READ,MAP_SHARED,fd,mbase);
+    ::close(fd);
+    if ( map==MAP_FAILED ) {
+      perror("readLatticeObjectMapped: mmap");
+#ifdef USE_MPI_IO
+      MPI_Abort(MPI_COMM_WORLD,1);
+#else
+      exit(1);
+#endif
+    }
+    // Read ahead only the pages holding local runs; with x, y or z decomposed
+    // the mapped range is most of the file and belongs largely to other nodes
+    {
+      std::vector<std::pair<uint64_t,uint64_t> > runs;
+      uint64_t run = fileRuns(gdims,ldims,lstart,offset,sizeof(fobj),runs);
+      uint64_t ahead = mbase, ahead_end = mbase;
+      for(auto &r : runs){
+	uint64_t a = (r.second/page)*page;
+	if ( a > ahead_end ) {
+	  if ( ahead_end > ahead ) madvise((char *)map+(ahead-mbase),ahead_end-ahead,MADV_WILLNEED);
+	  ahead = a;
+	}
+	ahead_end = r.second+run*sizeof(fobj);
+      }
+      if ( ahead_end > ahead ) madvise((char *)map+(ahead-mbase),ahead_end-ahead,MADV_WILLNEED);
+    }
+    const char *fbase = (const char *)map + (begin-mbase);
+
+    std::vector<Coordinate> icoor(nsimd);
+    for(int lane=0;lane<nsimd;lane++) grid->iCoorFromIindex(icoor[lane],lane);
+
+    autoView( out_v, Umu, CpuWrite);
+    thread_region
+    {
+      uint32_t nersc_thr=0, scidaca_thr=0, scidacb_thr=0;
+      Coordinate ocoor(nd), gcoor(nd);
+      ExtractBuffer<sobj> buf(nsimd);
+      fobj site;
+
+      thread_for_in_region(oidx, grid->oSites(), {
+	grid->oCoorFromOindex(ocoor,oidx);
+	for(int lane=0;lane<nsimd;lane++){
+	  for(int d=0;d<nd;d++) gcoor[d] = lstart[d] + ocoor[d] + grid->_rdimensions[d]*icoor[lane][d];
+	  uint64_t gsite = gindex(gcoor);
+	  memcpy((void *)&site,fbase+(gsite-gfirst)*sizeof(fobj),sizeof(fobj));
+
+	  uint32_t gsite29  = gsite%29;
+	  uint32_t gsite31  = gsite%31;
+	  uint32_t site_crc = Grid_crc32((unsigned char *)&site,sizeof(fobj));
+	  scidaca_thr ^= site_crc<<gsite29 | site_crc>>((32-gsite29)&31);
+	  scidacb_thr ^= site_crc<<gsite31 | site_crc>>((32-gsite31)&31);
+
+	  byteSwapSite((void *)&site,sizeof(fobj),word);
+	  uint32_t *w = (uint32_t *)&site;
+	  for(uint64_t j=0;j<sizeof(fobj)/sizeof(uint32_t);j++) nersc_thr += w[j];
+
+	  munge(site,buf[lane]);
+	}
+	vobj vecobj;
+	merge(vecobj,buf);
+	out_v[oidx] = vecobj;
+      });
+
+      thread_critical
+      {
+	nersc_csum   += nersc_thr;
+	scidac_csuma ^= scidaca_thr;
+	scidac_csumb ^= scidacb_thr;
+      }
+    }
+    munmap(map,end-mbase);
+
+    grid->GlobalSum(nersc_csum);
+    grid->GlobalXOR(scidac_csuma);
+    grid->GlobalXOR(scidac_csumb);
+    grid->Barrier();
     timer.Stop();
-    std::cout<<GridLogMessage<<"readLatticeObject: vectorize overhead "<<timer.Elapsed()  <<std::endl;
+
+    lastPerf.size            = sizeof(fobj)*grid->gSites();
+    lastPerf.time            = timer.useconds();
+    lastPerf.mbytesPerSecond = lastPerf.size/1024./1024./(lastPerf.time/1.0e6);
+    std::cout<<GridLogMessage<<"readLatticeObjectMapped: read "<< lastPerf.size <<" bytes in "<< timer.Elapsed() <<" "
+	     << lastPerf.mbytesPerSecond <<" MB/s "<<std::endl;
   }
 
   /////////////////////////////////////////////////////////////////////////////
@@ -587,53 +1331,47 @@ class BinaryIO {
     typedef typename vobj::scalar_object sobj;
     typedef typename vobj::Realified::scalar_type word;    word w=0;
     GridBase *grid = Umu.Grid();
-    uint64_t lsites = grid->lSites(), offsetCopy = offset;
     int attemptsLeft = std::max(0, BinaryIO::latticeWriteMaxRetry);
-    bool checkWrite = (BinaryIO::latticeWriteMaxRetry >= 0);
+    bool checkWrite = (BinaryIO::latticeWriteMaxRetry >= 0) && (latticeWriteVerify != VerifyNone);
+    int nslice = SlabSlices<sobj,fobj>(grid);
 
-    std::vector<sobj> scalardata(lsites); 
-    std::vector<fobj>     iodata(lsites); // Munge, checksum, byte order in here
-
-    //////////////////////////////////////////////////////////////////////////////
-    // Munge [ .e.g 3rd row recon ]
-    //////////////////////////////////////////////////////////////////////////////
-    GridStopWatch timer; timer.Start();
-    unvectorizeToLexOrdArray(scalardata,Umu);    
+    std::vector<sobj> scalardata; 
+    std::vector<fobj>     iodata; // Munge, checksum, byte order in here
+    std::vector<ChunkDigest> digests;
 
-    thread_for(x, lsites, { munge(scalardata[x],iodata[x]); });
-
-    grid->Barrier();
-    timer.Stop();
+    GridStopWatch timer;
     while (attemptsLeft >= 0)
     {
       grid->Barrier();
-      IOobject(w,grid,iodata,file,offset,format,BINARYIO_WRITE|BINARYIO_LEXICOGRAPHIC,
-	             nersc_csum,scidac_csuma,scidac_csumb);
+      digests.resize(0);
+      //////////////////////////////////////////////////////////////////////////////
+      // Munge [ .e.g 3rd row recon ] each slab on its way out
+      //////////////////////////////////////////////////////////////////////////////
+      IOobjectSlabs(w,grid,iodata,nslice,file,offset,format,BINARYIO_WRITE|BINARYIO_LEXICOGRAPHIC,
+		    nersc_csum,scidac_csuma,scidac_csumb,
+		    [&](int t0,int nt) {
+		      timer.Start();
+		      scalardata.resize(iodata.size());
+		      unvectorizeSlab(scalardata,Umu,t0,nt);
+		      thread_for(x,iodata.size(), { munge(scalardata[x],iodata[x]); });
+		      timer.Stop();
+		    },
+		    checkWrite ? &digests : nullptr);
       if (checkWrite)
       {
-        std::vector<fobj> ckiodata(lsites);
-        uint32_t          cknersc_csum, ckscidac_csuma, ckscidac_csumb;
-        uint64_t          ckoffset = offsetCopy;
-
-        std::cout << GridLogMessage << "writeLatticeObject: read back object" << std::endl;
         grid->Barrier();
-        IOobject(w,grid,ckiodata,file,ckoffset,format,BINARYIO_READ|BINARYIO_LEXICOGRAPHIC,
-	               cknersc_csum,ckscidac_csuma,ckscidac_csumb);
-        if ((cknersc_csum != nersc_csum) or (ckscidac_csuma != scidac_csuma) or (ckscidac_csumb != scidac_csumb))
+        if ( !verifyChunks(grid,file,digests,latticeWriteMaxRetry-attemptsLeft) )
         {
-          std::cout << GridLogMessage << "writeLatticeObject: read test checksum failure, re-writing (" << attemptsLeft << " attempt(s) remaining)" << std::endl;
-          offset = offsetCopy;
-          thread_for(x,lsites, { munge(scalardata[x],iodata[x]); });
+          std::cout << GridLogMessage << "writeLatticeObject: verify failure, re-writing (" << attemptsLeft << " attempt(s) remaining)" << std::endl;
         }
         else
         {
-          std::cout << GridLogMessage << "writeLatticeObject: read test checksum correct" << std::endl;
+          std::cout << GridLogMessage << "writeLatticeObject: verify correct" << std::endl;
           break;
         }
       }
       attemptsLeft--;
     }
-    
 
     std::cout<<GridLogMessage<<"writeLatticeObject: unvectorize overhead "<<timer.Elapsed()  <<std::endl;
   }
@@ -705,6 +1443,36 @@ class BinaryIO {
 
     std::cout << GridLogMessage << "RNG state overhead " << timer.Elapsed() << std::endl;
   }
+  /////////////////////////////////////////////////////////////////////////////
+  // Parallel RNG state of the local sites in lexicographic order
+  //////////////////////////////////////////////////////////////////////////////////////
+  template<class RNGstate>
+  static inline void getRNGStates(GridParallelRNG &parallel_rng,std::vector<RNGstate> &iodata)
+  {
+    iodata.resize(parallel_rng.Grid()->lSites());
+    getRNGStates(parallel_rng,iodata.data());
+  }
+  template<class RNGstate>
+  static inline void getRNGStates(GridParallelRNG &parallel_rng,RNGstate *iodata)
+  {
+    typedef typename GridSerialRNG::RngStateType RngStateType;
+    const int RngStateCount = GridSerialRNG::RngStateCount;
+
+    GridBase *grid = parallel_rng.Grid();
+    uint64_t lsites = grid->lSites();
+
+    thread_for(lidx,lsites,{
+      std::vector<RngStateType> tmp(RngStateCount);
+      Coordinate lcoor;
+      grid->LocalIndexToLocalCoor(lidx, lcoor);
+      int o_idx=grid->oIndex(lcoor);
+      int i_idx=grid->iIndex(lcoor);
+      int gidx=parallel_rng.generator_idx(o_idx,i_idx);
+      parallel_rng.GetState(tmp,gidx);
+      std::copy(tmp.begin(),tmp.end(),iodata[lidx].begin());
+    });
+  }
+
   /////////////////////////////////////////////////////////////////////////////
   // Write a RNG; lexico map to an array of state and use IOobject
   //////////////////////////////////////////////////////////////////////////////////////
@@ -735,17 +1503,8 @@ class BinaryIO {
     std::cout << GridLogMessage << "RNG write I/O on file " << file << std::endl;
 
     timer.Start();
-    std::vector<RNGstate> iodata(lsites);
-    thread_for(lidx,lsites,{
-      std::vector<RngStateType> tmp(RngStateCount);
-      Coordinate lcoor;
-      grid->LocalIndexToLocalCoor(lidx, lcoor);
-      int o_idx=grid->oIndex(lcoor);
-      int i_idx=grid->iIndex(lcoor);
-      int gidx=parallel_rng.generator_idx(o_idx,i_idx);
-      parallel_rng.GetState(tmp,gidx);
-      std::copy(tmp.begin(),tmp.end(),iodata[lidx].begin());
-    });
+    std::vector<RNGstate> iodata;
+    getRNGStates(parallel_rng,iodata);
     timer.Stop();
 
     IOobject(w,grid,iodata,file,offset,format,BINARYIO_WRITE|BINARYIO_LEXICOGRAPHIC,
@@ -768,6 +1527,871 @@ class BinaryIO {
     std::cout << GridLogMessage << "RNG file checksumb " << std::hex << scidac_csumb << std::dec << std::endl;
     std::cout << GridLogMessage << "RNG state overhead " << timer.Elapsed() << std::endl;
   }
+  /////////////////////////////////////////////////////////////////////////////
+  // Parallel RNG in the native decomposition. Each rank's generators go to the
+  // file as one contiguous block, its local sites in local lexicographic order,
+  // streamed in pieces of at most latticeIOChunkBytes; there is no global
+  // lexicographic map and no volume of staged state. Blocks follow the
+  // processor grid lexicographically, after a header recording the
+  // decomposition, a crc32 per block and the serial state.
+  //
+  // Layout, header and table words uint64 big endian, state words big endian:
+  //   header  magic, version, ndim, gdims[8], processors[8], state count,
+  //           state word bytes, nblock, block offset, serial crc  (RNGHeaderWords)
+  //   table   crc32 per block
+  //   serial state
+  //   blocks
+  //
+  // A reader on the writer's processor grid streams back its own block. On any
+  // other decomposition it re-maps: it reads, with a seek per run, only the runs
+  // of the overlapping writer blocks that fall in its local volume. The block
+  // crcs are then rebuilt across the readers (see crc32Zeros).
+  //////////////////////////////////////////////////////////////////////////////////////
+  static const int      RNGHeaderWords = 32;
+  static const uint64_t RNGMagic       = 0x475249445247474EULL; // "GRIDRGGN"
+  static const uint64_t RNGVersion     = 1;
+
+  // crc32 of len zero bytes, by doubling. crc32 is affine in the message, so the
+  // crc of a block is the XOR over its readers of the crc of each reader's runs
+  // laid in zeros over the block, XOR that of the zero block when the number
+  // of readers is even.
+  static inline uLong crc32Zeros(uint64_t len)
+  {
+    const unsigned char zero = 0;
+    uLong crc = crc32(0,NULL,0);
+    uLong pow = crc32(0,&zero,1);
+    for(uint64_t plen=1;len;plen*=2,len>>=1){
+      if ( len&1 ) crc = crc32_combine(crc,pow,plen);
+      pow = crc32_combine(pow,pow,plen);
+    }
+    return crc;
+  }
+
+  static inline void writeRNGNative(GridSerialRNG &serial_rng,
+				    GridParallelRNG &parallel_rng,
+				    std::string file)
+  {
+    typedef typename GridSerialRNG::RngStateType RngStateType;
+    const int RngStateCount = GridSerialRNG::RngStateCount;
+    const uint64_t statebytes = RngStateCount*sizeof(RngStateType);
+
+    GridBase *grid = parallel_rng.Grid();
+    int ndim = grid->Nd();
+    assert(ndim <= 8);
+    Coordinate gdims = grid->GlobalDimensions();
+    Coordinate pdims = grid->ProcessorGrid();
+    Coordinate pcoor = grid->ThisProcessorCoor();
+    uint64_t lsites  = grid->lSites();
+    int      nblock  = grid->ProcessorCount();
+    int      swap    = formatSwapWord((sizeof(RngStateType)==sizeof(uint32_t)) ? "IEEE32BIG" : "IEEE64BIG");
+    int      block;
+    Lexicographic::IndexFromCoor(pcoor,block,pdims);
+
+    uint64_t data_offset  = sizeof(uint64_t)*(RNGHeaderWords+nblock)+statebytes;
+    uint64_t block_offset = data_offset+block*lsites*statebytes;
+    uint64_t piece = std::max((uint64_t)1,latticeIOChunkBytes/statebytes);
+    if ( latticeIOChunkBytes==0 ) piece = lsites;
+
+    GridStopWatch timer;
+    timer.Start();
+
+    std::vector<uint64_t> table(nblock,0);
+    std::vector<RngStateType> serial(RngStateCount);
+    serial_rng.GetState(serial,0);
+    if ( swap ) byteSwapSite(&serial[0],statebytes,swap);
+
+    std::fstream fout;
+    fout.exceptions ( std::fstream::failbit | std::fstream::badbit );
+    try {
+      if ( grid->IsBoss() ) {
+	fout.open(file,std::ios::binary|std::ios::out|std::ios::trunc);
+	fout.close();
+      }
+      grid->Barrier();
+
+      fout.open(file,std::ios::binary|std::ios::out|std::ios::in);
+      fout.seekp(block_offset);
+      std::vector<RngStateType> states;
+      uLong crc = crc32(0,NULL,0);
+      for(uint64_t s0=0;s0<lsites;s0+=piece){
+	uint64_t ns = std::min(piece,lsites-s0);
+	states.resize(ns*RngStateCount);
+	thread_for(s,ns,{
+	  std::vector<RngStateType> tmp(RngStateCount);
+	  Coordinate lcoor;
+	  grid->LocalIndexToLocalCoor(s0+s,lcoor);
+	  int gidx=parallel_rng.generator_idx(grid->oIndex(lcoor),grid->iIndex(lcoor));
+	  parallel_rng.GetState(tmp,gidx);
+	  if ( swap ) byteSwapSite(&tmp[0],statebytes,swap);
+	  std::copy(tmp.begin(),tmp.end(),states.data()+s*RngStateCount);
+	});
+	crc = crc32(crc,(unsigned char *)&states[0],ns*statebytes);
+	fout.write((char *)&states[0],ns*statebytes);
+      }
+      fout.close();
+      table[block] = crc;
+      grid->GlobalSumVector(&table[0],nblock);
+
+      if ( grid->IsBoss() ) {
+	std::vector<uint64_t> header(RNGHeaderWords,0);
+	header[0] = RNGMagic;
+	header[1] = RNGVersion;
+	header[2] = ndim;
+	for(int d=0;d<ndim;d++){
+	  header[3+d]  = gdims[d];
+	  header[11+d] = pdims[d];
+	}
+	header[19] = RngStateCount;
+	header[20] = sizeof(RngStateType);
+	header[21] = nblock;
+	header[22] = data_offset;
+	header[23] = crc32(0,(unsigned char *)&serial[0],statebytes);
+	for(auto &h : header) h = Grid_ntohll(h);
+	for(auto &h : table)  h = Grid_ntohll(h);
+	fout.open(file,std::ios::binary|std::ios::out|std::ios::in);
+	fout.write((char *)&header[0],header.size()*sizeof(uint64_t));
+	fout.write((char *)&table[0],table.size()*sizeof(uint64_t));
+	fout.write((char *)&serial[0],statebytes);
+	fout.close();
+      }
+    } catch (const std::fstream::failure& exc) {
+      std::cout << GridLogError << "Error in writing RNG file " << file << std::endl;
+      std::cout << GridLogError << "Exception description: " << exc.what() << std::endl;
+#ifdef USE_MPI_IO
+      MPI_Abort(MPI_COMM_WORLD,1);
+#else
+      exit(1);
+#endif
+    }
+    grid->Barrier();
+    timer.Stop();
+
+    lastPerf.size            = statebytes*grid->gSites();
+    lastPerf.time            = timer.useconds();
+    lastPerf.mbytesPerSecond = lastPerf.size/1024./1024./(lastPerf.time/1.0e6);
+    std::cout << GridLogMessage << "writeRNGNative: " << lastPerf.size << " bytes in " << nblock
+	      << " blocks in " << timer.Elapsed() << " " << lastPerf.mbytesPerSecond << " MB/s" << std::endl;
+  }
+
+  static inline void readRNGNative(GridSerialRNG &serial_rng,
+				   GridParallelRNG &parallel_rng,
+				   std::string file)
+  {
+    typedef typename GridSerialRNG::RngStateType RngStateType;
+    const int RngStateCount = GridSerialRNG::RngStateCount;
+    const uint64_t statebytes = RngStateCount*sizeof(RngStateType);
+
+    GridBase *grid = parallel_rng.Grid();
+    int ndim = grid->Nd();
+    Coordinate gdims = grid->GlobalDimensions();
+    Coordinate ldims = grid->LocalDimensions();
+    Coordinate pdims = grid->ProcessorGrid();
+    Coordinate pcoor = grid->ThisProcessorCoor();
+    uint64_t lsites  = grid->lSites();
+    int      swap    = formatSwapWord((sizeof(RngStateType)==sizeof(uint32_t)) ? "IEEE32BIG" : "IEEE64BIG");
+
+    GridStopWatch timer;
+    timer.Start();
+
+    std::ifstream fin(file,std::ios::binary);
+    std::vector<uint64_t> header(RNGHeaderWords);
+    fin.read((char *)&header[0],header.size()*sizeof(uint64_t));
+    assert(!fin.fail());
+    for(auto &h : header) h = Grid_ntohll(h);
+    assert(header[0]==RNGMagic);
+    assert(header[1]==RNGVersion);
+    assert(header[2]==ndim);
+    assert(header[19]==RngStateCount);
+    assert(header[20]==sizeof(RngStateType));
+    int nblock = header[21];
+    uint64_t data_offset = header[22];
+
+    // Writer decomposition
+    Coordinate wdims(ndim), wldims(ndim);
+    bool native = true;
+    uint64_t wsites = 1;
+    for(int d=0;d<ndim;d++){
+      assert(header[3+d]==gdims[d]);
+      wdims[d]  = header[11+d];
+      wldims[d] = gdims[d]/wdims[d];
+      wsites   *= wldims[d];
+      if ( wdims[d]!=pdims[d] ) native = false;
+    }
+    std::vector<uint64_t> table(nblock);
+    fin.read((char *)&table[0],table.size()*sizeof(uint64_t));
+    for(auto &h : table) h = Grid_ntohll(h);
+
+    std::vector<RngStateType> serial(RngStateCount);
+    fin.read((char *)&serial[0],statebytes);
+    assert(!fin.fail());
+    uint64_t bad = (crc32(0,(unsigned char *)&serial[0],statebytes)!=header[23]);
+    if ( swap ) byteSwapSite(&serial[0],statebytes,swap);
+    serial_rng.SetState(serial,0);
+
+    auto setStates = [&](std::vector<RngStateType> &states,uint64_t ns,const std::vector<uint64_t> &lidx) {
+      thread_for(s,ns,{
+	std::vector<RngStateType> tmp(states.data()+s*RngStateCount,states.data()+(s+1)*RngStateCount);
+	if ( swap ) byteSwapSite(&tmp[0],statebytes,swap);
+	Coordinate lcoor;
+	grid->LocalIndexToLocalCoor(lidx[s],lcoor);
+	int gidx=parallel_rng.generator_idx(grid->oIndex(lcoor),grid->iIndex(lcoor));
+	parallel_rng.SetState(tmp,gidx);
+      });
+    };
+
+    std::vector<RngStateType> states;
+    std::vector<uint64_t> lidx;
+    if ( native ) {
+      // Own block, streamed
+      int block;
+      Lexicographic::IndexFromCoor(pcoor,block,pdims);
+      uint64_t piece = std::max((uint64_t)1,latticeIOChunkBytes/statebytes);
+      if ( latticeIOChunkBytes==0 ) piece = lsites;
+      fin.seekg(data_offset+block*lsites*statebytes);
+      uLong crc = crc32(0,NULL,0);
+      for(uint64_t s0=0;s0<lsites;s0+=piece){
+	uint64_t ns = std::min(piece,lsites-s0);
+	states.resize(ns*RngStateCount);
+	lidx.resize(ns);
+	fin.read((char *)&states[0],ns*statebytes);
+	crc = crc32(crc,(unsigned char *)&states[0],ns*statebytes);
+	for(uint64_t s=0;s<ns;s++) lidx[s] = s0+s;
+	setStates(states,ns,lidx);
+      }
+      if ( crc!=table[block] ) bad++;
+    } else {
+      // Re-map: the runs of the overlapping writer blocks in the local volume
+      Coordinate gStart(ndim), lo(ndim), span(ndim);
+      int noverlap = 1;
+      for(int d=0;d<ndim;d++){
+	gStart[d] = ldims[d]*pcoor[d];
+	lo[d]     = gStart[d]/wldims[d];
+	span[d]   = (gStart[d]+ldims[d]-1)/wldims[d] - lo[d] + 1;
+	noverlap *= span[d];
+      }
+      uint64_t piece = std::max((uint64_t)1,latticeIOChunkBytes/statebytes);
+      if ( latticeIOChunkBytes==0 ) piece = lsites;
+      uint64_t wbytes = wsites*statebytes;
+
+      // Per block, the bits of this rank's partial crc and a reader count
+      std::vector<uint64_t> crcbits(33*nblock,0);
+      std::map<uint64_t,uLong> zeros;
+      auto skip = [&](uLong crc,uint64_t len) {
+	if ( len==0 ) return crc;
+	auto z = zeros.find(len);
+	if ( z==zeros.end() ) z = zeros.insert(std::make_pair(len,crc32Zeros(len))).first;
+	return crc32_combine(crc,z->second,len);
+      };
+
+      std::vector<std::pair<uint64_t,uint64_t> > runs;
+      for(int b=0;b<noverlap;b++){
+	Coordinate wcoor;
+	int block;
+	Lexicographic::CoorFromIndex(wcoor,b,span);
+	for(int d=0;d<ndim;d++) wcoor[d] += lo[d];
+	Lexicographic::IndexFromCoor(wcoor,block,wdims);
+
+	// Overlap of writer block and local volume, in the block's coordinates
+	Coordinate olo(ndim), oext(ndim), ostart(ndim);
+	for(int d=0;d<ndim;d++){
+	  int w0    = wcoor[d]*wldims[d];
+	  olo[d]    = std::max(w0,gStart[d]);
+	  oext[d]   = std::min(w0+wldims[d],gStart[d]+ldims[d]) - olo[d];
+	  ostart[d] = olo[d]-w0;
+	}
+	uint64_t base = data_offset+block*wbytes;
+	uint64_t run  = fileRuns(wldims,oext,ostart,base,statebytes,runs);
+	uint64_t nrun = runs.size();
+	uint64_t group = std::max((uint64_t)1,piece/run);
+
+	uLong    crc  = crc32(0,NULL,0);
+	uint64_t cpos = 0;
+	for(uint64_t r0=0;r0<nrun;r0+=group){
+	  uint64_t nr = std::min(group,nrun-r0);
+	  uint64_t ns = nr*run;
+	  states.resize(ns*RngStateCount);
+	  lidx.resize(ns);
+	  for(uint64_t r=0;r<nr;r++){
+	    unsigned char *buf = (unsigned char *)&states[r*run*RngStateCount];
+	    uint64_t pos = runs[r0+r].second;
+	    fin.seekg(pos);
+	    fin.read((char *)buf,run*statebytes);
+	    crc  = skip(crc,pos-base-cpos);
+	    crc  = crc32(crc,buf,run*statebytes);
+	    cpos = pos-base+run*statebytes;
+	  }
+	  thread_for(s,ns,{
+	    Coordinate o, lc(ndim);
+	    Lexicographic::CoorFromIndex(o,runs[r0+s/run].first+s%run,oext);
+	    for(int d=0;d<ndim;d++) lc[d] = olo[d]+o[d]-gStart[d];
+	    int lsite;
+	    Lexicographic::IndexFromCoor(lc,lsite,ldims);
+	    lidx[s] = lsite;
+	  });
+	  setStates(states,ns,lidx);
+	}
+	crc = skip(crc,wbytes-cpos);
+	for(int k=0;k<32;k++) crcbits[33*block+k] = (crc>>k)&1;
+	crcbits[33*block+32] = 1;
+      }
+
+      // XOR of the partial crcs as bit parities
+      grid->GlobalSumVector(&crcbits[0],33*nblock);
+      if ( grid->IsBoss() ) {
+	uLong zblock = crc32Zeros(wbytes);
+	for(int block=0;block<nblock;block++){
+	  uLong crc = 0;
+	  for(int k=0;k<32;k++) crc |= (uLong)(crcbits[33*block+k]&1)<<k;
+	  if ( (crcbits[33*block+32]&1)==0 ) crc ^= zblock;
+	  if ( crc!=table[block] ) bad++;
+	}
+      }
+    }
+    assert(!fin.fail());
+    fin.close();
+
+    grid->GlobalSum(bad);
+    if ( bad ) {
+      std::cout << GridLogError << "readRNGNative: " << bad << " corrupt blocks in " << file << std::endl;
+    }
+    assert(bad==0);
+    grid->Barrier();
+    timer.Stop();
+
+    lastPerf.size            = statebytes*grid->gSites();
+    lastPerf.time            = timer.useconds();
+    lastPerf.mbytesPerSecond = lastPerf.size/1024./1024./(lastPerf.time/1.0e6);
+    std::cout << GridLogMessage << "readRNGNative: " << lastPerf.size << " bytes, "
+	      << (native ? "native" : "re-mapped") << " decomposition, in " << timer.Elapsed() << " "
+	      << lastPerf.mbytesPerSecond << " MB/s" << std::endl;
+  }
+  /////////////////////////////////////////////////////////////////////////////
+  // Staged writes. stageLatticeObject and stageRNG do all the collective work of
+  // writeLatticeObject and writeRNG (unvectorise, munge, checksum, byte order)
+  // and keep this rank's sites as a file order image. writeStagedObject later
+  // puts the image in the file with plain POSIX I/O, touching neither the grid
+  // nor MPI, so it may run on a background thread while the main thread goes on
+  // communicating. The file must exist before any rank writes its image.
+  //////////////////////////////////////////////////////////////////////////////////////
+  struct StagedObject {
+    std::string file;
+    uint64_t offset;          // start of the global array in the file
+    uint64_t bytes;           // per site
+    Coordinate gLattice;
+    Coordinate lLattice;
+    Coordinate gStart;
+    std::vector<char> data;   // local sites, lexicographic
+    std::vector<char> tail;   // written after the global array; boss only
+  };
+
+  // Sizes staged.data for this rank's sites and records where they go
+  template<class fobj>
+  static inline fobj *stageBuffer(StagedObject &staged,
+				  GridBase *grid,
+				  std::string file,
+				  uint64_t offset)
+  {
+    int ndim = grid->Dimensions();
+    Coordinate pcoor = grid->ThisProcessorCoor();
+    staged.file     = file;
+    staged.offset   = offset;
+    staged.bytes    = sizeof(fobj);
+    staged.gLattice = grid->GlobalDimensions();
+    staged.lLattice = grid->LocalDimensions();
+    staged.gStart.resize(ndim);
+    for(int d=0;d<ndim;d++) staged.gStart[d] = staged.lLattice[d]*pcoor[d];
+    staged.data.resize(sizeof(fobj)*grid->lSites());
+    staged.tail.resize(0);
+    return (fobj *)staged.data.data();
+  }
+
+  // Checksums the host order image in staged.data and leaves it in file order
+  template<class fobj>
+  static inline void stageChecksum(StagedObject &staged,
+				   GridBase *grid,
+				   const std::string &format,
+				   uint32_t &nersc_csum,
+				   uint32_t &scidac_csuma,
+				   uint32_t &scidac_csumb)
+  {
+    nersc_csum=0;
+    scidac_csuma=0;
+    scidac_csumb=0;
+    ConvertChecksum(grid,(fobj *)staged.data.data(),staged.data.size()/sizeof(fobj),format,false,
+		    nersc_csum,scidac_csuma,scidac_csumb);
+    grid->GlobalSum(nersc_csum);
+    grid->GlobalXOR(scidac_csuma);
+    grid->GlobalXOR(scidac_csumb);
+  }
+
+  template<class vobj,class fobj,class munger>
+  static inline void stageLatticeObject(StagedObject &staged,
+					Lattice<vobj> &Umu,
+					std::string file,
+					munger munge,
+					uint64_t offset,
+					const std::string &format,
+					uint32_t &nersc_csum,
+					uint32_t &scidac_csuma,
+					uint32_t &scidac_csumb)
+  {
+    typedef typename vobj::scalar_object sobj;
+    GridBase *grid = Umu.Grid();
+    uint64_t lsites = grid->lSites();
+
+    fobj *iodata = stageBuffer<fobj>(staged,grid,file,offset);
+    {
+      std::vector<sobj> scalardata(lsites);
+      unvectorizeToLexOrdArray(scalardata,Umu);
+      thread_for(x, lsites, { munge(scalardata[x],iodata[x]); });
+    }
+    stageChecksum<fobj>(staged,grid,format,nersc_csum,scidac_csuma,scidac_csumb);
+  }
+
+  static inline void stageRNG(StagedObject &staged,
+			      GridSerialRNG &serial_rng,
+			      GridParallelRNG &parallel_rng,
+			      std::string file,
+			      uint64_t offset,
+			      uint32_t &nersc_csum,
+			      uint32_t &scidac_csuma,
+			      uint32_t &scidac_csumb)
+  {
+    typedef typename GridSerialRNG::RngStateType RngStateType;
+    const int RngStateCount = GridSerialRNG::RngStateCount;
+    typedef std::array<RngStateType,RngStateCount> RNGstate;
+
+    GridBase *grid = parallel_rng.Grid();
+    std::string format = "IEEE32BIG";
+
+    getRNGStates(parallel_rng,stageBuffer<RNGstate>(staged,grid,file,offset));
+    stageChecksum<RNGstate>(staged,grid,format,nersc_csum,scidac_csuma,scidac_csumb);
+
+    // Serial state follows the array, as BINARYIO_MASTER_APPEND in writeRNG
+    std::vector<RNGstate> serial(1);
+    {
+      std::vector<RngStateType> tmp(RngStateCount);
+      serial_rng.GetState(tmp,0);
+      std::copy(tmp.begin(),tmp.end(),serial[0].begin());
+    }
+    uint32_t nersc_csum_tmp=0, scidac_csuma_tmp=0, scidac_csumb_tmp=0;
+    NerscChecksum(grid,serial,nersc_csum_tmp);
+    htobe32_v((void *)&serial[0], sizeof(RNGstate));
+    ScidacChecksum(grid,serial,scidac_csuma_tmp,scidac_csumb_tmp);
+    nersc_csum   = nersc_csum   + nersc_csum_tmp;
+    scidac_csuma = scidac_csuma ^ scidac_csuma_tmp;
+    scidac_csumb = scidac_csumb ^ scidac_csumb_tmp;
+    if ( grid->IsBoss() ) {
+      staged.tail.resize(sizeof(RNGstate));
+      std::memcpy(&staged.tail[0],&serial[0],sizeof(RNGstate));
+    }
+  }
+
+  // Neither logs nor aborts, as it may run off the main thread while MPI is
+  // THREAD_SERIALIZED; returns false with the reason in error, for the caller
+  // to report from the main thread.
+  static inline bool writeStagedObject(StagedObject &staged,std::string &error)
+  {
+    int nd = staged.lLattice.size();
+    uint64_t gsites = 1;
+    for(int d=0;d<nd;d++) gsites *= staged.gLattice[d];
+
+    // Local sites go out in runs that are contiguous in the file
+    std::vector<std::pair<uint64_t,uint64_t> > runs;
+    uint64_t run = fileRuns(staged.gLattice,staged.lLattice,staged.gStart,staged.offset,staged.bytes,runs);
+
+    std::fstream fout;
+    fout.exceptions ( std::fstream::failbit | std::fstream::badbit );
+    try {
+      fout.open(staged.file,std::ios::binary|std::ios::out|std::ios::in);
+      for(auto &rp : runs){
+	fout.seekp(rp.second);
+	fout.write(&staged.data[rp.first*staged.bytes],run*staged.bytes);
+      }
+      if ( staged.tail.size() ) {
+	fout.seekp(staged.offset+gsites*staged.bytes);
+	fout.write(&staged.tail[0],staged.tail.size());
+      }
+      fout.close();
+    } catch (const std::fstream::failure& exc) {
+      error = "Error in writing staged file " + staged.file + ": " + exc.what();
+      return false;
+    }
+    return true;
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  // Compressed lattice container, for propagators and eigenvectors where the
+  // raw IEEE words dominate the storage.
+  //
+  // A chunk is a block of whole outermost slices of one writer rank's local
+  // volume, at most latticeCompressChunkBytes of file objects. Its big endian
+  // words are byte shuffled (every first byte, then every second byte, ...) so
+  // that sign, exponent and high mantissa bytes sit together, then deflated by
+  // zlib. Chunks are compressed and inflated independently under thread_for;
+  // each rank writes its own chunks in one contiguous extent, and a reader of
+  // any decomposition inflates only the chunks overlapping its sites.
+  //
+  // Layout, every integer uint64 big endian:
+  //   header  magic, version, ndim, gdims[8], cdims[8], site bytes, word bytes,
+  //           mantissa bits, nchunk, data offset       (CompressHeaderWords)
+  //   table   per chunk, lexicographic in the chunk grid: offset, length, crc32
+  //           of the big endian words before the shuffle
+  //   chunks
+  //
+  // Lossy precision is opt in: with mantissa_bits below the width of the file
+  // word, each real word is rounded to nearest with that many explicit mantissa
+  // bits and the rest zeroed, a relative error of at most 2^-(mantissa_bits+1)
+  // per word. The zeroed low bytes cost next to nothing after the shuffle.
+  // Words that would round past the largest finite value keep that value, with
+  // the dropped bits cleared; Inf and NaN pass through.
+  // CompressFP32, CompressFP16 and CompressBF16 keep the mantissa of those
+  // formats; the exponent range stays that of the file word.
+  //////////////////////////////////////////////////////////////////////////////////////
+  enum { CompressLossless=-1, CompressBF16=7, CompressFP16=10, CompressFP32=23 };
+  static const int      CompressHeaderWords = 32;
+  static const uint64_t CompressMagic       = 0x475249445A4C4154ULL; // "GRIDZLAT"
+  static const uint64_t CompressVersion     = 1;
+
+  static inline void truncateMantissa(void *site,uint64_t bytes,int word,int bits)
+  {
+    if ( word==sizeof(uint32_t) && bits < 23 ) {
+      uint32_t *f   = (uint32_t *)site;
+      uint32_t drop = 23-bits;
+      uint32_t half = 1U<<(drop-1);
+      uint32_t mask = ~((1U<<drop)-1);
+      for(uint64_t i=0;i<bytes/sizeof(uint32_t);i++){
+	if ( (f[i]&0x7F800000U)==0x7F800000U ) continue;
+	uint32_t r = (f[i]+half)&mask; // carry into the exponent rounds up
+	if ( (r&0x7F800000U)==0x7F800000U ) r = (f[i]&0x80000000U) | (0x7F7FFFFFU&mask); // not past the largest finite
+	f[i] = r;
+      }
+    }
+    if ( word==sizeof(uint64_t) && bits < 52 ) {
+      uint64_t *f   = (uint64_t *)site;
+      uint64_t drop = 52-bits;
+      uint64_t half = 1ULL<<(drop-1);
+      uint64_t mask = ~((1ULL<<drop)-1);
+      for(uint64_t i=0;i<bytes/sizeof(uint64_t);i++){
+	if ( (f[i]&0x7FF0000000000000ULL)==0x7FF0000000000000ULL ) continue;
+	uint64_t r = (f[i]+half)&mask;
+	if ( (r&0x7FF0000000000000ULL)==0x7FF0000000000000ULL ) r = (f[i]&0x8000000000000000ULL) | (0x7FEFFFFFFFFFFFFFULL&mask);
+	f[i] = r;
+      }
+    }
+  }
+  static inline void byteShuffle(const unsigned char *in,unsigned char *out,uint64_t bytes,int word)
+  {
+    uint64_t n = bytes/word;
+    for(int b=0;b<word;b++){
+      for(uint64_t i=0;i<n;i++) out[b*n+i] = in[i*word+b];
+    }
+  }
+  static inline void byteUnshuffle(const unsigned char *in,unsigned char *out,uint64_t bytes,int word)
+  {
+    uint64_t n = bytes/word;
+    for(int b=0;b<word;b++){
+      for(uint64_t i=0;i<n;i++) out[i*word+b] = in[b*n+i];
+    }
+  }
+
+  template<class vobj,class fobj,class munger>
+  static inline void writeLatticeCompressed(Lattice<vobj> &Umu,
+					    std::string file,
+					    munger munge,
+					    int mantissa_bits=CompressLossless)
+  {
+    typedef typename vobj::scalar_object sobj;
+    typedef typename fobj::Realified::scalar_type fword;
+    const int word     = sizeof(fword);
+    const int mantissa = (word==sizeof(uint32_t)) ? 23 : 52;
+    static_assert(sizeof(fword)==sizeof(uint32_t) || sizeof(fword)==sizeof(uint64_t),"IEEE32 or IEEE64 file words");
+    if ( mantissa_bits < 0 ) mantissa_bits = mantissa;
+    assert(mantissa_bits <= mantissa);
+
+    GridBase *grid = Umu.Grid();
+    int ndim = grid->Nd();
+    int tdim = ndim-1;
+    assert(ndim <= 8);
+    Coordinate gdims = grid->GlobalDimensions();
+    Coordinate ldims = grid->LocalDimensions();
+    Coordinate pcoor = grid->ThisProcessorCoor();
+    int      Lt    = ldims[tdim];
+    uint64_t slice = grid->lSites()/Lt;
+
+    // Chunks of tb whole slices, tb dividing the local extent
+    int tb = 1;
+    for(int t=1;t<=Lt;t++) if ( Lt%t==0 && t*slice*sizeof(fobj) <= latticeCompressChunkBytes ) tb = t;
+    int lchunk = Lt/tb;
+    Coordinate cdims = ldims; cdims[tdim] = tb;
+    Coordinate cgrid(ndim);
+    uint64_t nchunk = 1;
+    for(int d=0;d<ndim;d++) { cgrid[d] = gdims[d]/cdims[d]; nchunk *= cgrid[d]; }
+    uint64_t cbytes = slice*tb*sizeof(fobj);
+
+    GridStopWatch timer;
+    timer.Start();
+
+    // Slabs of whole chunks within the latticeIOChunkBytes budget
+    int nslice = std::max(tb,SlabSlices<sobj,fobj>(grid)/tb*tb);
+    int swap   = formatSwapWord((word==sizeof(uint32_t)) ? "IEEE32BIG" : "IEEE64BIG");
+    std::vector<std::vector<unsigned char> > zdata(lchunk);
+    std::vector<uint32_t> crcs(lchunk);
+    std::vector<sobj> scalardata;
+    std::vector<fobj> iodata;
+    for(int t0=0;t0<Lt;t0+=nslice){
+      int nt = std::min(nslice,Lt-t0);
+      int c0 = t0/tb;
+      scalardata.resize(slice*nt);
+      iodata.resize(slice*nt);
+      unvectorizeSlab(scalardata,Umu,t0,nt);
+      thread_for(x,iodata.size(),{ munge(scalardata[x],iodata[x]); });
+      thread_for(c,nt/tb,{
+	unsigned char *raw = (unsigned char *)&iodata[c*slice*tb];
+	if ( mantissa_bits < mantissa ) truncateMantissa(raw,cbytes,word,mantissa_bits);
+	if ( swap ) byteSwapSite(raw,cbytes,swap);
+	crcs[c0+c] = crc32(0,raw,cbytes);
+	std::vector<unsigned char> shuffled(cbytes);
+	byteShuffle(raw,&shuffled[0],cbytes,word);
+	uLongf zbytes = compressBound(cbytes);
+	zdata[c0+c].resize(zbytes);
+	int rc = compress2(&zdata[c0+c][0],&zbytes,&shuffled[0],cbytes,latticeCompressLevel);
+	assert(rc==Z_OK);
+	zdata[c0+c].resize(zbytes);
+      });
+    }
+    scalardata = std::vector<sobj>();
+    iodata     = std::vector<fobj>();
+
+    // Ranks' extents follow the table in rank order
+    int nrank = grid->ProcessorCount();
+    int me    = grid->ThisRank();
+    std::vector<uint64_t> rankbytes(nrank,0);
+    for(auto &z : zdata) rankbytes[me] += z.size();
+    grid->GlobalSumVector(&rankbytes[0],nrank);
+    uint64_t data_offset = sizeof(uint64_t)*(CompressHeaderWords+3*nchunk);
+    uint64_t extent = data_offset;
+    for(int r=0;r<me;r++) extent += rankbytes[r];
+
+    std::vector<uint64_t> table(3*nchunk,0);
+    uint64_t pos = extent;
+    for(int c=0;c<lchunk;c++){
+      Coordinate ccoor = pcoor;
+      ccoor[tdim] = pcoor[tdim]*lchunk+c;
+      int idx;
+      Lexicographic::IndexFromCoor(ccoor,idx,cgrid);
+      table[3*idx+0] = pos;
+      table[3*idx+1] = zdata[c].size();
+      table[3*idx+2] = crcs[c];
+      pos += zdata[c].size();
+    }
+    grid->GlobalSumVector(&table[0],3*nchunk);
+
+    std::fstream fout;
+    fout.exceptions ( std::fstream::failbit | std::fstream::badbit );
+    try {
+      if ( grid->IsBoss() ) {
+	std::vector<uint64_t> header(CompressHeaderWords,0);
+	header[0] = CompressMagic;
+	header[1] = CompressVersion;
+	header[2] = ndim;
+	for(int d=0;d<ndim;d++){
+	  header[3+d]  = gdims[d];
+	  header[11+d] = cdims[d];
+	}
+	header[19] = sizeof(fobj);
+	header[20] = word;
+	header[21] = mantissa_bits;
+	header[22] = nchunk;
+	header[23] = data_offset;
+	for(auto &h : header) h = Grid_ntohll(h);
+	for(auto &h : table)  h = Grid_ntohll(h);
+	fout.open(file,std::ios::binary|std::ios::out|std::ios::trunc);
+	fout.write((char *)&header[0],header.size()*sizeof(uint64_t));
+	fout.write((char *)&table[0],table.size()*sizeof(uint64_t));
+	fout.close();
+      }
+      grid->Barrier();
+      fout.open(file,std::ios::binary|std::ios::out|std::ios::in);
+      fout.seekp(extent);
+      for(auto &z : zdata) fout.write((char *)&z[0],z.size());
+      fout.close();
+    } catch (const std::fstream::failure& exc) {
+      std::cout << GridLogError << "Error in writing compressed file " << file << std::endl;
+      std::cout << GridLogError << "Exception description: " << exc.what() << std::endl;
+#ifdef USE_MPI_IO
+      MPI_Abort(MPI_COMM_WORLD,1);
+#else
+      exit(1);
+#endif
+    }
+    grid->Barrier();
+    timer.Stop();
+
+    uint64_t zbytes = rankbytes[me];
+    grid->GlobalSum(zbytes);
+    lastPerf.size            = sizeof(fobj)*grid->gSites();
+    lastPerf.time            = timer.useconds();
+    lastPerf.mbytesPerSecond = lastPerf.size/1024./1024./(lastPerf.time/1.0e6);
+    std::cout << GridLogMessage << "writeLatticeCompressed: " << lastPerf.size << " bytes in " << zbytes
+	      << " (ratio " << (double)lastPerf.size/zbytes << "), " << nchunk << " chunks, "
+	      << mantissa_bits << " mantissa bits, in " << timer.Elapsed() << " "
+	      << lastPerf.mbytesPerSecond << " MB/s" << std::endl;
+  }
+
+  template<class vobj,class fobj,class munger>
+  static inline void readLatticeCompressed(Lattice<vobj> &Umu,
+					   std::string file,
+					   munger munge)
+  {
+    typedef typename vobj::scalar_object sobj;
+    typedef typename fobj::Realified::scalar_type fword;
+    const int word = sizeof(fword);
+
+    GridBase *grid = Umu.Grid();
+    int ndim = grid->Nd();
+    int tdim = ndim-1;
+    Coordinate gdims = grid->GlobalDimensions();
+    Coordinate ldims = grid->LocalDimensions();
+    Coordinate pcoor = grid->ThisProcessorCoor();
+    uint64_t lsites  = grid->lSites();
+
+    GridStopWatch timer;
+    timer.Start();
+
+    std::vector<uint64_t> header(CompressHeaderWords);
+    std::ifstream fin(file,std::ios::binary);
+    fin.read((char *)&header[0],header.size()*sizeof(uint64_t));
+    assert(!fin.fail());
+    for(auto &h : header) h = Grid_ntohll(h);
+    assert(header[0]==CompressMagic);
+    assert(header[1]==CompressVersion);
+    assert(header[2]==ndim);
+    assert(header[19]==sizeof(fobj));
+    assert(header[20]==word);
+    Coordinate cdims(ndim), cgrid(ndim), gStart(ndim), lo(ndim), span(ndim);
+    uint64_t csites = 1;
+    uint64_t nmine  = 1;
+    for(int d=0;d<ndim;d++){
+      assert(header[3+d]==gdims[d]);
+      cdims[d]  = header[11+d];
+      cgrid[d]  = gdims[d]/cdims[d];
+      gStart[d] = ldims[d]*pcoor[d];
+      lo[d]     = gStart[d]/cdims[d];
+      span[d]   = (gStart[d]+ldims[d]-1)/cdims[d] - lo[d] + 1;
+      csites   *= cdims[d];
+      nmine    *= span[d];
+    }
+    uint64_t nchunk = header[22];
+    uint64_t cbytes = csites*sizeof(fobj);
+    int      swap   = formatSwapWord((word==sizeof(uint32_t)) ? "IEEE32BIG" : "IEEE64BIG");
+
+    std::vector<uint64_t> table(3*nchunk);
+    fin.read((char *)&table[0],table.size()*sizeof(uint64_t));
+    for(auto &h : table) h = Grid_ntohll(h);
+
+    // The chunks overlapping the local volume; m runs slowest in the outermost dimension
+    std::vector<int> cidx(nmine);
+    uint64_t zbytes = 0;
+    for(int m=0;m<nmine;m++){
+      Coordinate ccoor;
+      Lexicographic::CoorFromIndex(ccoor,m,span);
+      for(int d=0;d<ndim;d++) ccoor[d] += lo[d];
+      Lexicographic::IndexFromCoor(ccoor,cidx[m],cgrid);
+      zbytes += table[3*cidx[m]+1];
+    }
+    uint64_t mslice = nmine/span[tdim];
+
+    // Slabs of local slices within the latticeIOChunkBytes budget. Each inflates
+    // the chunks it overlaps; a chunk straddling two slabs is inflated in both.
+    int      Lt     = ldims[tdim];
+    uint64_t slice  = lsites/Lt;
+    int      nslice = SlabSlices<sobj,fobj>(grid);
+    std::vector<int> bad(nmine,0);
+    std::vector<std::vector<unsigned char> > zdata;
+    std::vector<fobj> iodata;
+    std::vector<sobj> scalardata;
+    for(int t0=0;t0<Lt;t0+=nslice){
+      int nt = std::min(nslice,Lt-t0);
+      Coordinate sStart = gStart; sStart[tdim] += t0;
+      Coordinate sdims  = ldims;  sdims[tdim]   = nt;
+      uint64_t m0 = (sStart[tdim]/cdims[tdim]-lo[tdim])*mslice;
+      uint64_t m1 = ((sStart[tdim]+nt-1)/cdims[tdim]-lo[tdim]+1)*mslice;
+
+      zdata.resize(m1-m0);
+      for(uint64_t m=m0;m<m1;m++){
+	zdata[m-m0].resize(table[3*cidx[m]+1]);
+	fin.seekg(table[3*cidx[m]]);
+	fin.read((char *)&zdata[m-m0][0],zdata[m-m0].size());
+      }
+      assert(!fin.fail());
+
+      iodata.resize(slice*nt);
+      thread_for(mm,m1-m0,{
+	uint64_t m = m0+mm;
+	std::vector<unsigned char> shuffled(cbytes);
+	std::vector<unsigned char> raw(cbytes);
+	uLongf bytes = cbytes;
+	int rc = uncompress(&shuffled[0],&bytes,&zdata[mm][0],zdata[mm].size());
+	if ( rc!=Z_OK || bytes!=cbytes ) {
+	  bad[m] = 1;
+	} else {
+	  byteUnshuffle(&shuffled[0],&raw[0],cbytes,word);
+	  if ( crc32(0,&raw[0],cbytes)!=table[3*cidx[m]+2] ) bad[m] = 1;
+	  if ( swap ) byteSwapSite(&raw[0],cbytes,swap);
+
+	  // Overlap of chunk and slab, in runs along the first dimension
+	  Coordinate ccoor, olo(ndim), oext(ndim);
+	  Lexicographic::CoorFromIndex(ccoor,cidx[m],cgrid);
+	  for(int d=0;d<ndim;d++){
+	    int c0 = ccoor[d]*cdims[d];
+	    olo[d]  = std::max(c0,sStart[d]);
+	    oext[d] = std::min(c0+cdims[d],sStart[d]+sdims[d]) - olo[d];
+	    ccoor[d] = c0;
+	  }
+	  int run = oext[0];
+	  oext[0] = 1;
+	  uint64_t nrun = 1;
+	  for(int d=0;d<ndim;d++) nrun *= oext[d];
+	  Coordinate o, cc(ndim), lc(ndim);
+	  for(int r=0;r<nrun;r++){
+	    Lexicographic::CoorFromIndex(o,r,oext);
+	    for(int d=0;d<ndim;d++){
+	      cc[d] = olo[d]+o[d]-ccoor[d];
+	      lc[d] = olo[d]+o[d]-sStart[d];
+	    }
+	    int csite, lsite;
+	    Lexicographic::IndexFromCoor(cc,csite,cdims);
+	    Lexicographic::IndexFromCoor(lc,lsite,sdims);
+	    std::memcpy((void *)&iodata[lsite],&raw[csite*sizeof(fobj)],run*sizeof(fobj));
+	  }
+	}
+      });
+
+      scalardata.resize(iodata.size());
+      thread_for(x,iodata.size(),{ munge(iodata[x],scalardata[x]); });
+      vectorizeSlab(scalardata,Umu,t0,nt);
+    }
+    fin.close();
+
+    uint64_t nbad = 0;
+    for(auto b : bad) nbad += b;
+    grid->GlobalSum(nbad);
+    if ( nbad ) {
+      std::cout << GridLogError << "readLatticeCompressed: " << nbad << " corrupt chunks in " << file << std::endl;
+    }
+    assert(nbad==0);
+    grid->Barrier();
+    timer.Stop();
+
+    grid->GlobalSum(zbytes);
+    lastPerf.size            = sizeof(fobj)*grid->gSites();
+    lastPerf.time            = timer.useconds();
+    lastPerf.mbytesPerSecond = lastPerf.size/1024./1024./(lastPerf.time/1.0e6);
+    std::cout << GridLogMessage << "readLatticeCompressed: " << lastPerf.size << " bytes from " << zbytes
+	      << " (" << header[21] << " mantissa bits) in " << timer.Elapsed() << " "
+	      << lastPerf.mbytesPerSecond << " MB/s" << std::endl;
+  }
 };
 
 NAMESPACE_END(Grid);
@@ -0,0 +1,293 @@
+/*************************************************************************************
+
+Grid physics library, www.github.com/paboyle/Grid
+
+Source file: ./lib/parallelIO/Hdf5ParallelIO.h
+
+Copyright (C) 2015 - 2020
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+See the full license in the file "LICENSE" in the top level distribution
+directory
+*************************************************************************************/
+/*  END LEGAL */
+#pragma once
+
+#if defined(H5_HAVE_PARALLEL) && defined(USE_MPI_IO)
+#define GRID_HDF5_PARALLEL
+#endif
+
+NAMESPACE_BEGIN(Grid);
+
+/////////////////////////////////////////////////////////////////////////////
+// Collective HDF5 output of distributed data, for lattice fields and large
+// tensors (meson fields, correlators) where Hdf5Writer would have the boss
+// write everything.
+//
+// Every dataset is one global array. Each rank selects its block as a
+// hyperslab and the blocks go out in one collective write through the MPI-IO
+// driver; the chunks of the dataset are the blocks, so no chunk is shared
+// between ranks. Lattice fields are [t][z][y][x][internal] in row major, the
+// global lexicographic order of BinaryIO, with the local volume as the chunk.
+// A tensor held on every rank (a meson field after its global sum) is split
+// along its longest dimension, each rank writing one slab straight from the
+// replicated array.
+//
+// Against a serial HDF5 library the ranks write their hyperslabs in turn, one
+// file open at a time, so the file is the same. The root carries Hdf5Writer's
+// dataset threshold attribute, so Hdf5Reader reads the files.
+//////////////////////////////////////////////////////////////////////////////////////
+class Hdf5ParallelWriter
+{
+public:
+  Hdf5ParallelWriter(GridBase *grid,const std::string &fileName)
+    : grid_(grid), fileName_(fileName)
+  {
+    const unsigned int thres = HDF5_DEF_DATASET_THRES;
+    hsize_t one = 1;
+#ifdef GRID_HDF5_PARALLEL
+    H5NS::FileAccPropList fapl;
+    H5Pset_fapl_mpio(fapl.getId(),grid_->communicator,MPI_INFO_NULL);
+    file_ = H5NS::H5File(fileName_.c_str(),H5F_ACC_TRUNC,H5NS::FileCreatPropList::DEFAULT,fapl);
+    H5NS::Group root = file_.openGroup("/");
+    root.createAttribute(HDF5_GRID_GUARD "dataset_threshold",Hdf5Type<unsigned int>::type(),
+			 H5NS::DataSpace(1,&one)).write(Hdf5Type<unsigned int>::type(),&thres);
+#else
+    if ( grid_->IsBoss() ) {
+      H5NS::H5File file(fileName_.c_str(),H5F_ACC_TRUNC);
+      H5NS::Group root = file.openGroup("/");
+      root.createAttribute(HDF5_GRID_GUARD "dataset_threshold",Hdf5Type<unsigned int>::type(),
+			   H5NS::DataSpace(1,&one)).write(Hdf5Type<unsigned int>::type(),&thres);
+    }
+    grid_->Barrier();
+#endif
+  }
+
+  // Collective; the field must live on the writer's ranks
+  template<class vobj>
+  void writeLattice(const std::string &s,const Lattice<vobj> &field)
+  {
+    typedef typename vobj::scalar_object sobj;
+    typedef typename sobj::scalar_type   scalar_type;
+
+    GridBase *grid = field.Grid();
+    assert(grid->ProcessorCount()==grid_->ProcessorCount());
+    int nd = grid->Nd();
+    Coordinate gdims = grid->GlobalDimensions();
+    Coordinate ldims = grid->LocalDimensions();
+    Coordinate pcoor = grid->ThisProcessorCoor();
+
+    std::vector<hsize_t> dims(nd+1), start(nd+1), count(nd+1);
+    for(int d=0;d<nd;d++){
+      dims [nd-1-d] = gdims[d];
+      count[nd-1-d] = ldims[d];
+      start[nd-1-d] = ldims[d]*pcoor[d];
+    }
+    dims[nd] = count[nd] = sizeof(sobj)/sizeof(scalar_type);
+    start[nd] = 0;
+
+    std::vector<sobj> scalardata(grid->lSites());
+    unvectorizeToLexOrdArray(scalardata,field);
+    writeBlock(s,dims,chunkDims<scalar_type>(count),start,count,
+	       count,std::vector<hsize_t>(nd+1,0),(scalar_type *)&scalardata[0]);
+  }
+
+  // Collective; the same row major array on every rank
+  template<typename U>
+  void writeMultiDim(const std::string &s,const std::vector<size_t> &Dimensions,const U *pDataRowMajor)
+  {
+    int rank = Dimensions.size();
+    std::vector<hsize_t> dims(Dimensions.begin(),Dimensions.end());
+    hsize_t elements = 1;
+    for(auto d : dims) elements *= d;
+
+    // Small arrays are attributes, as Hdf5Writer has them
+    if ( elements <= HDF5_DEF_DATASET_THRES ) {
+      H5NS::DataSpace space(rank,dims.data());
+#ifdef GRID_HDF5_PARALLEL
+      file_.openGroup("/").createAttribute(s,Hdf5Type<U>::type(),space).write(Hdf5Type<U>::type(),pDataRowMajor);
+#else
+      if ( grid_->IsBoss() ) {
+	H5NS::H5File file(fileName_.c_str(),H5F_ACC_RDWR);
+	file.openGroup("/").createAttribute(s,Hdf5Type<U>::type(),space).write(Hdf5Type<U>::type(),pDataRowMajor);
+      }
+      grid_->Barrier();
+#endif
+      return;
+    }
+
+    // Block distribution of the longest dimension
+    int nrank = grid_->ProcessorCount();
+    int me    = grid_->ThisRank();
+    int split = std::max_element(dims.begin(),dims.end())-dims.begin();
+    hsize_t block = (dims[split]+nrank-1)/nrank;
+    std::vector<hsize_t> start(rank,0), count(dims), chunk(dims);
+    start[split] = std::min(dims[split],me*block);
+    count[split] = std::min(dims[split],start[split]+block)-start[split];
+    chunk[split] = block;
+    writeBlock(s,dims,chunkDims<U>(chunk),start,count,dims,start,pDataRowMajor);
+  }
+
+private:
+  // HDF5 chunks are limited to 4GB
+  template<typename U>
+  static std::vector<hsize_t> chunkDims(std::vector<hsize_t> chunk)
+  {
+    const hsize_t MaxBytes = 0xffffffffULL;
+    for(auto &c : chunk) c = std::max(c,(hsize_t)1);
+    while ( true ) {
+      hsize_t bytes = sizeof(U);
+      for(auto c : chunk) bytes *= c;
+      if ( bytes <= MaxBytes ) break;
+      auto d = std::max_element(chunk.begin(),chunk.end());
+      *d = (*d+1)/2;
+    }
+    return chunk;
+  }
+
+  // Every rank writes the block [start,start+count) of dataset s from the block
+  // [mstart,mstart+count) of its row major array of extent mdims
+  template<typename U>
+  void writeBlock(const std::string &s,
+		  const std::vector<hsize_t> &dims,
+		  const std::vector<hsize_t> &chunk,
+		  const std::vector<hsize_t> &start,
+		  const std::vector<hsize_t> &count,
+		  const std::vector<hsize_t> &mdims,
+		  const std::vector<hsize_t> &mstart,
+		  const U *data)
+  {
+    int rank = dims.size();
+    hsize_t elements = 1;
+    for(auto c : count) elements *= c;
+
+    H5NS::DataSpace fileSpace(rank,dims.data());
+    H5NS::DataSpace memSpace (rank,mdims.data());
+    if ( elements ) {
+      fileSpace.selectHyperslab(H5S_SELECT_SET,count.data(),start.data());
+      memSpace.selectHyperslab (H5S_SELECT_SET,count.data(),mstart.data());
+    } else {
+      fileSpace.selectNone();
+      memSpace.selectNone();
+    }
+    H5NS::DSetCreatPropList plist;
+    plist.setChunk(rank,chunk.data());
+
+    GridStopWatch timer;
+    timer.Start();
+#ifdef GRID_HDF5_PARALLEL
+    H5NS::DataSet dataSet = file_.createDataSet(s,Hdf5Type<U>::type(),H5NS::DataSpace(rank,dims.data()),plist);
+    H5NS::DSetMemXferPropList xfer;
+    H5Pset_dxpl_mpio(xfer.getId(),H5FD_MPIO_COLLECTIVE);
+    dataSet.write(data,Hdf5Type<U>::type(),memSpace,fileSpace,xfer);
+#else
+    if ( grid_->IsBoss() ) {
+      H5NS::H5File file(fileName_.c_str(),H5F_ACC_RDWR);
+      file.createDataSet(s,Hdf5Type<U>::type(),H5NS::DataSpace(rank,dims.data()),plist);
+    }
+    grid_->Barrier();
+    for(int r=0;r<grid_->ProcessorCount();r++){
+      if ( r==grid_->ThisRank() && elements ) {
+	H5NS::H5File file(fileName_.c_str(),H5F_ACC_RDWR);
+	file.openDataSet(s).write(data,Hdf5Type<U>::type(),memSpace,fileSpace);
+      }
+      grid_->Barrier();
+    }
+#endif
+    timer.Stop();
+
+    uint64_t bytes = elements*sizeof(U);
+    grid_->GlobalSum(bytes);
+    std::cout << GridLogMessage << "Hdf5ParallelWriter: " << s << " " << bytes << " bytes in "
+	      << timer.Elapsed() << " " << bytes/1024./1024./(timer.useconds()/1.0e6) << " MB/s" << std::endl;
+  }
+
+private:
+  GridBase    *grid_;
+  std::string  fileName_;
+#ifdef GRID_HDF5_PARALLEL
+  H5NS::H5File file_;
+#endif
+};
+
+/////////////////////////////////////////////////////////////////////////////
+// Collective read of lattice fields written by Hdf5ParallelWriter, each rank
+// reading the hyperslab of its local volume.
+//////////////////////////////////////////////////////////////////////////////////////
+class Hdf5ParallelReader
+{
+public:
+  Hdf5ParallelReader(GridBase *grid,const std::string &fileName)
+    : grid_(grid)
+  {
+#ifdef GRID_HDF5_PARALLEL
+    H5NS::FileAccPropList fapl;
+    H5Pset_fapl_mpio(fapl.getId(),grid_->communicator,MPI_INFO_NULL);
+    file_ = H5NS::H5File(fileName.c_str(),H5F_ACC_RDONLY,H5NS::FileCreatPropList::DEFAULT,fapl);
+#else
+    file_ = H5NS::H5File(fileName.c_str(),H5F_ACC_RDONLY);
+#endif
+  }
+
+  template<class vobj>
+  void readLattice(const std::string &s,Lattice<vobj> &field)
+  {
+    typedef typename vobj::scalar_object sobj;
+    typedef typename sobj::scalar_type   scalar_type;
+
+    GridBase *grid = field.Grid();
+    int nd = grid->Nd();
+    Coordinate gdims = grid->GlobalDimensions();
+    Coordinate ldims = grid->LocalDimensions();
+    Coordinate pcoor = grid->ThisProcessorCoor();
+
+    H5NS::DataSet   dataSet   = file_.openDataSet(s);
+    H5NS::DataSpace fileSpace = dataSet.getSpace();
+    std::vector<hsize_t> dims(fileSpace.getSimpleExtentNdims());
+    fileSpace.getSimpleExtentDims(dims.data());
+    assert(dims.size()==nd+1);
+    assert(dims[nd]==sizeof(sobj)/sizeof(scalar_type));
+
+    std::vector<hsize_t> start(nd+1), count(nd+1);
+    for(int d=0;d<nd;d++){
+      assert(dims[nd-1-d]==gdims[d]);
+      count[nd-1-d] = ldims[d];
+      start[nd-1-d] = ldims[d]*pcoor[d];
+    }
+    count[nd] = dims[nd];
+    start[nd] = 0;
+    fileSpace.selectHyperslab(H5S_SELECT_SET,count.data(),start.data());
+    H5NS::DataSpace memSpace(nd+1,count.data());
+
+    std::vector<sobj> scalardata(grid->lSites());
+#ifdef GRID_HDF5_PARALLEL
+    H5NS::DSetMemXferPropList xfer;
+    H5Pset_dxpl_mpio(xfer.getId(),H5FD_MPIO_COLLECTIVE);
+    dataSet.read((scalar_type *)&scalardata[0],Hdf5Type<scalar_type>::type(),memSpace,fileSpace,xfer);
+#else
+    dataSet.read((scalar_type *)&scalardata[0],Hdf5Type<scalar_type>::type(),memSpace,fileSpace);
+#endif
+    vectorizeFromLexOrdArray(scalardata,field);
+  }
+
+private:
+  GridBase     *grid_;
+  H5NS::H5File  file_;
+};
+
+NAMESPACE_END(Grid);
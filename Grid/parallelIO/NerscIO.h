@@ -228,6 +228,31 @@ public:
 					std::string ens_label = std::string("DWF"),
 					std::string ens_id = std::string("UKQCD"),
 					unsigned int sequence_number = 1)
+  {
+    writeConfigurationStaged<GaugeStats>(nullptr,Umu,file,two_row,bits32,ens_label,ens_id,sequence_number);
+  }
+  // Header written now, data left in staged for BinaryIO::writeStagedObject
+  template<class GaugeStats=PeriodicGaugeStatistics>
+  static inline void stageConfiguration(BinaryIO::StagedObject &staged,
+					Lattice<vLorentzColourMatrixD > &Umu,
+					std::string file, 
+					int two_row,
+					int bits32,
+					std::string ens_label = std::string("DWF"),
+					std::string ens_id = std::string("UKQCD"),
+					unsigned int sequence_number = 1)
+  {
+    writeConfigurationStaged<GaugeStats>(&staged,Umu,file,two_row,bits32,ens_label,ens_id,sequence_number);
+  }
+  template<class GaugeStats>
+  static inline void writeConfigurationStaged(BinaryIO::StagedObject *staged,
+					      Lattice<vLorentzColourMatrixD > &Umu,
+					      std::string file, 
+					      int two_row,
+					      int bits32,
+					      std::string ens_label,
+					      std::string ens_id,
+					      unsigned int sequence_number)
   {
     typedef vLorentzColourMatrixD vobj;
     typedef typename vobj::scalar_object sobj;
@@ -267,19 +292,27 @@ public:
     uint32_t nersc_csum,scidac_csuma,scidac_csumb;
     if( two_row ) {
       Gauge3x2unmunger<fobj2D,sobj> munge;
-      BinaryIO::writeLatticeObject<vobj,fobj2D>(Umu,file,munge,offset,header.floating_point,
-						nersc_csum,scidac_csuma,scidac_csumb);
+      if ( staged ) 
+	BinaryIO::stageLatticeObject<vobj,fobj2D>(*staged,Umu,file,munge,offset,header.floating_point,
+						  nersc_csum,scidac_csuma,scidac_csumb);
+      else
+	BinaryIO::writeLatticeObject<vobj,fobj2D>(Umu,file,munge,offset,header.floating_point,
+						  nersc_csum,scidac_csuma,scidac_csumb);
     } else {
       GaugeSimpleUnmunger<fobj3D,sobj> munge;
-      BinaryIO::writeLatticeObject<vobj,fobj3D>(Umu,file,munge,offset,header.floating_point,
-						nersc_csum,scidac_csuma,scidac_csumb);
+      if ( staged ) 
+	BinaryIO::stageLatticeObject<vobj,fobj3D>(*staged,Umu,file,munge,offset,header.floating_point,
+						  nersc_csum,scidac_csuma,scidac_csumb);
+      else
+	BinaryIO::writeLatticeObject<vobj,fobj3D>(Umu,file,munge,offset,header.floating_point,
+						  nersc_csum,scidac_csuma,scidac_csumb);
     }
     header.checksum = nersc_csum;
     if ( grid->IsBoss() ) { 
       writeHeader(header,file);
     }
 
-    std::cout<<GridLogMessage <<"Written NERSC Configuration on "<< file << " checksum "
+    std::cout<<GridLogMessage <<(staged ? "Staged":"Written")<<" NERSC Configuration on "<< file << " checksum "
 	     <<std::hex<<header.checksum
 	     <<std::dec<<" plaq "<< header.plaquette <<std::endl;
 
@@ -288,6 +321,14 @@ public:
   // RNG state
   ///////////////////////////////
   static inline void writeRNGState(GridSerialRNG &serial,GridParallelRNG &parallel,std::string file)
+  {
+    writeRNGStateStaged(nullptr,serial,parallel,file);
+  }
+  static inline void stageRNGState(BinaryIO::StagedObject &staged,GridSerialRNG &serial,GridParallelRNG &parallel,std::string file)
+  {
+    writeRNGStateStaged(&staged,serial,parallel,file);
+  }
+  static inline void writeRNGStateStaged(BinaryIO::StagedObject *staged,GridSerialRNG &serial,GridParallelRNG &parallel,std::string file)
   {
     typedef typename GridParallelRNG::RngStateType RngStateType;
 
@@ -326,14 +367,15 @@ public:
 	grid->Broadcast(0,(void *)&offset,sizeof(offset));
 	
     uint32_t nersc_csum,scidac_csuma,scidac_csumb;
-    BinaryIO::writeRNG(serial,parallel,file,offset,nersc_csum,scidac_csuma,scidac_csumb);
+    if ( staged ) BinaryIO::stageRNG(*staged,serial,parallel,file,offset,nersc_csum,scidac_csuma,scidac_csumb);
+    else          BinaryIO::writeRNG(serial,parallel,file,offset,nersc_csum,scidac_csuma,scidac_csumb);
     header.checksum = nersc_csum;
 	if ( grid->IsBoss() ) { 
     offset = writeHeader(header,file);
 	}
 
     std::cout<<GridLogMessage 
-	     <<"Written NERSC RNG STATE "<<file<< " checksum "
+	     <<(staged ? "Staged":"Written")<<" NERSC RNG STATE "<<file<< " checksum "
 	     <<std::hex<<header.checksum
 	     <<std::dec<<std::endl;
 
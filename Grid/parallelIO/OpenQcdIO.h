@@ -42,6 +42,7 @@ struct OpenQcdHeader : Serializable {
 class OpenQcdIO : public BinaryIO {
 public:
   static constexpr double normalisationFactor = Nc; // normalisation difference: grid 18, openqcd 6
+  typedef iMatrix<ComplexD, Nc> LinkD;
 
   static inline int readHeader(std::string file, GridBase* grid, FieldMetaData& field) {
     OpenQcdHeader header;
@@ -80,11 +81,26 @@ public:
     return field.data_start;
   }
 
+  //////////////////////////////////////////////////////////////////////////////
+  // The file holds, for every odd site x (global x+y+z+t odd) in the order
+  // T X Y Z, with the z direction checkerboarded, the eight links
+  //
+  //   U_T(x), U_T(x-T), U_X(x), U_X(x-X), U_Y(x), U_Y(x-Y), U_Z(x), U_Z(x-Z)
+  //
+  // so every link appears once: at its lower end when that is odd, as the
+  // backward link of its upper end otherwise. The odd sites of the local volume
+  // are a block of the T X Y Z/2 ordering, moved with IOobject on a permuted
+  // grid. A backward link held by a rank belongs to the rank below only on the
+  // lower face of the local volume, so mapping between the file and Grid's
+  // layout needs just one face per direction exchanged with the neighbour.
+  //////////////////////////////////////////////////////////////////////////////
   template<class vsimd>
   static inline void readConfiguration(Lattice<iLorentzColourMatrix<vsimd>>& Umu,
                                        FieldMetaData&                        header,
                                        std::string                           file) {
-    typedef Lattice<iDoubleStoredColourMatrix<vsimd>> DoubleStoredGaugeField;
+    typedef typename iLorentzColourMatrix<vsimd>::scalar_object sobj;
+    typedef DoubleStoredColourMatrixD                            fobj;
+    typedef typename fobj::Realified::scalar_type                word;
 
     assert(Ns == 4 and Nd == 4 and Nc == 3);
 
@@ -98,58 +114,60 @@ public:
     std::string format("IEEE64"); // they always store little endian double precsision
     uint32_t    nersc_csum, scidac_csuma, scidac_csumb;
 
-    GridCartesian*         grid_openqcd = createOpenQcdGrid(grid);
-    GridRedBlackCartesian* grid_rb      = SpaceTimeGrid::makeFourDimRedBlackGrid(grid);
-
-    typedef DoubleStoredColourMatrixD                                              fobj;
-    typedef typename DoubleStoredGaugeField::vector_object::scalar_object          sobj;
-    typedef typename DoubleStoredGaugeField::vector_object::Realified::scalar_type word;
+    std::unique_ptr<GridCartesian> grid_openqcd(createOpenQcdGrid(grid));
 
     word w = 0;
 
     std::vector<fobj> iodata(grid_openqcd->lSites()); // Munge, checksum, byte order in here
-    std::vector<sobj> scalardata(grid->lSites());
 
-    IOobject(w, grid_openqcd, iodata, file, offset, format, BINARYIO_READ | BINARYIO_LEXICOGRAPHIC,
+    IOobject(w, grid_openqcd.get(), iodata, file, offset, format, BINARYIO_READ | BINARYIO_LEXICOGRAPHIC,
              nersc_csum, scidac_csuma, scidac_csumb);
 
     GridStopWatch timer;
     timer.Start();
 
-    DoubleStoredGaugeField Umu_ds(grid);
-
-    auto munge = GaugeDoubleStoredMunger<DoubleStoredColourMatrixD, DoubleStoredColourMatrix>();
-
+    // Backward links on the lower faces go down to the rank holding their site
     Coordinate ldim = grid->LocalDimensions();
-    thread_for(idx_g, grid->lSites(), {
+    std::vector<std::vector<int>>   halo_pos(Nd);
+    std::vector<std::vector<LinkD>> halo(Nd);
+    for(int mu_g = 0; mu_g < Nd; ++mu_g) {
+      int mu_o = (mu_g + 1) % Nd;
+      std::vector<int> send_sites = faceSites(grid, mu_g, 0, 1);
+      std::vector<int> recv_sites = faceSites(grid, mu_g, ldim[mu_g] - 1, 0);
+      std::vector<LinkD> send(send_sites.size());
+      thread_for(s, send_sites.size(), {
         Coordinate coor;
-        grid->LocalIndexToLocalCoor(idx_g, coor);
-
-        bool isOdd = grid_rb->CheckerBoard(coor) == Odd;
-
-        if(!isOdd) continue;
-
-        int idx_o = (coor[Tdir] * ldim[Xdir] * ldim[Ydir] * ldim[Zdir]
-                  +  coor[Xdir] * ldim[Ydir] * ldim[Zdir]
-                  +  coor[Ydir] * ldim[Zdir]
-                  +  coor[Zdir])/2;
-
-        munge(iodata[idx_o], scalardata[idx_g]);
-    });
-
-    grid->Barrier(); timer.Stop();
-    std::cout << Grid::GridLogMessage << "OpenQcdIO::readConfiguration: munge overhead " << timer.Elapsed() << std::endl;
-
-    timer.Reset(); timer.Start();
-
-    vectorizeFromLexOrdArray(scalardata, Umu_ds);
-
-    grid->Barrier(); timer.Stop();
-    std::cout << Grid::GridLogMessage << "OpenQcdIO::readConfiguration: vectorize overhead " << timer.Elapsed() << std::endl;
-
-    timer.Reset(); timer.Start();
+        grid->LocalIndexToLocalCoor(send_sites[s], coor);
+        send[s] = iodata[openQcdIndex(coor, ldim)](2 * mu_o + 1)();
+      });
+      exchangeFace(grid, mu_g, -1, send, halo[mu_g]);
+      halo_pos[mu_g] = facePositions(grid, mu_g, recv_sites);
+    }
 
-    undoDoubleStore(Umu, Umu_ds);
+    // One pass over the local sites into the vectorised field
+    {
+      autoView(Umu_v, Umu, CpuWrite);
+      thread_for(idx_g, grid->lSites(), {
+        Coordinate coor;
+        grid->LocalIndexToLocalCoor(idx_g, coor);
+        sobj site;
+        if(isOdd(grid, coor)) {
+          fobj &links = iodata[openQcdIndex(coor, ldim)];
+          for(int mu_g = 0; mu_g < Nd; ++mu_g) convertLink(site(mu_g)(), links(2 * ((mu_g + 1) % Nd))());
+        } else {
+          for(int mu_g = 0; mu_g < Nd; ++mu_g) {
+            int mu_o = (mu_g + 1) % Nd;
+            if(coor[mu_g] < ldim[mu_g] - 1) {
+              Coordinate up = coor; up[mu_g]++;
+              convertLink(site(mu_g)(), iodata[openQcdIndex(up, ldim)](2 * mu_o + 1)());
+            } else {
+              convertLink(site(mu_g)(), halo[mu_g][halo_pos[mu_g][faceIndex(coor, ldim, mu_g)]]);
+            }
+          }
+        }
+        pokeLocalSite(site, Umu_v, coor);
+      });
+    }
 
     grid->Barrier(); timer.Stop();
     std::cout << Grid::GridLogMessage << "OpenQcdIO::readConfiguration: redistribute overhead " << timer.Elapsed() << std::endl;
@@ -179,8 +197,99 @@ public:
   template<class vsimd>
   static inline void writeConfiguration(Lattice<iLorentzColourMatrix<vsimd>>& Umu,
                                         std::string                           file) {
-    std::cout << GridLogError << "Writing to openQCD file format is not implemented" << std::endl;
-    exit(EXIT_FAILURE);
+    typedef typename iLorentzColourMatrix<vsimd>::scalar_object sobj;
+    typedef DoubleStoredColourMatrixD                            fobj;
+    typedef typename fobj::Realified::scalar_type                word;
+
+    assert(Ns == 4 and Nd == 4 and Nc == 3);
+
+    auto grid = dynamic_cast<GridCartesian*>(Umu.Grid());
+    assert(grid != nullptr); assert(grid->_ndimension == Nd);
+
+    FieldMetaData meta;
+    PeriodicGaugeStatistics Stats; Stats(Umu, meta);
+
+    Coordinate gdim = grid->GlobalDimensions();
+    OpenQcdHeader header;
+    header.Nt   = gdim[Tdir];
+    header.Nx   = gdim[Xdir];
+    header.Ny   = gdim[Ydir];
+    header.Nz   = gdim[Zdir];
+    header.plaq = meta.plaquette * normalisationFactor;
+
+    uint64_t offset = sizeof(OpenQcdHeader);
+    if(grid->IsBoss()) {
+      std::ofstream fout(file, std::ios::out | std::ios::binary | std::ios::trunc);
+      fout.write(reinterpret_cast<char*>(&header), sizeof(OpenQcdHeader));
+      assert(!fout.fail());
+      fout.close();
+    }
+    grid->Barrier();
+
+    std::string format("IEEE64");
+    uint32_t    nersc_csum, scidac_csuma, scidac_csumb;
+
+    std::unique_ptr<GridCartesian> grid_openqcd(createOpenQcdGrid(grid));
+
+    word w = 0;
+
+    GridStopWatch timer;
+    timer.Start();
+
+    std::vector<fobj> iodata(grid_openqcd->lSites());
+    Coordinate ldim = grid->LocalDimensions();
+    {
+      autoView(Umu_v, Umu, CpuRead);
+
+      // Links on the upper faces go up to the rank storing them as backward links
+      std::vector<std::vector<int>>   halo_pos(Nd);
+      std::vector<std::vector<LinkD>> halo(Nd);
+      for(int mu_g = 0; mu_g < Nd; ++mu_g) {
+        std::vector<int> send_sites = faceSites(grid, mu_g, ldim[mu_g] - 1, 0);
+        std::vector<int> recv_sites = faceSites(grid, mu_g, 0, 1);
+        std::vector<LinkD> send(send_sites.size());
+        thread_for(s, send_sites.size(), {
+          Coordinate coor;
+          grid->LocalIndexToLocalCoor(send_sites[s], coor);
+          sobj site;
+          peekLocalSite(site, Umu_v, coor);
+          convertLink(send[s], site(mu_g)());
+        });
+        exchangeFace(grid, mu_g, +1, send, halo[mu_g]);
+        halo_pos[mu_g] = facePositions(grid, mu_g, recv_sites);
+      }
+
+      // One pass over the odd sites into file order
+      thread_for(idx_g, grid->lSites(), {
+        Coordinate coor;
+        grid->LocalIndexToLocalCoor(idx_g, coor);
+        if(isOdd(grid, coor)) {
+          fobj &links = iodata[openQcdIndex(coor, ldim)];
+          sobj site;
+          peekLocalSite(site, Umu_v, coor);
+          for(int mu_g = 0; mu_g < Nd; ++mu_g) {
+            int mu_o = (mu_g + 1) % Nd;
+            convertLink(links(2 * mu_o)(), site(mu_g)());
+            if(coor[mu_g] > 0) {
+              Coordinate down = coor; down[mu_g]--;
+              sobj below;
+              peekLocalSite(below, Umu_v, down);
+              convertLink(links(2 * mu_o + 1)(), below(mu_g)());
+            } else {
+              links(2 * mu_o + 1)() = halo[mu_g][halo_pos[mu_g][faceIndex(coor, ldim, mu_g)]];
+            }
+          }
+        }
+      });
+    }
+
+    grid->Barrier(); timer.Stop();
+    std::cout << Grid::GridLogMessage << "OpenQcdIO::writeConfiguration: redistribute overhead " << timer.Elapsed() << std::endl;
+
+    IOobject(w, grid_openqcd.get(), iodata, file, offset, format, BINARYIO_WRITE | BINARYIO_LEXICOGRAPHIC,
+             nersc_csum, scidac_csuma, scidac_csumb);
+
+    std::cout << GridLogMessage << "OpenQcd Configuration " << file << " plaquette " << meta.plaquette << " written" << std::endl;
   }
 
 private:
@@ -205,19 +314,80 @@ private:
     return ret;
   }
 
-  template<class vsimd>
-  static inline void undoDoubleStore(Lattice<iLorentzColourMatrix<vsimd>>&            Umu,
-                                     Lattice<iDoubleStoredColourMatrix<vsimd>> const& Umu_ds) {
-    conformable(Umu.Grid(), Umu_ds.Grid());
-    Lattice<iColourMatrix<vsimd>> U(Umu.Grid());
+  // Odd sites are the ones openqcd stores
+  static inline bool isOdd(GridBase* grid, const Coordinate& lcoor) {
+    int sum = 0;
+    for(int d = 0; d < Nd; d++) sum += lcoor[d] + grid->_processor_coor[d] * grid->_ldimensions[d];
+    return sum & 0x1;
+  }
 
-    // they store T+, T-, X+, X-, Y+, Y-, Z+, Z-
-    for(int mu_g = 0; mu_g < Nd; ++mu_g) {
-      int mu_o = (mu_g + 1) % Nd;
-      U        = PeekIndex<LorentzIndex>(Umu_ds, 2 * mu_o)
-               + Cshift(PeekIndex<LorentzIndex>(Umu_ds, 2 * mu_o + 1), mu_g, +1);
-      PokeIndex<LorentzIndex>(Umu, U, mu_g);
+  // Position of an odd local site in the local block of the file
+  static inline int openQcdIndex(const Coordinate& coor, const Coordinate& ldim) {
+    return (coor[Tdir] * ldim[Xdir] * ldim[Ydir] * ldim[Zdir]
+          + coor[Xdir] * ldim[Ydir] * ldim[Zdir]
+          + coor[Ydir] * ldim[Zdir]
+          + coor[Zdir]) / 2;
+  }
+
+  // Lexicographic index of a site within its face normal to mu
+  static inline int faceIndex(const Coordinate& coor, Coordinate fdim, int mu) {
+    Coordinate fcoor = coor;
+    fcoor[mu] = 0;
+    fdim[mu]  = 1;
+    int idx;
+    Lexicographic::IndexFromCoor(fcoor, idx, fdim);
+    return idx;
+  }
+
+  // Local sites with coor[mu] == slice and global parity 'parity', in face order;
+  // the faces of neighbouring ranks with opposite parity match site by site
+  static inline std::vector<int> faceSites(GridBase* grid, int mu, int slice, int parity) {
+    Coordinate fdim = grid->LocalDimensions();
+    fdim[mu] = 1;
+    int nface = grid->lSites() / grid->LocalDimensions()[mu];
+    std::vector<int> sites;
+    for(int f = 0; f < nface; f++) {
+      Coordinate coor;
+      Lexicographic::CoorFromIndex(coor, f, fdim);
+      coor[mu] = slice;
+      if(isOdd(grid, coor) == (parity == 1)) {
+        int idx;
+        Lexicographic::IndexFromCoor(coor, idx, grid->LocalDimensions());
+        sites.push_back(idx);
+      }
     }
+    return sites;
+  }
+
+  // Face index to position in the received face
+  static inline std::vector<int> facePositions(GridBase* grid, int mu, const std::vector<int>& sites) {
+    std::vector<int> pos(grid->lSites() / grid->LocalDimensions()[mu], -1);
+    for(int s = 0; s < sites.size(); s++) {
+      Coordinate coor;
+      grid->LocalIndexToLocalCoor(sites[s], coor);
+      pos[faceIndex(coor, grid->LocalDimensions(), mu)] = s;
+    }
+    return pos;
+  }
+
+  // The face sent one rank along mu in direction shift arrives from the other side
+  static inline void exchangeFace(GridCartesian* grid, int mu, int shift,
+                                  std::vector<LinkD>& send, std::vector<LinkD>& recv) {
+    recv.resize(send.size());
+    if(grid->_processors[mu] == 1) {
+      recv = send;
+      return;
+    }
+    int recv_from, xmit_to;
+    grid->ShiftedRanks(mu, shift, recv_from, xmit_to);
+    grid->SendToRecvFrom((void*)&send[0], xmit_to, (void*)&recv[0], recv_from, send.size() * sizeof(LinkD));
+  }
+
+  template<class out_t, class in_t>
+  static accelerator_inline void convertLink(out_t& out, const in_t& in) {
+    typedef typename out_t::scalar_type scalar_type;
+    for(int i = 0; i < Nc; i++)
+      for(int j = 0; j < Nc; j++) out(i, j) = scalar_type(in(i, j));
   }
 };
 
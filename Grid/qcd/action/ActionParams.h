@@ -53,6 +53,36 @@ struct WilsonImplParams {
   }
 };
 
+// Two row link storage: the third row is kappa * conj(row0 x row1), with
+// kappa fixed per direction in the bulk and on legs crossing the global boundary.
+// Filled in by CompressedLinkWilsonImpl::DoubleStore.
+struct CompressedLinkWilsonImplParams : public WilsonImplParams {
+  AcceleratorVector<Complex,Nds> link_kappa;
+  AcceleratorVector<Complex,Nds> link_kappa_wrap;
+  AcceleratorVector<int,Nds>     link_wrap;
+  CompressedLinkWilsonImplParams() : WilsonImplParams() { InitKappa(); };
+  CompressedLinkWilsonImplParams(const WilsonImplParams &p) : WilsonImplParams(p) { InitKappa(); };
+  CompressedLinkWilsonImplParams(const AcceleratorVector<Complex,Nd> phi) : WilsonImplParams(phi) { InitKappa(); };
+  void InitKappa(void) {
+    link_kappa.resize(Nds, 1.0);
+    link_kappa_wrap.resize(Nds, 1.0);
+    link_wrap.resize(Nds, 0);
+  }
+};
+
+// Momentum twist applied as a per leg phase in the hopping kernels instead of
+// being folded into the doubled links, so operators that differ only in their
+// twist can share one doubled gauge field. Filled in by TwistPhaseWilsonImpl.
+struct TwistPhaseWilsonImplParams : public WilsonImplParams {
+  AcceleratorVector<Complex,Nds> twist_phase;
+  TwistPhaseWilsonImplParams() : WilsonImplParams() { InitPhase(); };
+  TwistPhaseWilsonImplParams(const WilsonImplParams &p) : WilsonImplParams(p) { InitPhase(); };
+  TwistPhaseWilsonImplParams(const AcceleratorVector<Complex,Nd> phi) : WilsonImplParams(phi) { InitPhase(); };
+  void InitPhase(void) {
+    twist_phase.resize(Nds, 1.0);
+  }
+};
+
 struct StaggeredImplParams {
   StaggeredImplParams()  {};
 };
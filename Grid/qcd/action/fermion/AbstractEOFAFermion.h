@@ -75,6 +75,10 @@ public:
     this->DhopDerivEO(mat, U, V, dag);
   };
 
+  // Mooee and MooeeInv carry the EOFA shift; keep the unfused Schur chain
+  virtual void MpcFused   (const FermionField& in, FermionField& out){ this->MpcChain(in, out, DaggerNo);  };
+  virtual void MpcDagFused(const FermionField& in, FermionField& out){ this->MpcChain(in, out, DaggerYes); };
+
   // Recompute 5D coefficients for different value of shift constant
   // (needed for heatbath loop over poles)
   virtual void RefreshShiftCoefficients(RealD new_shift) = 0;
@@ -114,6 +114,21 @@ public:
   void   Meooe5D       (const FermionField &in, FermionField &out);
   void   MeooeDag5D    (const FermionField &in, FermionField &out);
 
+  ///////////////////////////////////////////////////////////////
+  // Schur diagonal Mooee preconditioned operator with the fifth
+  // dimension operators (Meooe5D, MooeeInv, Mooee) applied to each
+  // 4d site's column of Ls Dhop outputs while it is cache resident,
+  // in place of separate sweeps over the checkerboard.
+  // Same result as SchurDiagMooeeOperator::Mpc/MpcDag.
+  ///////////////////////////////////////////////////////////////
+  virtual void   MpcFused    (const FermionField &in, FermionField &out);
+  virtual void   MpcDagFused (const FermionField &in, FermionField &out);
+
+  void Meooe5DCoefficients   (Vector<Coeff_t> &lower,Vector<Coeff_t> &diag,Vector<Coeff_t> &upper);
+  void MeooeDag5DCoefficients(Vector<Coeff_t> &lower,Vector<Coeff_t> &diag,Vector<Coeff_t> &upper);
+  void MooeeCoefficients     (Vector<Coeff_t> &lower,Vector<Coeff_t> &diag,Vector<Coeff_t> &upper);
+  void MooeeDagCoefficients  (Vector<Coeff_t> &lower,Vector<Coeff_t> &diag,Vector<Coeff_t> &upper);
+
   //    protected:
   RealD mass_plus, mass_minus;
 
@@ -194,6 +209,18 @@ public:
   double MooeeInvTime;
 
 protected:
+  // Host MooeeInv/MooeeInvDag, one cache resident column of Ls half spinor sweeps per 4d site
+  void MooeeInvHost(const FermionField &psi, FermionField &chi,int dag);
+  void MooeeInvSweepCoefficients(int dag,Vector<Coeff_t> &fl,Vector<Coeff_t> &flm,Vector<Coeff_t> &dinv,
+				 Vector<Coeff_t> &bu,Vector<Coeff_t> &bum);
+
+  // Unfused Schur chain; fallback for accelerators and vectorised s
+  void MpcChain(const FermionField &in, FermionField &out,int dag);
+
+  // Halo exchange then Dhop (dag) column by column, op(sF,column) applied to each
+  template<class ColumnOp>
+  void DhopColumnFused(const FermionField &in, FermionField &out,int dag,ColumnOp op);
+
   virtual void SetCoefficientsZolotarev(RealD zolohi,Approx::zolotarev_data *zdata,RealD b,RealD c);
   virtual void SetCoefficientsTanh(Approx::zolotarev_data *zdata,RealD b,RealD c);
   virtual void SetCoefficientsInternal(RealD zolo_hi,Vector<Coeff_t> & gamma,RealD b,RealD c);
@@ -174,6 +174,12 @@ public:
 
   void MeeDeriv(GaugeField& mat, const FermionField& U, const FermionField& V, int dag) override;
 
+  // Schur Mpc = Mooee - Meooe MooeeInv Meooe with the clover (inverse) applied to each
+  // output site straight after its hopping term, see SchurDiagMooeeFusedOperator
+  void MpcFused(const FermionField& in, FermionField& out);
+
+  void MpcDagFused(const FermionField& in, FermionField& out);
+
   /////////////////////////////////////////////
   // Member functions (internals)
   /////////////////////////////////////////////
@@ -183,6 +189,11 @@ public:
                      const CloverDiagonalField& diagonal,
                      const CloverTriangleField& triangle);
 
+  void MpcFusedInternal(const FermionField& in, FermionField& out, int dag);
+
+  template<class SiteOp>
+  void DhopSiteFused(const FermionField& in, FermionField& out, int dag, SiteOp op);
+
   /////////////////////////////////////////////
   // Helpers
   /////////////////////////////////////////////
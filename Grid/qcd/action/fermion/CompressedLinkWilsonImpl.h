@@ -0,0 +1,376 @@
+/*************************************************************************************
+
+Grid physics library, www.github.com/paboyle/Grid
+
+Source file: ./lib/qcd/action/fermion/CompressedLinkWilsonImpl.h
+
+Copyright (C) 2015
+
+Author: Peter Boyle <pabobyle@ph.ed.ac.uk>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+See the full license in the file "LICENSE" in the top level distribution
+directory
+*************************************************************************************/
+			   /*  END LEGAL */
+#pragma once
+
+NAMESPACE_BEGIN(Grid);
+
+/////////////////////////////////////////////////////////////////////////////
+// Wilson fermions with the doubled gauge field stored as two rows per link.
+//
+// Every doubled link is lambda * V with V in SU(3) and lambda the -0.5 hopping
+// normalisation (times anisotropy, twist and boundary phase), so the third row
+// is recovered in register as
+//
+//    row2 = kappa * conj(row0 x row1) ,   kappa = lambda^3/|lambda|^4
+//
+// kappa is constant per direction in the bulk and takes a second value on legs
+// that cross the global boundary; both are measured from the gauge field in
+// DoubleStore and carried to the kernels in the stencil parameters.
+// 12 of 18 reals are streamed per link. Fundamental SU(3) only.
+/////////////////////////////////////////////////////////////////////////////
+template <class S, class Options = CoeffReal >
+class CompressedLinkWilsonImpl : public PeriodicGaugeImpl<GaugeImplTypes<S, FundamentalRepresentation::Dimension > > {
+public:
+
+  static const int Dimension = FundamentalRepresentation::Dimension;
+  static const bool isFundamental = true;
+  static const bool LsVectorised=false;
+  static const bool isGparity=false;
+  static const int Nhcs = Options::Nhcs;
+  static const int Nrows = Dimension-1;
+
+  static_assert(Dimension==3,"Two row link reconstruction is for SU(3)");
+
+  typedef PeriodicGaugeImpl<GaugeImplTypes<S, Dimension > > Gimpl;
+  INHERIT_GIMPL_TYPES(Gimpl);
+
+  typedef typename Options::_Coeff_t Coeff_t;
+  typedef typename Options::template PrecisionMapper<Simd>::LowerPrecVector SimdL;
+
+  template <typename vtype> using iImplSpinor            = iScalar<iVector<iVector<vtype, Dimension>, Ns> >;
+  template <typename vtype> using iImplPropagator        = iScalar<iMatrix<iMatrix<vtype, Dimension>, Ns> >;
+  template <typename vtype> using iImplHalfSpinor        = iScalar<iVector<iVector<vtype, Dimension>, Nhs> >;
+  template <typename vtype> using iImplHalfCommSpinor    = iScalar<iVector<iVector<vtype, Dimension>, Nhcs> >;
+  template <typename vtype> using iImplDoubledGaugeField = iVector<iScalar<iVector<iVector<vtype, Dimension>, Nrows> >, Nds>;
+  template <typename vtype> using iImplLink              = iScalar<iMatrix<vtype, Dimension> >;
+
+  typedef iImplSpinor<Simd>            SiteSpinor;
+  typedef iImplPropagator<Simd>        SitePropagator;
+  typedef iImplHalfSpinor<Simd>        SiteHalfSpinor;
+  typedef iImplHalfCommSpinor<SimdL>   SiteHalfCommSpinor;
+  typedef iImplDoubledGaugeField<Simd> SiteDoubledGaugeField;
+  typedef iImplLink<Simd>              SiteLink;
+
+  typedef Lattice<SiteSpinor>            FermionField;
+  typedef Lattice<SitePropagator>        PropagatorField;
+  typedef Lattice<SiteDoubledGaugeField> DoubledGaugeField;
+
+  // Full storage counterpart; builds the doubled field before compression
+  typedef WilsonImpl<S, FundamentalRepresentation, Options> FullImpl;
+  typedef typename FullImpl::DoubledGaugeField FullDoubledGaugeField;
+
+  typedef WilsonCompressor<SiteHalfCommSpinor,SiteHalfSpinor, SiteSpinor> Compressor;
+  typedef CompressedLinkWilsonImplParams ImplParams;
+  typedef WilsonStencil<SiteSpinor, SiteHalfSpinor,ImplParams> StencilImpl;
+  typedef const typename StencilImpl::View_type StencilView;
+
+  ImplParams Params;
+
+  CompressedLinkWilsonImpl(const ImplParams &p = ImplParams()) : Params(p){
+    assert(Params.boundary_phases.size() == Nd);
+  };
+
+  ////////////////////////////////////////////////////////////////////////
+  // Third row normalisation for leg mu. Only lanes whose neighbour lies
+  // across the global boundary take the boundary value; with the dimension
+  // split across SIMD lanes that is the outermost lane in that direction.
+  ////////////////////////////////////////////////////////////////////////
+  static accelerator_inline int linkLaneWraps(int mu,int lane,StencilView &St)
+  {
+    int direction = St._directions[mu];
+    int distance  = St._distances[mu];
+    int sl        = St._simd_layout[direction];
+    if ( sl == 1 ) return 1;
+    Coordinate icoor;
+    St.iCoorFromIindex(icoor,lane);
+    if ( distance > 0 ) return (icoor[direction]==sl-1);
+    return (icoor[direction]==0);
+  }
+  static accelerator_inline void linkKappa(Simd &kappa,int mu,StencilEntry *SE,StencilView &St)
+  {
+    typedef typename Simd::scalar_type scalar_type;
+    const int Nsimd = Simd::Nsimd();
+    Complex kb = St.parameters.link_kappa[mu];
+    vsplat(kappa,scalar_type(real(kb),imag(kb)));
+    if ( SE->_around_the_world && St.parameters.link_wrap[mu] ) {
+      Complex kw = St.parameters.link_kappa_wrap[mu];
+      for(int lane=0;lane<Nsimd;lane++){
+	if ( linkLaneWraps(mu,lane,St) ) kappa.putlane(scalar_type(real(kw),imag(kw)),lane);
+      }
+    }
+  }
+#ifdef GRID_SIMT
+  template<class _Scalar>
+  static accelerator_inline void linkKappa(_Scalar &kappa,int mu,StencilEntry *SE,StencilView &St)
+  {
+    const int Nsimd = Simd::Nsimd();
+    int lane = acceleratorSIMTlane(Nsimd);
+    Complex k = St.parameters.link_kappa[mu];
+    if ( SE->_around_the_world && St.parameters.link_wrap[mu] && linkLaneWraps(mu,lane,St) ) {
+      k = St.parameters.link_kappa_wrap[mu];
+    }
+    kappa = _Scalar(real(k),imag(k));
+  }
+#endif
+  template<class _Link,class _Simd>
+  static accelerator_inline void reconstructRow(_Link &W,const _Simd &kappa)
+  {
+    W()(2,0) = kappa*conjugate(W()(0,1)*W()(1,2)-W()(0,2)*W()(1,1));
+    W()(2,1) = kappa*conjugate(W()(0,2)*W()(1,0)-W()(0,0)*W()(1,2));
+    W()(2,2) = kappa*conjugate(W()(0,0)*W()(1,1)-W()(0,1)*W()(1,0));
+  }
+
+  // Full link for the hand unrolled kernels
+  static accelerator_inline SiteLink loadLink(const SiteDoubledGaugeField &U,int mu,StencilEntry *SE,StencilView &St)
+  {
+    SiteLink W;
+    Simd kappa;
+    for(int c=0;c<Dimension;c++){
+      W()(0,c) = U(mu)()(0)(c);
+      W()(1,c) = U(mu)()(1)(c);
+    }
+    linkKappa(kappa,mu,SE,St);
+    reconstructRow(W,kappa);
+    return W;
+  }
+
+  template<class _Spinor>
+  static accelerator_inline void multLink(_Spinor &phi,
+					  const SiteDoubledGaugeField &U,
+					  const _Spinor &chi,
+					  int mu,
+					  StencilEntry *SE,
+					  StencilView &St)
+  {
+    typedef decltype(coalescedRead(U(mu)()(0)(0))) calcSimd;
+    typedef decltype(coalescedRead(SiteLink()))    calcLink;
+    calcLink UU;
+    calcSimd kappa;
+    for(int c=0;c<Dimension;c++){
+      UU()(0,c) = coalescedRead(U(mu)()(0)(c));
+      UU()(1,c) = coalescedRead(U(mu)()(1)(c));
+    }
+    linkKappa(kappa,mu,SE,St);
+    reconstructRow(UU,kappa);
+    mult(&phi(), &UU, &chi());
+  }
+
+  ////////////////////////////////////////////////////////////////////////
+  // Field level expansion; used off the Dhop path only
+  ////////////////////////////////////////////////////////////////////////
+  inline void expandLink(GaugeLinkField &U,const DoubledGaugeField &Uds,int mu)
+  {
+    typedef typename Simd::scalar_type scalar_type;
+    typedef Lattice<iSinglet<Simd> > ComplexField;
+
+    GridBase *grid = Uds.Grid();
+    int dim  = mu % Nd;
+    int edge = (mu < Nd) ? grid->GlobalDimensions()[dim]-1 : 0;
+
+    Lattice<iScalar<vInteger> > coor(grid);
+    LatticeCoordinate(coor, dim);
+
+    Complex kb = Params.link_kappa[mu];
+    Complex kw = Params.link_kappa_wrap[mu];
+    ComplexField bulk(grid); bulk = scalar_type(real(kb),imag(kb));
+    ComplexField wrap(grid); wrap = scalar_type(real(kw),imag(kw));
+    ComplexField kappa(grid);
+    kappa = where(coor==edge, wrap, bulk);
+
+    U.Checkerboard() = Uds.Checkerboard();
+    autoView( U_v    , U    , AcceleratorWrite);
+    autoView( Uds_v  , Uds  , AcceleratorRead);
+    autoView( kappa_v, kappa, AcceleratorRead);
+    accelerator_for(ss,grid->oSites(),1,{
+      SiteLink W;
+      for(int c=0;c<Dimension;c++){
+	W()(0,c) = Uds_v[ss](mu)()(0)(c);
+	W()(1,c) = Uds_v[ss](mu)()(1)(c);
+      }
+      reconstructRow(W,kappa_v[ss]()()());
+      U_v[ss]() = W;
+    });
+  }
+
+  template<class _SpinorField>
+  inline void multLinkField(_SpinorField & out,
+			    const DoubledGaugeField &Umu,
+			    const _SpinorField & phi,
+			    int mu)
+  {
+    GaugeLinkField U(Umu.Grid());
+    expandLink(U,Umu,mu);
+    out = U*phi;
+  }
+
+  template <class ref>
+  static accelerator_inline void loadLinkElement(Simd &reg, ref &memory)
+  {
+    reg = memory;
+  }
+
+  inline void DoubleStore(GridBase *GaugeGrid,
+			  DoubledGaugeField &Uds,
+			  const GaugeField &Umu)
+  {
+    typedef Lattice<iSinglet<Simd> > ComplexField;
+
+    conformable(Uds.Grid(), GaugeGrid);
+    conformable(Umu.Grid(), GaugeGrid);
+
+    ////////////////////////////////////////////////////
+    // Full doubled field with phases and twists applied
+    ////////////////////////////////////////////////////
+    FullImpl Full(Params);
+    FullDoubledGaugeField Ufull(GaugeGrid);
+    Full.DoubleStore(GaugeGrid,Ufull,Umu);
+
+    ////////////////////////////////////////////////////
+    // Keep the first two rows
+    ////////////////////////////////////////////////////
+    {
+      autoView( Uds_v  , Uds  , AcceleratorWrite);
+      autoView( Ufull_v, Ufull, AcceleratorRead);
+      accelerator_for(ss,GaugeGrid->oSites(),1,{
+	for(int mu=0;mu<Nds;mu++){
+	  for(int r=0;r<Nrows;r++){
+	    for(int c=0;c<Dimension;c++){
+	      Uds_v[ss](mu)()(r)(c) = Ufull_v[ss](mu)()(r,c);
+	    }
+	  }
+	}
+      });
+    }
+
+    ////////////////////////////////////////////////////
+    // Measure kappa = row2 . (row0 x row1) / |row0 x row1|^2
+    // separately in the bulk and on the boundary slice,
+    // and check the links really are lambda * SU(3)
+    ////////////////////////////////////////////////////
+    Lattice<iScalar<vInteger> > coor(GaugeGrid);
+    ComplexField zz(GaugeGrid); zz = Zero();
+    for (int mu = 0; mu < Nds; mu++) {
+
+      int dim  = mu % Nd;
+      int edge = (mu < Nd) ? GaugeGrid->GlobalDimensions()[dim]-1 : 0;
+      LatticeCoordinate(coor, dim);
+
+      GaugeLinkField W = PeekIndex<LorentzIndex>(Ufull, mu);
+      auto e = [&](int i,int j) { return PeekIndex<ColourIndex>(W,i,j); };
+      ComplexField x0(GaugeGrid); x0 = e(0,1)*e(1,2)-e(0,2)*e(1,1);
+      ComplexField x1(GaugeGrid); x1 = e(0,2)*e(1,0)-e(0,0)*e(1,2);
+      ComplexField x2(GaugeGrid); x2 = e(0,0)*e(1,1)-e(0,1)*e(1,0);
+      ComplexField num(GaugeGrid); num = e(2,0)*x0 + e(2,1)*x1 + e(2,2)*x2;
+      ComplexField den(GaugeGrid); den = x0*conjugate(x0) + x1*conjugate(x1) + x2*conjugate(x2);
+
+      ComplexField tmp(GaugeGrid);
+      tmp = where(coor==edge, zz, num); auto num_b = TensorRemove(sum(tmp));
+      tmp = where(coor==edge, zz, den); auto den_b = TensorRemove(sum(tmp));
+      tmp = where(coor==edge, num, zz); auto num_w = TensorRemove(sum(tmp));
+      tmp = where(coor==edge, den, zz); auto den_w = TensorRemove(sum(tmp));
+
+      Complex kb = Complex(num_b)/Complex(den_b);
+      Complex kw = Complex(num_w)/Complex(den_w);
+
+      Params.link_kappa[mu]      = kb;
+      Params.link_kappa_wrap[mu] = kw;
+      Params.link_wrap[mu]       = (abs(kw-kb) > 1.0e-6*abs(kb)) ? 1 : 0;
+
+      typedef typename Simd::scalar_type scalar_type;
+      ComplexField kappa(GaugeGrid);
+      ComplexField bulk(GaugeGrid); bulk = scalar_type(real(kb),imag(kb));
+      ComplexField wrap(GaugeGrid); wrap = scalar_type(real(kw),imag(kw));
+      kappa = where(coor==edge, wrap, bulk);
+      tmp   = num - kappa*den;
+      RealD res = norm2(tmp);
+      RealD ref = norm2(num);
+      if ( res > 1.0e-8*ref ) {
+	std::cout << GridLogError << "CompressedLinkWilsonImpl: links in direction "<<mu
+		  << " are not a constant multiple of SU(3); residual "<< res/ref <<std::endl;
+	assert(0);
+      }
+    }
+  }
+
+  inline void InsertForce4D(GaugeField &mat, FermionField &Btilde, FermionField &A,int mu){
+    GaugeLinkField link(mat.Grid());
+    link = TraceIndex<SpinIndex>(outerProduct(Btilde,A));
+    PokeIndex<LorentzIndex>(mat,link,mu);
+  }
+
+  inline void outerProductImpl(PropagatorField &mat, const FermionField &B, const FermionField &A){
+    mat = outerProduct(B,A);
+  }
+
+  inline void TraceSpinImpl(GaugeLinkField &mat, PropagatorField&P) {
+    mat = TraceIndex<SpinIndex>(P);
+  }
+
+  inline void extractLinkField(std::vector<GaugeLinkField> &mat, DoubledGaugeField &Uds)
+  {
+    for (int mu = 0; mu < Nd; mu++)
+      expandLink(mat[mu],Uds,mu);
+  }
+
+  inline void InsertForce5D(GaugeField &mat, FermionField &Btilde, FermionField &Atilde,int mu)
+  {
+    int Ls=Btilde.Grid()->_fdimensions[0];
+    autoView( mat_v , mat, AcceleratorWrite);
+    {
+      const int Nsimd = SiteSpinor::Nsimd();
+      autoView( Btilde_v , Btilde, AcceleratorRead);
+      autoView( Atilde_v , Atilde, AcceleratorRead);
+      accelerator_for(sss,mat.Grid()->oSites(),Nsimd,{
+	  int sU=sss;
+  	  typedef decltype(coalescedRead(mat_v[sU](mu)() )) ColorMatrixType;
+  	  ColorMatrixType sum;
+	  zeroit(sum);
+	  for(int s=0;s<Ls;s++){
+	    int sF = s+Ls*sU;
+  	    for(int spn=0;spn<Ns;spn++){ //sum over spin
+  	      auto bb = coalescedRead(Btilde_v[sF]()(spn) ); //color vector
+  	      auto aa = coalescedRead(Atilde_v[sF]()(spn) );
+	      auto op = outerProduct(bb,aa);
+  	      sum = sum + op;
+	    }
+	  }
+  	  coalescedWrite(mat_v[sU](mu)(), sum);
+      });
+    }
+  }
+};
+
+template <class S, class Options>
+struct ImplParamsFromLinks<CompressedLinkWilsonImpl<S,Options> > : public std::true_type {};
+
+typedef CompressedLinkWilsonImpl<vComplex,  CoeffReal > CompressedLinkWilsonImplR;  // Real.. whichever prec
+typedef CompressedLinkWilsonImpl<vComplexF, CoeffReal > CompressedLinkWilsonImplF;  // Float
+typedef CompressedLinkWilsonImpl<vComplexD, CoeffReal > CompressedLinkWilsonImplD;  // Double
+
+NAMESPACE_END(Grid);
@@ -0,0 +1,140 @@
+/*************************************************************************************
+
+Grid physics library, www.github.com/paboyle/Grid
+
+Source file: ./lib/qcd/action/fermion/DslashTuner.cc
+
+Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+See the full license in the file "LICENSE" in the top level distribution
+directory
+*************************************************************************************/
+/*  END LEGAL */
+#include <Grid/qcd/action/fermion/FermionCore.h>
+#include <unistd.h>
+#include <fstream>
+#include <map>
+
+NAMESPACE_BEGIN(Grid);
+
+int         DslashTuner::Enabled   = 0;
+std::string DslashTuner::CacheFile("grid_dslash_tune.txt");
+int         DslashTuner::Nwarm     = 2;
+int         DslashTuner::Ncall     = 10;
+
+// Decisions made or read in this run
+static std::map<std::string,DslashTuning> DslashTunerDecisions;
+static int DslashTunerFileRead = 0;
+
+std::string DslashTuner::OptName(int opt)
+{
+  switch(opt){
+  case WilsonKernelsStatic::OptGeneric:    return std::string("generic");
+  case WilsonKernelsStatic::OptHandUnroll: return std::string("unroll");
+  case WilsonKernelsStatic::OptInlineAsm:  return std::string("asm");
+  }
+  return std::string("default");
+}
+std::string DslashTuner::CommsName(int comms)
+{
+  switch(comms){
+  case WilsonKernelsStatic::CommsAndCompute:  return std::string("overlap");
+  case WilsonKernelsStatic::CommsThenCompute: return std::string("sequential");
+  }
+  return std::string("default");
+}
+
+// n.m.o.p as on the command line
+static std::string DslashTunerDims(const Coordinate &c)
+{
+  std::stringstream ss;
+  for(int d=0;d<c.size();d++) ss << (d ? "." : "") << c[d];
+  return ss.str();
+}
+
+std::string DslashTuner::Key(const std::string &op,GridBase *grid,int Ls,int prec)
+{
+  char host[256];
+  host[0]='\0';
+  gethostname(host,sizeof(host)-1);
+  host[sizeof(host)-1]='\0';
+
+  std::stringstream ss;
+  ss << host
+     << ":" << op
+     << ":L" << DslashTunerDims(grid->LocalDimensions())
+     << ":Ls" << Ls
+     << ":P" << prec
+     << ":mpi" << DslashTunerDims(grid->ProcessorGrid())
+     << ":omp" << GridThread::GetThreads();
+  return ss.str();
+}
+
+////////////////////////////////////////////////////////////////////////////
+// The cache file is read and written by rank 0 only; the decision is
+// broadcast so that every rank runs the same kernel and comms mode.
+// One line per key:  key opt comms usec
+////////////////////////////////////////////////////////////////////////////
+bool DslashTuner::Lookup(GridBase *grid,const std::string &key,DslashTuning &t)
+{
+  if ( !DslashTunerFileRead ) {
+    if ( grid->IsBoss() ) {
+      std::ifstream fin(CacheFile);
+      std::string k;
+      DslashTuning d;
+      double usec;
+      while ( fin >> k >> d.Opt >> d.Comms >> usec ) {
+	DslashTunerDecisions[k] = d;   // later lines supersede earlier ones
+      }
+    }
+    DslashTunerFileRead = 1;
+  }
+
+  int found[3] = {0,-1,-1};
+  if ( grid->IsBoss() ) {
+    auto it = DslashTunerDecisions.find(key);
+    if ( it != DslashTunerDecisions.end() ) {
+      found[0] = 1;
+      found[1] = it->second.Opt;
+      found[2] = it->second.Comms;
+    }
+  }
+  grid->Broadcast(grid->BossRank(),(void *)found,sizeof(found));
+  if ( found[0] ) {
+    t.Opt   = found[1];
+    t.Comms = found[2];
+    DslashTunerDecisions[key] = t;
+  }
+  return found[0];
+}
+
+void DslashTuner::Record(GridBase *grid,const std::string &key,const DslashTuning &t,double usec)
+{
+  DslashTunerDecisions[key] = t;
+  if ( grid->IsBoss() ) {
+    std::ofstream fout(CacheFile,std::ios::app);
+    if ( fout ) {
+      fout << key << " " << t.Opt << " " << t.Comms << " " << usec << std::endl;
+    } else {
+      std::cout << GridLogWarning << "DslashTuner: could not write "<<CacheFile<<std::endl;
+    }
+  }
+}
+
+NAMESPACE_END(Grid);
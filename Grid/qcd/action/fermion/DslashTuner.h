@@ -0,0 +1,151 @@
+/*************************************************************************************
+
+Grid physics library, www.github.com/paboyle/Grid
+
+Source file: ./lib/qcd/action/fermion/DslashTuner.h
+
+Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+See the full license in the file "LICENSE" in the top level distribution
+directory
+*************************************************************************************/
+/*  END LEGAL */
+#pragma once
+
+#include <typeinfo>
+
+NAMESPACE_BEGIN(Grid);
+
+////////////////////////////////////////////////////////////////////////////
+// Runtime selection of the Wilson kernel variant and comms mode.
+//
+// With --dslash-autotune each Wilson type operator times the candidate
+// WilsonKernelsStatic::Opt x WilsonKernelsStatic::Comms combinations on
+// DhopOE when it is constructed, keeps the fastest for its own Dhop calls
+// and records it in a cache file (--dslash-tune-cache, default
+// grid_dslash_tune.txt) keyed by host, operator, local volume, Ls,
+// precision, decomposition and thread count. Later constructions with the
+// same key, in this run or a later one, reuse the decision without timing.
+////////////////////////////////////////////////////////////////////////////
+
+// -1 leaves the command line choice in force
+struct DslashTuning {
+  int Opt;
+  int Comms;
+  DslashTuning() : Opt(-1), Comms(-1) {};
+};
+
+// Impls with an assembler kernel in this build
+template<class Impl> struct DslashAsmAvailable { static const bool value = false; };
+#if defined(AVX512) || defined(A64FX) || defined(A64FXFIXEDSIZE) || defined(QPX)
+template<> struct DslashAsmAvailable<WilsonImplF>  { static const bool value = true; };
+template<> struct DslashAsmAvailable<WilsonImplD>  { static const bool value = true; };
+#if !defined(QPX)
+template<> struct DslashAsmAvailable<ZWilsonImplF> { static const bool value = true; };
+template<> struct DslashAsmAvailable<ZWilsonImplD> { static const bool value = true; };
+#endif
+#endif
+
+class DslashTuner {
+public:
+  static int         Enabled;
+  static std::string CacheFile;
+  static int         Nwarm;
+  static int         Ncall;
+
+  // Installs an operator's choice in WilsonKernelsStatic for the duration of one Dhop
+  class Scope {
+    int opt;
+    int comms;
+  public:
+    Scope(const DslashTuning &t) : opt(WilsonKernelsStatic::Opt), comms(WilsonKernelsStatic::Comms) {
+      if ( t.Opt   >= 0 ) WilsonKernelsStatic::Opt   = t.Opt;
+      if ( t.Comms >= 0 ) WilsonKernelsStatic::Comms = t.Comms;
+    }
+    ~Scope() {
+      WilsonKernelsStatic::Opt   = opt;
+      WilsonKernelsStatic::Comms = comms;
+    }
+  };
+
+  static std::string Key(const std::string &op,GridBase *grid,int Ls,int prec);
+  static bool        Lookup(GridBase *grid,const std::string &key,DslashTuning &t);
+  static void        Record(GridBase *grid,const std::string &key,const DslashTuning &t,double usec);
+  static std::string OptName(int opt);
+  static std::string CommsName(int comms);
+
+  template<class Operator>
+  static void Tune(Operator &Op,DslashTuning &tuning,int Ls)
+  {
+    typedef typename Operator::FermionField FermionField;
+    typedef typename Operator::Impl_t       Impl;
+    typedef typename getPrecision<typename FermionField::scalar_object>::real_scalar_type Word;
+
+    GridBase *FGrid   = Op.FermionGrid();
+    GridBase *FrbGrid = Op.FermionRedBlackGrid();
+
+    std::string key = Key(typeid(Operator).name(),Op.GaugeGrid(),Ls,sizeof(Word));
+    if ( Lookup(FGrid,key,tuning) ) {
+      std::cout << GridLogMessage << "DslashTuner: cached "<<OptName(tuning.Opt)<<" / "<<CommsName(tuning.Comms)<<std::endl;
+      return;
+    }
+
+    std::vector<int> opts({WilsonKernelsStatic::OptGeneric});
+    if ( Impl::Dimension == 3 )            opts.push_back(WilsonKernelsStatic::OptHandUnroll);
+    if ( DslashAsmAvailable<Impl>::value ) opts.push_back(WilsonKernelsStatic::OptInlineAsm);
+    std::vector<int> comms({WilsonKernelsStatic::CommsThenCompute});
+#ifdef GRID_OMP
+    comms.push_back(WilsonKernelsStatic::CommsAndCompute);
+#endif
+
+    GridParallelRNG RNG(FGrid);
+    RNG.SeedFixedIntegers(std::vector<int>({1,2,3,4}));
+    FermionField src(FGrid); gaussian(RNG,src);
+    FermionField in (FrbGrid);
+    FermionField out(FrbGrid);
+    pickCheckerboard(Even,in,src);
+
+    DslashTuning best;
+    double       best_usec = -1.0;
+    for(auto opt : opts){
+      for(auto comm : comms){
+	tuning.Opt   = opt;
+	tuning.Comms = comm;
+	for(int i=0;i<Nwarm;i++) Op.DhopOE(in,out,DaggerNo);
+	FGrid->Barrier();
+	double t0 = usecond();
+	for(int i=0;i<Ncall;i++) Op.DhopOE(in,out,DaggerNo);
+	FGrid->Barrier();
+	double usec = (usecond()-t0)/Ncall;
+	FGrid->GlobalMax(usec);
+	std::cout << GridLogMessage << "DslashTuner: "<<OptName(opt)<<" / "<<CommsName(comm)<<" "<<usec<<" us"<<std::endl;
+	if ( (best_usec < 0.0) || (usec < best_usec) ) {
+	  best      = tuning;
+	  best_usec = usec;
+	}
+      }
+    }
+    tuning = best;
+    std::cout << GridLogMessage << "DslashTuner: selected "<<OptName(best.Opt)<<" / "<<CommsName(best.Comms)<<std::endl;
+    Record(FGrid,key,tuning,best_usec);
+    Op.ZeroCounters();
+  }
+};
+
+NAMESPACE_END(Grid);
@@ -71,6 +71,9 @@ NAMESPACE_CHECK(Staggered);
 #include <Grid/qcd/action/fermion/ZMobiusFermion.h>
 NAMESPACE_CHECK(DomainWall);
 
+#include <Grid/qcd/action/fermion/TwistPhaseFermion.h> // twisted views sharing one gauge field
+NAMESPACE_CHECK(TwistPhase);
+
 #include <Grid/qcd/action/fermion/ScaledShamirFermion.h>
 #include <Grid/qcd/action/fermion/MobiusZolotarevFermion.h>
 #include <Grid/qcd/action/fermion/ShamirZolotarevFermion.h>
@@ -311,6 +314,34 @@ typedef MobiusEOFAFermion<GparityWilsonImplD> GparityMobiusEOFAFermionD;
 //typedef MobiusEOFAFermion<GparityWilsonImplFH> GparityMobiusEOFAFermionFH;
 //typedef MobiusEOFAFermion<GparityWilsonImplDF> GparityMobiusEOFAFermionDF;
 
+#ifdef ENABLE_COMPRESSED_LINKS
+// Two row compressed gauge links
+typedef WilsonFermion<CompressedLinkWilsonImplR> CompressedLinkWilsonFermionR;
+typedef WilsonFermion<CompressedLinkWilsonImplF> CompressedLinkWilsonFermionF;
+typedef WilsonFermion<CompressedLinkWilsonImplD> CompressedLinkWilsonFermionD;
+
+typedef DomainWallFermion<CompressedLinkWilsonImplR> CompressedLinkDomainWallFermionR;
+typedef DomainWallFermion<CompressedLinkWilsonImplF> CompressedLinkDomainWallFermionF;
+typedef DomainWallFermion<CompressedLinkWilsonImplD> CompressedLinkDomainWallFermionD;
+
+typedef MobiusFermion<CompressedLinkWilsonImplR> CompressedLinkMobiusFermionR;
+typedef MobiusFermion<CompressedLinkWilsonImplF> CompressedLinkMobiusFermionF;
+typedef MobiusFermion<CompressedLinkWilsonImplD> CompressedLinkMobiusFermionD;
+#endif
+
+// Momentum twist applied in the kernels
+typedef WilsonFermion<TwistPhaseWilsonImplR> TwistPhaseWilsonFermionR;
+typedef WilsonFermion<TwistPhaseWilsonImplF> TwistPhaseWilsonFermionF;
+typedef WilsonFermion<TwistPhaseWilsonImplD> TwistPhaseWilsonFermionD;
+
+typedef DomainWallFermion<TwistPhaseWilsonImplR> TwistPhaseDomainWallFermionR;
+typedef DomainWallFermion<TwistPhaseWilsonImplF> TwistPhaseDomainWallFermionF;
+typedef DomainWallFermion<TwistPhaseWilsonImplD> TwistPhaseDomainWallFermionD;
+
+typedef MobiusFermion<TwistPhaseWilsonImplR> TwistPhaseMobiusFermionR;
+typedef MobiusFermion<TwistPhaseWilsonImplF> TwistPhaseMobiusFermionF;
+typedef MobiusFermion<TwistPhaseWilsonImplD> TwistPhaseMobiusFermionD;
+
 typedef ImprovedStaggeredFermion<StaggeredImplR> ImprovedStaggeredFermionR;
 typedef ImprovedStaggeredFermion<StaggeredImplF> ImprovedStaggeredFermionF;
 typedef ImprovedStaggeredFermion<StaggeredImplD> ImprovedStaggeredFermionD;
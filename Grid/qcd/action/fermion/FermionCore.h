@@ -44,5 +44,7 @@ NAMESPACE_CHECK(FermionOperator);
 #include <Grid/qcd/action/fermion/WilsonKernels.h>        //used by all wilson type fermions
 #include <Grid/qcd/action/fermion/StaggeredKernels.h>        //used by all wilson type fermions
 NAMESPACE_CHECK(Kernels);
+#include <Grid/qcd/action/fermion/DslashTuner.h>          //runtime kernel and comms selection
+NAMESPACE_CHECK(DslashTuner);
 
 #endif
@@ -160,6 +160,12 @@ public:
   INHERIT_GIMPL_TYPES(Base)			\
   INHERIT_FIMPL_TYPES(Base)
 
+////////////////////////////////////////////////////////////////////////
+// Impls whose DoubleStore derives ImplParams from the gauge field; the
+// operators then refresh the stencils' copy of the parameters on ImportGauge
+////////////////////////////////////////////////////////////////////////
+template<class Impl> struct ImplParamsFromLinks : public std::false_type {};
+
 NAMESPACE_END(Grid);
 NAMESPACE_CHECK(ImplBase);  
 /////////////////////////////////////////////////////////////////////////////
@@ -174,6 +180,20 @@ NAMESPACE_CHECK(ImplWilson);
 #include <Grid/qcd/action/fermion/GparityWilsonImpl.h> 
 NAMESPACE_CHECK(ImplGparityWilson);  
 
+/////////////////////////////////////////////////////////////////////////////
+// Single flavour, two row compressed gauge links
+/////////////////////////////////////////////////////////////////////////////
+#ifdef ENABLE_COMPRESSED_LINKS
+#include <Grid/qcd/action/fermion/CompressedLinkWilsonImpl.h> 
+NAMESPACE_CHECK(ImplCompressedLinkWilson);  
+#endif
+
+/////////////////////////////////////////////////////////////////////////////
+// Single flavour, momentum twist applied as a phase in the kernels
+/////////////////////////////////////////////////////////////////////////////
+#include <Grid/qcd/action/fermion/TwistPhaseWilsonImpl.h> 
+NAMESPACE_CHECK(ImplTwistPhaseWilson);  
+
 /////////////////////////////////////////////////////////////////////////////
 // Single flavour one component spinors with colour index
 /////////////////////////////////////////////////////////////////////////////
@@ -35,7 +35,7 @@ NAMESPACE_BEGIN(Grid)
   ////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 class StaggeredKernelsStatic { 
  public:
-  enum { OptGeneric, OptHandUnroll, OptInlineAsm };
+  enum { OptGeneric, OptHandUnroll, OptInlineAsm, OptFused };
   enum { CommsAndCompute, CommsThenCompute };
   static int Opt;
   static int Comms;
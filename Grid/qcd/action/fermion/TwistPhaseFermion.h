@@ -0,0 +1,160 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./lib/qcd/action/fermion/TwistPhaseFermion.h
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <pabobyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+*************************************************************************************/
+/*  END LEGAL */
+#pragma once
+
+NAMESPACE_BEGIN(Grid);
+
+////////////////////////////////////////////////////////////////////////////////
+// A twisted view of an existing TwistPhaseWilsonImpl operator (WilsonFermion,
+// DomainWall, Mobius, ...). The doubled gauge field, stencils and comms buffers
+// belong to the wrapped operator; this operator owns only its twist, which is
+// bound into the wrapped operator's stencil parameters for the duration of each
+// call. A scan over twist angles then costs one gauge import in total:
+//
+//   TwistPhaseMobiusFermionD Dm(Umu,...);
+//   TwistPhaseFermion<TwistPhaseMobiusFermionD> Dk(Dm,twist);
+//
+// ImportGauge on any of them updates the field seen by all.
+////////////////////////////////////////////////////////////////////////////////
+template<class Operator>
+class TwistPhaseFermion : public FermionOperator<typename Operator::Impl_t>
+{
+public:
+  typedef typename Operator::Impl_t Impl;
+  INHERIT_IMPL_TYPES(Impl);
+
+  Operator &_Op;
+
+  TwistPhaseFermion(Operator &Op,const std::vector<RealD> &twist)
+    : FermionOperator<Impl>(Op.Params), _Op(Op)
+  {
+    SetTwist(twist);
+  }
+
+  // Twist in units of 2 pi / L_mu, as WilsonImplParams::twist_n_2pi_L
+  void SetTwist(const std::vector<RealD> &twist)
+  {
+    assert(twist.size()==Nd);
+    for(int mu=0;mu<Nd;mu++) this->Params.twist_n_2pi_L[mu] = twist[mu];
+    Impl::SetTwistPhase(_Op.GaugeGrid(),this->Params);
+  }
+
+private:
+  void Bind(const ImplParams &p)
+  {
+    _Op.Params = p;
+    _Op.Stencil.parameters = _Op.StencilEven.parameters = _Op.StencilOdd.parameters = p;
+  }
+  // Run with this twist, leaving the wrapped operator's own twist in place afterwards
+  template<class Call> void Twisted(const Call &call)
+  {
+    ImplParams save = _Op.Params;
+    Bind(this->Params);
+    call();
+    Bind(save);
+  }
+
+public:
+  FermionField &tmp(void) { return _Op.tmp(); }
+
+  GridBase *FermionGrid(void)         { return _Op.FermionGrid(); }
+  GridBase *FermionRedBlackGrid(void) { return _Op.FermionRedBlackGrid(); }
+  GridBase *GaugeGrid(void)           { return _Op.GaugeGrid(); }
+  GridBase *GaugeRedBlackGrid(void)   { return _Op.GaugeRedBlackGrid(); }
+
+  RealD Mass(void)        { return _Op.Mass(); }
+  int   ConstEE(void)     { return _Op.ConstEE(); }
+  int   isTrivialEE(void) { return _Op.isTrivialEE(); }
+
+  void M    (const FermionField &in, FermionField &out) { Twisted([&]{ _Op.M(in,out);    }); }
+  void Mdag (const FermionField &in, FermionField &out) { Twisted([&]{ _Op.Mdag(in,out); }); }
+  void Mdiag(const FermionField &in, FermionField &out) { Twisted([&]{ _Op.Mdiag(in,out);}); }
+
+  void Meooe      (const FermionField &in, FermionField &out) { Twisted([&]{ _Op.Meooe(in,out);      }); }
+  void MeooeDag   (const FermionField &in, FermionField &out) { Twisted([&]{ _Op.MeooeDag(in,out);   }); }
+  void Mooee      (const FermionField &in, FermionField &out) { Twisted([&]{ _Op.Mooee(in,out);      }); }
+  void MooeeDag   (const FermionField &in, FermionField &out) { Twisted([&]{ _Op.MooeeDag(in,out);   }); }
+  void MooeeInv   (const FermionField &in, FermionField &out) { Twisted([&]{ _Op.MooeeInv(in,out);   }); }
+  void MooeeInvDag(const FermionField &in, FermionField &out) { Twisted([&]{ _Op.MooeeInvDag(in,out);}); }
+
+  void Dhop   (const FermionField &in, FermionField &out,int dag)         { Twisted([&]{ _Op.Dhop(in,out,dag);   }); }
+  void DhopOE (const FermionField &in, FermionField &out,int dag)         { Twisted([&]{ _Op.DhopOE(in,out,dag); }); }
+  void DhopEO (const FermionField &in, FermionField &out,int dag)         { Twisted([&]{ _Op.DhopEO(in,out,dag); }); }
+  void DhopDir(const FermionField &in, FermionField &out,int dir,int disp){ Twisted([&]{ _Op.DhopDir(in,out,dir,disp); }); }
+  void Mdir   (const FermionField &in, FermionField &out,int dir,int disp){ Twisted([&]{ _Op.Mdir(in,out,dir,disp);    }); }
+  void MdirAll(const FermionField &in, std::vector<FermionField> &out)    { Twisted([&]{ _Op.MdirAll(in,out);         }); }
+
+  void MDeriv  (GaugeField &mat,const FermionField &U,const FermionField &V,int dag) { Twisted([&]{ _Op.MDeriv(mat,U,V,dag);   }); }
+  void MoeDeriv(GaugeField &mat,const FermionField &U,const FermionField &V,int dag) { Twisted([&]{ _Op.MoeDeriv(mat,U,V,dag); }); }
+  void MeoDeriv(GaugeField &mat,const FermionField &U,const FermionField &V,int dag) { Twisted([&]{ _Op.MeoDeriv(mat,U,V,dag); }); }
+  void MooDeriv(GaugeField &mat,const FermionField &U,const FermionField &V,int dag) { Twisted([&]{ _Op.MooDeriv(mat,U,V,dag); }); }
+  void MeeDeriv(GaugeField &mat,const FermionField &U,const FermionField &V,int dag) { Twisted([&]{ _Op.MeeDeriv(mat,U,V,dag); }); }
+
+  void DhopDeriv  (GaugeField &mat,const FermionField &U,const FermionField &V,int dag) { Twisted([&]{ _Op.DhopDeriv(mat,U,V,dag);   }); }
+  void DhopDerivEO(GaugeField &mat,const FermionField &U,const FermionField &V,int dag) { Twisted([&]{ _Op.DhopDerivEO(mat,U,V,dag); }); }
+  void DhopDerivOE(GaugeField &mat,const FermionField &U,const FermionField &V,int dag) { Twisted([&]{ _Op.DhopDerivOE(mat,U,V,dag); }); }
+
+  void MomentumSpacePropagator(FermionField &out,const FermionField &in,RealD _m,std::vector<double> twist)
+  {
+    _Op.MomentumSpacePropagator(out,in,_m,twist);
+  }
+
+  void ImportGauge(const GaugeField &_U) { Twisted([&]{ _Op.ImportGauge(_U); }); }
+
+  void ContractConservedCurrent(PropagatorField &q_in_1,
+				PropagatorField &q_in_2,
+				PropagatorField &q_out,
+				PropagatorField &phys_src,
+				Current curr_type,
+				unsigned int mu)
+  {
+    Twisted([&]{ _Op.ContractConservedCurrent(q_in_1,q_in_2,q_out,phys_src,curr_type,mu); });
+  }
+  void SeqConservedCurrent(PropagatorField &q_in,
+			   PropagatorField &q_out,
+			   PropagatorField &phys_src,
+			   Current curr_type,
+			   unsigned int mu,
+			   unsigned int tmin,
+			   unsigned int tmax,
+			   ComplexField &lattice_cmplx)
+  {
+    Twisted([&]{ _Op.SeqConservedCurrent(q_in,q_out,phys_src,curr_type,mu,tmin,tmax,lattice_cmplx); });
+  }
+  void ContractJ5q(FermionField &q_in   ,ComplexField &J5q) { _Op.ContractJ5q(q_in,J5q); }
+  void ContractJ5q(PropagatorField &q_in,ComplexField &J5q) { _Op.ContractJ5q(q_in,J5q); }
+
+  void Dminus   (const FermionField &psi, FermionField &chi) { Twisted([&]{ _Op.Dminus(psi,chi);    }); }
+  void DminusDag(const FermionField &psi, FermionField &chi) { Twisted([&]{ _Op.DminusDag(psi,chi); }); }
+  void ImportPhysicalFermionSource  (const FermionField &input,FermionField &imported) { Twisted([&]{ _Op.ImportPhysicalFermionSource(input,imported);   }); }
+  void ImportUnphysicalFermion      (const FermionField &input,FermionField &imported) { Twisted([&]{ _Op.ImportUnphysicalFermion(input,imported);       }); }
+  void ExportPhysicalFermionSolution(const FermionField &solution,FermionField &exported) { Twisted([&]{ _Op.ExportPhysicalFermionSolution(solution,exported); }); }
+  void ExportPhysicalFermionSource  (const FermionField &solution,FermionField &exported) { Twisted([&]{ _Op.ExportPhysicalFermionSource(solution,exported);   }); }
+};
+
+NAMESPACE_END(Grid);
@@ -0,0 +1,148 @@
+/*************************************************************************************
+
+Grid physics library, www.github.com/paboyle/Grid
+
+Source file: ./lib/qcd/action/fermion/TwistPhaseWilsonImpl.h
+
+Copyright (C) 2015
+
+Author: Peter Boyle <pabobyle@ph.ed.ac.uk>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+See the full license in the file "LICENSE" in the top level distribution
+directory
+*************************************************************************************/
+			   /*  END LEGAL */
+#pragma once
+
+NAMESPACE_BEGIN(Grid);
+
+/////////////////////////////////////////////////////////////////////////////
+// Wilson fermions with the momentum twist applied in the hopping kernels.
+//
+// WilsonImpl folds twist_n_2pi_L into the doubled links in DoubleStore, so
+// every twist angle needs its own gauge import. Here the links carry only the
+// boundary phases and leg mu is multiplied by a precomputed phase
+//
+//    twist_phase[mu] = exp(+i 2 pi n_mu / L_mu) ,  twist_phase[mu+Nd] = conj
+//
+// carried to the kernels in the stencil parameters. The phase is applied to
+// every leg unconditionally, so there is no branch in the kernel, and operators
+// that differ only in their twist can share the gauge field (TwistPhaseFermion).
+/////////////////////////////////////////////////////////////////////////////
+template <class S, class Options = CoeffReal >
+class TwistPhaseWilsonImpl : public WilsonImpl<S, FundamentalRepresentation, Options> {
+public:
+
+  typedef WilsonImpl<S, FundamentalRepresentation, Options> Base;
+  INHERIT_GIMPL_TYPES(Base);
+
+  typedef typename Base::Coeff_t               Coeff_t;
+  typedef typename Base::SiteSpinor            SiteSpinor;
+  typedef typename Base::SiteHalfSpinor        SiteHalfSpinor;
+  typedef typename Base::SiteDoubledGaugeField SiteDoubledGaugeField;
+  typedef typename Base::SiteLink              SiteLink;
+  typedef typename Base::FermionField          FermionField;
+  typedef typename Base::DoubledGaugeField     DoubledGaugeField;
+
+  typedef TwistPhaseWilsonImplParams ImplParams;
+  typedef WilsonStencil<SiteSpinor, SiteHalfSpinor,ImplParams> StencilImpl;
+  typedef const typename StencilImpl::View_type StencilView;
+
+  ImplParams Params;
+
+  TwistPhaseWilsonImpl(const ImplParams &p = ImplParams()) : Base(p), Params(p) {
+  };
+
+  // Phase of leg mu from twist_n_2pi_L; needs only the global extent
+  static inline void SetTwistPhase(GridBase *GaugeGrid,ImplParams &p)
+  {
+    for(int mu=0;mu<Nd;mu++){
+      int L = GaugeGrid->GlobalDimensions()[mu];
+      RealD theta = p.twist_n_2pi_L[mu] * 2*M_PI / L;
+      p.twist_phase[mu]    = Complex(::cos(theta), ::sin(theta));
+      p.twist_phase[mu+Nd] = Complex(::cos(theta),-::sin(theta));
+    }
+  }
+
+  static accelerator_inline typename Simd::scalar_type linkPhase(int mu,StencilView &St)
+  {
+    typedef typename Simd::scalar_type scalar_type;
+    Complex p = St.parameters.twist_phase[mu];
+    return scalar_type(real(p),imag(p));
+  }
+
+  template<class _Spinor>
+  static accelerator_inline void multLink(_Spinor &phi,
+					  const SiteDoubledGaugeField &U,
+					  const _Spinor &chi,
+					  int mu,
+					  StencilEntry *SE,
+					  StencilView &St)
+  {
+    auto UU = coalescedRead(U(mu));
+    mult(&phi(), &UU, &chi());
+    phi = phi*linkPhase(mu,St);
+  }
+
+  // Link as seen by the hand unrolled kernels
+  static accelerator_inline SiteLink loadLink(const SiteDoubledGaugeField &U,int mu,StencilEntry *SE,StencilView &St)
+  {
+    return U(mu)*linkPhase(mu,St);
+  }
+
+  template<class _SpinorField>
+  inline void multLinkField(_SpinorField & out,
+			    const DoubledGaugeField &Umu,
+			    const _SpinorField & phi,
+			    int mu)
+  {
+    typedef typename Simd::scalar_type scalar_type;
+    Base::multLinkField(out,Umu,phi,mu);
+    Complex p = Params.twist_phase[mu];
+    out = out*scalar_type(real(p),imag(p));
+  }
+
+  inline void extractLinkField(std::vector<GaugeLinkField> &mat, DoubledGaugeField &Uds)
+  {
+    typedef typename Simd::scalar_type scalar_type;
+    for (int mu = 0; mu < Nd; mu++) {
+      Complex p = Params.twist_phase[mu];
+      mat[mu] = PeekIndex<LorentzIndex>(Uds, mu)*scalar_type(real(p),imag(p));
+    }
+  }
+
+  inline void DoubleStore(GridBase *GaugeGrid,
+			  DoubledGaugeField &Uds,
+			  const GaugeField &Umu)
+  {
+    // Boundary phases go into the links, the twist stays out of them
+    WilsonImplParams links(Params);
+    for(int mu=0;mu<Nd;mu++) links.twist_n_2pi_L[mu] = 0.0;
+    Base Untwisted(links);
+    Untwisted.DoubleStore(GaugeGrid,Uds,Umu);
+    SetTwistPhase(GaugeGrid,Params);
+  }
+};
+
+template <class S, class Options>
+struct ImplParamsFromLinks<TwistPhaseWilsonImpl<S,Options> > : public std::true_type {};
+
+typedef TwistPhaseWilsonImpl<vComplex,  CoeffReal > TwistPhaseWilsonImplR;  // Real.. whichever prec
+typedef TwistPhaseWilsonImpl<vComplexF, CoeffReal > TwistPhaseWilsonImplF;  // Float
+typedef TwistPhaseWilsonImpl<vComplexD, CoeffReal > TwistPhaseWilsonImplD;  // Double
+
+NAMESPACE_END(Grid);
@@ -288,6 +288,73 @@ public:
     });
   }
 
+  // One chiral half of a site: res.spin(2*block,2*block+1) = A_block * in.spin(2*block,2*block+1),
+  // with A_block the hermitian 6x6 block held as diagonal + upper right triangle
+  template<int block, class CalcSpinor, class Diag, class Tri>
+  static accelerator_inline void MooeeBlock_cpu(CalcSpinor& res, const CalcSpinor& in_t, const Diag& diag_t, const Tri& triangle_t) {
+    const int s0 = 2*block;
+    const int s1 = 2*block+1;
+
+    auto in_cc_s0_0 = conjugate(in_t()(s0)(0)); // Nils: reduces number
+    auto in_cc_s0_1 = conjugate(in_t()(s0)(1)); // of conjugates from
+    auto in_cc_s0_2 = conjugate(in_t()(s0)(2)); // 30 to 20
+    auto in_cc_s1_0 = conjugate(in_t()(s1)(0));
+    auto in_cc_s1_1 = conjugate(in_t()(s1)(1));
+
+    res()(s0)(0) =               diag_t()(block)( 0) * in_t()(s0)(0)
+                 +           triangle_t()(block)( 0) * in_t()(s0)(1)
+                 +           triangle_t()(block)( 1) * in_t()(s0)(2)
+                 +           triangle_t()(block)( 2) * in_t()(s1)(0)
+                 +           triangle_t()(block)( 3) * in_t()(s1)(1)
+                 +           triangle_t()(block)( 4) * in_t()(s1)(2);
+
+    res()(s0)(1) =           triangle_t()(block)( 0) * in_cc_s0_0;
+    res()(s0)(1) =               diag_t()(block)( 1) * in_t()(s0)(1)
+                 +           triangle_t()(block)( 5) * in_t()(s0)(2)
+                 +           triangle_t()(block)( 6) * in_t()(s1)(0)
+                 +           triangle_t()(block)( 7) * in_t()(s1)(1)
+                 +           triangle_t()(block)( 8) * in_t()(s1)(2)
+                 + conjugate(       res()(s0)( 1));
+
+    res()(s0)(2) =           triangle_t()(block)( 1) * in_cc_s0_0
+                 +           triangle_t()(block)( 5) * in_cc_s0_1;
+    res()(s0)(2) =               diag_t()(block)( 2) * in_t()(s0)(2)
+                 +           triangle_t()(block)( 9) * in_t()(s1)(0)
+                 +           triangle_t()(block)(10) * in_t()(s1)(1)
+                 +           triangle_t()(block)(11) * in_t()(s1)(2)
+                 + conjugate(       res()(s0)( 2));
+
+    res()(s1)(0) =           triangle_t()(block)( 2) * in_cc_s0_0
+                 +           triangle_t()(block)( 6) * in_cc_s0_1
+                 +           triangle_t()(block)( 9) * in_cc_s0_2;
+    res()(s1)(0) =               diag_t()(block)( 3) * in_t()(s1)(0)
+                 +           triangle_t()(block)(12) * in_t()(s1)(1)
+                 +           triangle_t()(block)(13) * in_t()(s1)(2)
+                 + conjugate(       res()(s1)( 0));
+
+    res()(s1)(1) =           triangle_t()(block)( 3) * in_cc_s0_0
+                 +           triangle_t()(block)( 7) * in_cc_s0_1
+                 +           triangle_t()(block)(10) * in_cc_s0_2
+                 +           triangle_t()(block)(12) * in_cc_s1_0;
+    res()(s1)(1) =               diag_t()(block)( 4) * in_t()(s1)(1)
+                 +           triangle_t()(block)(14) * in_t()(s1)(2)
+                 + conjugate(       res()(s1)( 1));
+
+    res()(s1)(2) =           triangle_t()(block)( 4) * in_cc_s0_0
+                 +           triangle_t()(block)( 8) * in_cc_s0_1
+                 +           triangle_t()(block)(11) * in_cc_s0_2
+                 +           triangle_t()(block)(13) * in_cc_s1_0
+                 +           triangle_t()(block)(14) * in_cc_s1_1;
+    res()(s1)(2) =               diag_t()(block)( 5) * in_t()(s1)(2)
+                 + conjugate(       res()(s1)( 2));
+  }
+
+  template<class CalcSpinor, class Diag, class Tri>
+  static accelerator_inline void MooeeSite_cpu(CalcSpinor& res, const CalcSpinor& in_t, const Diag& diag_t, const Tri& triangle_t) {
+    MooeeBlock_cpu<0>(res, in_t, diag_t, triangle_t);
+    MooeeBlock_cpu<1>(res, in_t, diag_t, triangle_t);
+  }
+
   static void MooeeKernel_cpu(int                        Nsite,
                               int                        Ls,
                               const FermionField&        in,
@@ -372,58 +439,7 @@ public:
       // upper half
       PREFETCH_CLOVER(0);
 
-      auto in_cc_0_0 = conjugate(in_t()(0)(0)); // Nils: reduces number
-      auto in_cc_0_1 = conjugate(in_t()(0)(1)); // of conjugates from
-      auto in_cc_0_2 = conjugate(in_t()(0)(2)); // 30 to 20
-      auto in_cc_1_0 = conjugate(in_t()(1)(0));
-      auto in_cc_1_1 = conjugate(in_t()(1)(1));
-
-      res()(0)(0) =               diag_t()(0)( 0) * in_t()(0)(0)
-                  +           triangle_t()(0)( 0) * in_t()(0)(1)
-                  +           triangle_t()(0)( 1) * in_t()(0)(2)
-                  +           triangle_t()(0)( 2) * in_t()(1)(0)
-                  +           triangle_t()(0)( 3) * in_t()(1)(1)
-                  +           triangle_t()(0)( 4) * in_t()(1)(2);
-
-      res()(0)(1) =           triangle_t()(0)( 0) * in_cc_0_0;
-      res()(0)(1) =               diag_t()(0)( 1) * in_t()(0)(1)
-                  +           triangle_t()(0)( 5) * in_t()(0)(2)
-                  +           triangle_t()(0)( 6) * in_t()(1)(0)
-                  +           triangle_t()(0)( 7) * in_t()(1)(1)
-                  +           triangle_t()(0)( 8) * in_t()(1)(2)
-                  + conjugate(       res()(0)( 1));
-
-      res()(0)(2) =           triangle_t()(0)( 1) * in_cc_0_0
-                  +           triangle_t()(0)( 5) * in_cc_0_1;
-      res()(0)(2) =               diag_t()(0)( 2) * in_t()(0)(2)
-                  +           triangle_t()(0)( 9) * in_t()(1)(0)
-                  +           triangle_t()(0)(10) * in_t()(1)(1)
-                  +           triangle_t()(0)(11) * in_t()(1)(2)
-                  + conjugate(       res()(0)( 2));
-
-      res()(1)(0) =           triangle_t()(0)( 2) * in_cc_0_0
-                  +           triangle_t()(0)( 6) * in_cc_0_1
-                  +           triangle_t()(0)( 9) * in_cc_0_2;
-      res()(1)(0) =               diag_t()(0)( 3) * in_t()(1)(0)
-                  +           triangle_t()(0)(12) * in_t()(1)(1)
-                  +           triangle_t()(0)(13) * in_t()(1)(2)
-                  + conjugate(       res()(1)( 0));
-
-      res()(1)(1) =           triangle_t()(0)( 3) * in_cc_0_0
-                  +           triangle_t()(0)( 7) * in_cc_0_1
-                  +           triangle_t()(0)(10) * in_cc_0_2
-                  +           triangle_t()(0)(12) * in_cc_1_0;
-      res()(1)(1) =               diag_t()(0)( 4) * in_t()(1)(1)
-                  +           triangle_t()(0)(14) * in_t()(1)(2)
-                  + conjugate(       res()(1)( 1));
-
-      res()(1)(2) =           triangle_t()(0)( 4) * in_cc_0_0
-                  +           triangle_t()(0)( 8) * in_cc_0_1
-                  +           triangle_t()(0)(11) * in_cc_0_2
-                  +           triangle_t()(0)(13) * in_cc_1_0
-                  +           triangle_t()(0)(14) * in_cc_1_1;
-      res()(1)(2) =               diag_t()(0)( 5) * in_t()(1)(2)
-                  + conjugate(       res()(1)( 2));
+      MooeeBlock_cpu<0>(res, in_t, diag_t, triangle_t);
 
       vstream(out_v[sF]()(0)(0), res()(0)(0));
       vstream(out_v[sF]()(0)(1), res()(0)(1));
@@ -435,58 +451,7 @@ public:
       // lower half
       PREFETCH_CLOVER(1);
 
-      auto in_cc_2_0 = conjugate(in_t()(2)(0));
-      auto in_cc_2_1 = conjugate(in_t()(2)(1));
-      auto in_cc_2_2 = conjugate(in_t()(2)(2));
-      auto in_cc_3_0 = conjugate(in_t()(3)(0));
-      auto in_cc_3_1 = conjugate(in_t()(3)(1));
-
-      res()(2)(0) =               diag_t()(1)( 0) * in_t()(2)(0)
-                  +           triangle_t()(1)( 0) * in_t()(2)(1)
-                  +           triangle_t()(1)( 1) * in_t()(2)(2)
-                  +           triangle_t()(1)( 2) * in_t()(3)(0)
-                  +           triangle_t()(1)( 3) * in_t()(3)(1)
-                  +           triangle_t()(1)( 4) * in_t()(3)(2);
-
-      res()(2)(1) =           triangle_t()(1)( 0) * in_cc_2_0;
-      res()(2)(1) =               diag_t()(1)( 1) * in_t()(2)(1)
-                  +           triangle_t()(1)( 5) * in_t()(2)(2)
-                  +           triangle_t()(1)( 6) * in_t()(3)(0)
-                  +           triangle_t()(1)( 7) * in_t()(3)(1)
-                  +           triangle_t()(1)( 8) * in_t()(3)(2)
-                  + conjugate(       res()(2)( 1));
-
-      res()(2)(2) =           triangle_t()(1)( 1) * in_cc_2_0
-                  +           triangle_t()(1)( 5) * in_cc_2_1;
-      res()(2)(2) =               diag_t()(1)( 2) * in_t()(2)(2)
-                  +           triangle_t()(1)( 9) * in_t()(3)(0)
-                  +           triangle_t()(1)(10) * in_t()(3)(1)
-                  +           triangle_t()(1)(11) * in_t()(3)(2)
-                  + conjugate(       res()(2)( 2));
-
-      res()(3)(0) =           triangle_t()(1)( 2) * in_cc_2_0
-                  +           triangle_t()(1)( 6) * in_cc_2_1
-                  +           triangle_t()(1)( 9) * in_cc_2_2;
-      res()(3)(0) =               diag_t()(1)( 3) * in_t()(3)(0)
-                  +           triangle_t()(1)(12) * in_t()(3)(1)
-                  +           triangle_t()(1)(13) * in_t()(3)(2)
-                  + conjugate(       res()(3)( 0));
-
-      res()(3)(1) =           triangle_t()(1)( 3) * in_cc_2_0
-                  +           triangle_t()(1)( 7) * in_cc_2_1
-                  +           triangle_t()(1)(10) * in_cc_2_2
-                  +           triangle_t()(1)(12) * in_cc_3_0;
-      res()(3)(1) =               diag_t()(1)( 4) * in_t()(3)(1)
-                  +           triangle_t()(1)(14) * in_t()(3)(2)
-                  + conjugate(       res()(3)( 1));
-
-      res()(3)(2) =           triangle_t()(1)( 4) * in_cc_2_0
-                  +           triangle_t()(1)( 8) * in_cc_2_1
-                  +           triangle_t()(1)(11) * in_cc_2_2
-                  +           triangle_t()(1)(13) * in_cc_3_0
-                  +           triangle_t()(1)(14) * in_cc_3_1;
-      res()(3)(2) =               diag_t()(1)( 5) * in_t()(3)(2)
-                  + conjugate(       res()(3)( 2));
+      MooeeBlock_cpu<1>(res, in_t, diag_t, triangle_t);
 
       vstream(out_v[sF]()(2)(0), res()(2)(0));
       vstream(out_v[sF]()(2)(1), res()(2)(1));
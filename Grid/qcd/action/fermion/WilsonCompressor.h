@@ -286,6 +286,10 @@ template<typename HCS,typename HS,typename S> using WilsonCompressor = WilsonCom
 
 // Fast comms buffer manipulation which should inline right through (avoid direction
 // dependent logic that prevents inlining
+// Flavour twist across the boundary in direction mu; only G-parity has one
+template<class Parameters> inline int WilsonStencilTwisted(const Parameters &p,int mu) { return 0; }
+inline int WilsonStencilTwisted(const GparityWilsonImplParams &p,int mu) { return p.twists[mu]; }
+
 template<class vobj,class cobj,class Parameters>
 class WilsonStencil : public CartesianStencil<vobj,cobj,Parameters> {
 public:
@@ -299,6 +303,11 @@ public:
 
   std::vector<int> surface_list;
 
+  // 4d sites with a leg through a twisted boundary, and the remaining bulk;
+  // the bulk can skip the per leg flavour twist logic
+  Vector<int> twist_list;
+  Vector<int> bulk_list;
+
   WilsonStencil(GridBase *grid,
 		int npoints,
 		int checkerboard,
@@ -330,6 +339,22 @@ public:
 	surface_list.push_back(site);
       }
     }
+
+    // Points are Xp..Tm as in the kernels; the 5d stencil directions are offset by s
+    twist_list.resize(0);
+    bulk_list.resize(0);
+    for(int site = 0 ;site< vol4;site++){
+      int twisted = 0;
+      for(int point=0;point<this->_npoints;point++){
+	int ptype;
+	StencilEntry *SE = this->GetEntry(ptype,point,site*Ls);
+	if ( SE->_around_the_world && WilsonStencilTwisted(this->parameters,point%Nd) ) {
+	  twisted = 1;
+	}
+      }
+      if ( twisted ) twist_list.push_back(site);
+      else           bulk_list.push_back(site);
+    }
   }
 
   template < class compressor>
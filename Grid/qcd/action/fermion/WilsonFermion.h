@@ -185,6 +185,9 @@ public:
   LebesgueOrder Lebesgue;
   LebesgueOrder LebesgueEvenOdd;
 
+  // Kernel and comms choice from --dslash-autotune
+  DslashTuning Tuning;
+
   WilsonAnisotropyCoefficients anisotropyCoeff;
 
   ///////////////////////////////////////////////////////////////
@@ -213,6 +213,9 @@ public:
     
   LebesgueOrder Lebesgue;
   LebesgueOrder LebesgueEvenOdd;
+
+  // Kernel and comms choice from --dslash-autotune
+  DslashTuning Tuning;
     
   // Comms buffer
   //  std::vector<SiteHalfSpinor,alignedAllocator<SiteHalfSpinor> >  comm_buf;
@@ -64,6 +64,7 @@ public:
   typedef iImplHalfSpinor<Simd>        SiteHalfSpinor;
   typedef iImplHalfCommSpinor<SimdL>   SiteHalfCommSpinor;
   typedef iImplDoubledGaugeField<Simd> SiteDoubledGaugeField;
+  typedef iScalar<iMatrix<Simd, Dimension> > SiteLink;
     
   typedef Lattice<SiteSpinor>            FermionField;
   typedef Lattice<SitePropagator>        PropagatorField;
@@ -100,6 +101,15 @@ public:
     multLink(phi,U,chi,mu);
   }
 
+  // Link as seen by the hand unrolled kernels; compressed storage reconstructs here
+  static accelerator_inline const SiteLink & loadLink(const SiteDoubledGaugeField &U,
+						      int mu,
+						      StencilEntry *SE,
+						      StencilView &St)
+  {
+    return U(mu);
+  }
+
   template<class _SpinorField> 
   inline void multLinkField(_SpinorField & out,
 			    const DoubledGaugeField &Umu,
@@ -74,6 +74,11 @@ public:
   static void DhopDirKernel(StencilImpl &st, DoubledGaugeField &U,SiteHalfSpinor * buf,
 			    int Ls, int Nsite, const FermionField &in, FermionField &out, int dirdisp, int gamma);
 
+  // All Ls sites above the 4d site sU, so a caller can finish the fifth
+  // dimension column while it is still in cache. Host code only.
+  static void DhopSiteColumn(int Opt,int dag,StencilView &st, DoubledGaugeFieldView &U, SiteHalfSpinor * buf,
+			     int Ls, int sU, const FermionFieldView &in, FermionFieldView &out);
+
 private:
 
   static accelerator_inline void DhopDirK(StencilView &st, DoubledGaugeFieldView &U,SiteHalfSpinor * buf,
@@ -143,6 +148,19 @@ private:
   
   static accelerator void HandDhopSiteDagExt(StencilView &st,  DoubledGaugeFieldView &U, SiteHalfSpinor * buf,
 					     int sF, int sU, const FermionFieldView &in, FermionFieldView &out);
+
+  // Sites with no leg through a twisted boundary (G-parity bulk)
+  static accelerator void HandDhopSiteBulk(StencilView &st,  DoubledGaugeFieldView &U, SiteHalfSpinor * buf,
+					   int sF, int sU, const FermionFieldView &in, FermionFieldView &out);
+  
+  static accelerator void HandDhopSiteDagBulk(StencilView &st,  DoubledGaugeFieldView &U, SiteHalfSpinor * buf,
+					      int sF, int sU, const FermionFieldView &in, FermionFieldView &out);
+  
+  static accelerator void HandDhopSiteIntBulk(StencilView &st,  DoubledGaugeFieldView &U, SiteHalfSpinor * buf,
+					      int sF, int sU, const FermionFieldView &in, FermionFieldView &out);
+  
+  static accelerator void HandDhopSiteDagIntBulk(StencilView &st,  DoubledGaugeFieldView &U, SiteHalfSpinor * buf,
+						 int sF, int sU, const FermionFieldView &in, FermionFieldView &out);
  public:
  WilsonKernels(const ImplParams &p = ImplParams()) : Base(p){};
 };
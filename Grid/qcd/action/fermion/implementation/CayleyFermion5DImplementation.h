@@ -214,14 +214,20 @@ void CayleyFermion5D<Impl>::M5D   (const FermionField &psi, FermionField &chi)
   M5D(psi,chi,chi,lower,diag,upper);
 }
 template<class Impl>
-void CayleyFermion5D<Impl>::Meooe5D    (const FermionField &psi, FermionField &Din)
+void CayleyFermion5D<Impl>::Meooe5DCoefficients(Vector<Coeff_t> &lower,Vector<Coeff_t> &diag,Vector<Coeff_t> &upper)
 {
   int Ls=this->Ls;
-  Vector<Coeff_t> diag = bs;
-  Vector<Coeff_t> upper= cs;
-  Vector<Coeff_t> lower= cs; 
+  diag = bs;
+  upper= cs;
+  lower= cs; 
   upper[Ls-1]=-mass_minus*upper[Ls-1];
   lower[0]   =-mass_plus*lower[0];
+}
+template<class Impl>
+void CayleyFermion5D<Impl>::Meooe5D    (const FermionField &psi, FermionField &Din)
+{
+  Vector<Coeff_t> diag, upper, lower;
+  Meooe5DCoefficients(lower,diag,upper);
   M5D(psi,psi,Din,lower,diag,upper);
 }
 // FIXME Redunant with the above routine; check this and eliminate
@@ -240,27 +246,33 @@ template<class Impl> void CayleyFermion5D<Impl>::Meo5D     (const FermionField &
   M5D(psi,psi,chi,lower,diag,upper);
 }
 template<class Impl>
-void CayleyFermion5D<Impl>::Mooee       (const FermionField &psi, FermionField &chi)
+void CayleyFermion5D<Impl>::MooeeCoefficients(Vector<Coeff_t> &lower,Vector<Coeff_t> &diag,Vector<Coeff_t> &upper)
 {
   int Ls=this->Ls;
-  Vector<Coeff_t> diag = bee;
-  Vector<Coeff_t> upper(Ls);
-  Vector<Coeff_t> lower(Ls);
+  diag = bee;
+  upper.resize(Ls);
+  lower.resize(Ls);
   for(int i=0;i<Ls;i++) {
     upper[i]=-cee[i];
     lower[i]=-cee[i];
   }
   upper[Ls-1]=-mass_minus*upper[Ls-1];
   lower[0]   =-mass_plus*lower[0];
+}
+template<class Impl>
+void CayleyFermion5D<Impl>::Mooee       (const FermionField &psi, FermionField &chi)
+{
+  Vector<Coeff_t> diag, upper, lower;
+  MooeeCoefficients(lower,diag,upper);
   M5D(psi,psi,chi,lower,diag,upper);
 }
 template<class Impl>
-void CayleyFermion5D<Impl>::MooeeDag    (const FermionField &psi, FermionField &chi)
+void CayleyFermion5D<Impl>::MooeeDagCoefficients(Vector<Coeff_t> &lower,Vector<Coeff_t> &diag,Vector<Coeff_t> &upper)
 {
   int Ls=this->Ls;
-  Vector<Coeff_t> diag = bee;
-  Vector<Coeff_t> upper(Ls);
-  Vector<Coeff_t> lower(Ls);
+  diag = bee;
+  upper.resize(Ls);
+  lower.resize(Ls);
 
   for (int s=0;s<Ls;s++){
     // Assemble the 5d matrix
@@ -281,6 +293,12 @@ void CayleyFermion5D<Impl>::MooeeDag    (const FermionField &psi, FermionField &
     upper[s]=conjugate(upper[s]);
     lower[s]=conjugate(lower[s]);
   }
+}
+template<class Impl>
+void CayleyFermion5D<Impl>::MooeeDag    (const FermionField &psi, FermionField &chi)
+{
+  Vector<Coeff_t> diag, upper, lower;
+  MooeeDagCoefficients(lower,diag,upper);
   M5Ddag(psi,psi,chi,lower,diag,upper);
 }
 
@@ -297,12 +315,12 @@ void CayleyFermion5D<Impl>::M5Ddag (const FermionField &psi, FermionField &chi)
 }
 
 template<class Impl>
-void CayleyFermion5D<Impl>::MeooeDag5D    (const FermionField &psi, FermionField &Din)
+void CayleyFermion5D<Impl>::MeooeDag5DCoefficients(Vector<Coeff_t> &lower,Vector<Coeff_t> &diag,Vector<Coeff_t> &upper)
 {
   int Ls=this->Ls;
-  Vector<Coeff_t> diag =bs;
-  Vector<Coeff_t> upper=cs;
-  Vector<Coeff_t> lower=cs; 
+  diag =bs;
+  upper=cs;
+  lower=cs; 
 
   for (int s=0;s<Ls;s++){
     if ( s== 0 ) {
@@ -319,6 +337,12 @@ void CayleyFermion5D<Impl>::MeooeDag5D    (const FermionField &psi, FermionField
     lower[s] = conjugate(lower[s]);
     diag[s]  = conjugate(diag[s]);
   }
+}
+template<class Impl>
+void CayleyFermion5D<Impl>::MeooeDag5D    (const FermionField &psi, FermionField &Din)
+{
+  Vector<Coeff_t> diag, upper, lower;
+  MeooeDag5DCoefficients(lower,diag,upper);
   M5Ddag(psi,psi,Din,lower,diag,upper);
 }
 
@@ -124,10 +124,136 @@ CayleyFermion5D<Impl>::M5Ddag(const FermionField &psi_i,
   M5Dtime+=usecond();
 }
 
+///////////////////////////////////////////////////////////////////////////
+// Host MooeeInv, one 4d site's column of Ls spinors at a time. In the
+// chiral basis the L factor couples only one half of the spinor and the U
+// factor only the other, so the sweeps run on half spinors:
+//   A = P- , B = P+ for MooeeInv; exchanged, with the conjugated L and U
+//   coefficients swapped, for MooeeInvDag.
+// The forward sweep keeps its B halves in a per thread work column and
+// the A halves are re-read from psi. chi is then written exactly once,
+// by the backward sweep, so a streaming store can skip the read for
+// ownership on a field that is not read again soon.
+///////////////////////////////////////////////////////////////////////////
+template<int dag,class hspinor,class spinor> inline void CayleyProjA(hspinor &out,const spinor &in)
+{
+  if ( dag ) spProj5p(out,in);
+  else       spProj5m(out,in);
+}
+template<int dag,class hspinor,class spinor> inline void CayleyProjB(hspinor &out,const spinor &in)
+{
+  if ( dag ) spProj5m(out,in);
+  else       spProj5p(out,in);
+}
+template<int dag,class hspinor,class spinor> inline void CayleyJoinAB(spinor &out,const hspinor &a,const hspinor &b)
+{
+  if ( dag ) spJoin5(out,a,b);
+  else       spJoin5(out,b,a);
+}
+
+// chi may alias psi
+template<int dag,int stream,class hspinor,class spinor,class Coeff_t>
+inline void CayleyMooeeInvColumn(const spinor *psi,spinor *chi,hspinor *work,int Ls,
+				 const Coeff_t *fl,const Coeff_t *flm,const Coeff_t *dinv,
+				 const Coeff_t *bu,const Coeff_t *bum)
+{
+  hspinor a, b, tmp, acc;
+  spinor res;
+
+  // Forward: B half carries the L recurrence, A half accumulates the corner
+  CayleyProjA<dag>(a,psi[0]);
+  CayleyProjB<dag>(tmp,psi[0]);
+  acc = flm[0]*a;
+  work[0] = tmp;
+  for(int s=1;s<Ls-1;s++){
+    CayleyProjA<dag>(a,psi[s]);
+    CayleyProjB<dag>(b,psi[s]);
+    tmp = b - fl[s-1]*tmp;
+    acc = acc + flm[s]*a;
+    work[s] = tmp;
+  }
+  CayleyProjA<dag>(a,psi[Ls-1]);
+  CayleyProjB<dag>(b,psi[Ls-1]);
+  b   = dinv[Ls-1]*(b - fl[Ls-2]*tmp);
+  tmp = dinv[Ls-1]*(a - acc);
+  acc = b;
+  CayleyJoinAB<dag>(res,tmp,acc);
+  if ( stream ) vstream(chi[Ls-1],res);
+  else          chi[Ls-1] = res;
+
+  // Backward: A half carries the U recurrence, B half the corner
+  for (int s=Ls-2;s>=0;s--){
+    CayleyProjA<dag>(a,psi[s]);
+    tmp = dinv[s]*a       - bu[s]*tmp;
+    b   = dinv[s]*work[s] - bum[s]*acc;
+    CayleyJoinAB<dag>(res,tmp,b);
+    if ( stream ) vstream(chi[s],res);
+    else          chi[s] = res;
+  }
+}
+
+// Sweep coefficients of MooeeInv (dag=0) or MooeeInvDag (dag=1), reciprocal diagonal taken once
+template<class Impl>
+void
+CayleyFermion5D<Impl>::MooeeInvSweepCoefficients(int dag,Vector<Coeff_t> &fl,Vector<Coeff_t> &flm,Vector<Coeff_t> &dinv,
+						 Vector<Coeff_t> &bu,Vector<Coeff_t> &bum)
+{
+  int Ls=this->Ls;
+  fl.resize(Ls); flm.resize(Ls); dinv.resize(Ls); bu.resize(Ls); bum.resize(Ls);
+  for(int s=0;s<Ls;s++){
+    if ( dag ) {
+      fl[s]  = conjugate(uee[s]);   flm[s] = conjugate(ueem[s]);
+      bu[s]  = conjugate(lee[s]);   bum[s] = conjugate(leem[s]);
+      dinv[s]= conjugate(1.0/dee[s]);
+    } else {
+      fl[s]  = lee[s];   flm[s] = leem[s];
+      bu[s]  = uee[s];   bum[s] = ueem[s];
+      dinv[s]= 1.0/dee[s];
+    }
+  }
+}
+
+template<class Impl>
+void
+CayleyFermion5D<Impl>::MooeeInvHost(const FermionField &psi_i, FermionField &chi_i,int dag)
+{
+  chi_i.Checkerboard()=psi_i.Checkerboard();
+  GridBase *grid=psi_i.Grid();
+  int Ls=this->Ls;
+
+  Vector<Coeff_t> fl, flm, dinv, bu, bum;
+  MooeeInvSweepCoefficients(dag,fl,flm,dinv,bu,bum);
+  auto pfl = &fl[0];  auto pflm = &flm[0]; auto pdinv = &dinv[0];
+  auto pbu = &bu[0];  auto pbum = &bum[0];
+
+  autoView(psi , psi_i,CpuRead);
+  autoView(chi , chi_i,CpuWrite);
+  const SiteSpinor *psi_p = &psi[0];
+  SiteSpinor       *chi_p = &chi[0];
+
+  MooeeInvCalls++;
+  MooeeInvTime-=usecond();
+  uint64_t nloop = grid->oSites()/Ls;
+  Vector<SiteHalfSpinor> work(Ls*thread_max());
+  thread_region
+  {
+    SiteHalfSpinor *w = &work[Ls*thread_num()];
+    thread_for_in_region(sss,nloop,{
+      uint64_t ss = sss*Ls;
+      if ( dag ) CayleyMooeeInvColumn<1,1>(&psi_p[ss],&chi_p[ss],w,Ls,pfl,pflm,pdinv,pbu,pbum);
+      else       CayleyMooeeInvColumn<0,1>(&psi_p[ss],&chi_p[ss],w,Ls,pfl,pflm,pdinv,pbu,pbum);
+    });
+  }
+  MooeeInvTime+=usecond();
+}
+
 template<class Impl>
 void
 CayleyFermion5D<Impl>::MooeeInv    (const FermionField &psi_i, FermionField &chi_i)
 {
+#if !defined(GRID_CUDA) && !defined(GRID_HIP) && !defined(GRID_SYCL)
+  MooeeInvHost(psi_i,chi_i,DaggerNo);
+#else
   chi_i.Checkerboard()=psi_i.Checkerboard();
   GridBase *grid=psi_i.Grid();
 
@@ -182,13 +308,16 @@ CayleyFermion5D<Impl>::MooeeInv    (const FermionField &psi_i, FermionField &chi
   });
 
   MooeeInvTime+=usecond();
-  
+#endif
 }
 
 template<class Impl>
 void
 CayleyFermion5D<Impl>::MooeeInvDag (const FermionField &psi_i, FermionField &chi_i)
 {
+#if !defined(GRID_CUDA) && !defined(GRID_HIP) && !defined(GRID_SYCL)
+  MooeeInvHost(psi_i,chi_i,DaggerYes);
+#else
   chi_i.Checkerboard()=psi_i.Checkerboard();
   GridBase *grid=psi_i.Grid();
   int Ls=this->Ls;
@@ -245,7 +374,7 @@ CayleyFermion5D<Impl>::MooeeInvDag (const FermionField &psi_i, FermionField &chi
     }
   });
   MooeeInvTime+=usecond();
-
+#endif
 }
 
 NAMESPACE_END(Grid);
@@ -0,0 +1,217 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./lib/qcd/action/fermion/implementation/CayleyFermion5Dfused.h
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+*************************************************************************************/
+/*  END LEGAL */
+
+#include <Grid/qcd/action/fermion/FermionCore.h>
+#include <Grid/qcd/action/fermion/CayleyFermion5D.h>
+
+NAMESPACE_BEGIN(Grid);
+
+///////////////////////////////////////////////////////////////////////////
+// Fifth dimension operators on the Ls spinors above one 4d site, as in
+// CayleyFermion5Dcache.h but acting on a column already in cache.
+// MooeeInv uses CayleyMooeeInvColumn from there, in place.
+///////////////////////////////////////////////////////////////////////////
+
+// col <- M5D(col,col) (dag=0) or M5Ddag(col,col) (dag=1), in place
+template<class spinor,class Coeff_t>
+inline void CayleyColumnM5D(spinor *col,int Ls,int dag,
+			    const Coeff_t *lower,const Coeff_t *diag,const Coeff_t *upper)
+{
+  spinor first = col[0];
+  spinor prev  = col[Ls-1];
+  spinor cur, tmp1, tmp2;
+  for(int s=0;s<Ls;s++){
+    cur = col[s];
+    const spinor &next = (s==Ls-1) ? first : col[s+1];
+    if ( dag ) { spProj5p(tmp1,next); spProj5m(tmp2,prev); }
+    else       { spProj5m(tmp1,next); spProj5p(tmp2,prev); }
+    col[s] = diag[s]*cur+upper[s]*tmp1+lower[s]*tmp2;
+    prev = cur;
+  }
+}
+
+// col <- M5D(psi,psi) - col (dag=0) or M5Ddag(psi,psi) - col (dag=1)
+template<class spinor,class Coeff_t>
+inline void CayleyColumnM5DSub(const spinor *psi,spinor *col,int Ls,int dag,
+			       const Coeff_t *lower,const Coeff_t *diag,const Coeff_t *upper)
+{
+  spinor tmp1, tmp2;
+  for(int s=0;s<Ls;s++){
+    const spinor &next = psi[(s+1)%Ls];
+    const spinor &prev = psi[(s+Ls-1)%Ls];
+    if ( dag ) { spProj5p(tmp1,next); spProj5m(tmp2,prev); }
+    else       { spProj5m(tmp1,next); spProj5p(tmp2,prev); }
+    col[s] = diag[s]*psi[s]+upper[s]*tmp1+lower[s]*tmp2 - col[s];
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////
+// Comms are completed before the compute; the exterior legs of a column
+// must be in place before its fifth dimension operator runs.
+///////////////////////////////////////////////////////////////////////////
+template<class Impl>
+template<class ColumnOp>
+void CayleyFermion5D<Impl>::DhopColumnFused(const FermionField &in, FermionField &out,int dag,ColumnOp op)
+{
+  conformable(in.Grid(),this->FermionRedBlackGrid());
+  conformable(in.Grid(),out.Grid());
+
+  int cb = in.Checkerboard();
+  StencilImpl       &st = (cb==Odd) ? this->StencilOdd : this->StencilEven;
+  DoubledGaugeField &U  = (cb==Odd) ? this->UmuEven    : this->UmuOdd;
+  out.Checkerboard() = (cb==Odd) ? Even : Odd;
+
+  DslashTuner::Scope tuned(this->Tuning);
+  Compressor compressor(dag);
+  int Ls  = this->Ls;
+  int Opt = WilsonKernelsStatic::Opt;
+
+  this->DhopCalls++;
+  this->DhopTotalTime-=usecond();
+  this->DhopCommTime-=usecond();
+  st.HaloExchangeOpt(in,compressor);
+  this->DhopCommTime+=usecond();
+
+  this->DhopComputeTime-=usecond();
+  {
+    autoView(U_v  ,  U,AcceleratorRead);
+    autoView(in_v , in,AcceleratorRead);
+    autoView(out_v,out,AcceleratorWrite);
+    autoView(st_v , st,AcceleratorRead);
+    SiteHalfSpinor *buf = st.CommBuf();
+    SiteSpinor *out_p = &out_v[0];
+    thread_for(sU, U.Grid()->oSites(), {
+      WilsonKernels<Impl>::DhopSiteColumn(Opt,dag,st_v,U_v,buf,Ls,sU,in_v,out_v);
+      op(sU*Ls,&out_p[sU*Ls]);
+    });
+  }
+  this->DhopComputeTime+=usecond();
+  this->DhopTotalTime+=usecond();
+}
+
+template<class Impl>
+void CayleyFermion5D<Impl>::MpcChain(const FermionField &in, FermionField &out,int dag)
+{
+  FermionField tmp(in.Grid());
+  if ( dag == DaggerYes ) {
+    this->MeooeDag(in,tmp);
+    this->MooeeInvDag(tmp,out);
+    this->MeooeDag(out,tmp);
+    this->MooeeDag(in,out);
+  } else {
+    this->Meooe(in,tmp);
+    this->MooeeInv(tmp,out);
+    this->Meooe(out,tmp);
+    this->Mooee(in,out);
+  }
+  axpy(out,-1.0,tmp,out);
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+// Mpc    = Mooee - Meooe MooeeInv Meooe, with Meooe = Dhop Meooe5D:
+//   tmp = Meooe5D psi                                   (one M5D sweep)
+//   tmp = Meooe5D MooeeInv Dhop tmp                     (per column)
+//   chi = Mooee psi - Dhop tmp                          (per column)
+// MpcDag = MooeeDag - MeooeDag MooeeInvDag MeooeDag, with MeooeDag = MeooeDag5D Dhop^dag:
+//   tmp = MooeeInvDag MeooeDag5D Dhop^dag psi           (per column)
+//   chi = MooeeDag psi - MeooeDag5D Dhop^dag tmp        (per column)
+////////////////////////////////////////////////////////////////////////////////////
+template<class Impl>
+void CayleyFermion5D<Impl>::MpcFused(const FermionField &in, FermionField &out)
+{
+  int Ls=this->Ls;
+#if defined(GRID_CUDA) || defined(GRID_HIP) || defined(GRID_SYCL)
+  MpcChain(in,out,DaggerNo);
+#else
+  // s outermost in the SIMD layout (vectorised fifth dimension) has no contiguous column
+  if ( in.Grid()->_rdimensions[0] != Ls ) { MpcChain(in,out,DaggerNo); return; }
+
+  Vector<Coeff_t> el, ed, eu;  Meooe5DCoefficients(el,ed,eu);
+  Vector<Coeff_t> ml, md, mu;  MooeeCoefficients(ml,md,mu);
+  Vector<Coeff_t> fl, flm, dinv, bu, bum;  MooeeInvSweepCoefficients(DaggerNo,fl,flm,dinv,bu,bum);
+  auto pel  = &el[0];   auto ped = &ed[0];   auto peu = &eu[0];
+  auto pml  = &ml[0];   auto pmd = &md[0];   auto pmu = &mu[0];
+  auto pfl  = &fl[0];   auto pflm= &flm[0];  auto pdinv = &dinv[0];
+  auto pbu  = &bu[0];   auto pbum= &bum[0];
+  Vector<SiteHalfSpinor> work(Ls*thread_max());
+  SiteHalfSpinor *pwork = &work[0];
+
+  FermionField tmp(in.Grid());
+  Meooe5D(in,this->tmp());
+
+  M5Dcalls+=2; MooeeInvCalls++;
+  DhopColumnFused(this->tmp(),tmp,DaggerNo,[&](uint64_t ss,SiteSpinor *col){
+    CayleyMooeeInvColumn<0,0>(col,col,&pwork[Ls*thread_num()],Ls,pfl,pflm,pdinv,pbu,pbum);
+    CayleyColumnM5D(col,Ls,0,pel,ped,peu);
+  });
+
+  autoView(in_v,in,CpuRead);
+  const SiteSpinor *in_p = &in_v[0];
+  DhopColumnFused(tmp,out,DaggerNo,[&](uint64_t ss,SiteSpinor *col){
+    CayleyColumnM5DSub(&in_p[ss],col,Ls,0,pml,pmd,pmu);
+  });
+#endif
+}
+
+template<class Impl>
+void CayleyFermion5D<Impl>::MpcDagFused(const FermionField &in, FermionField &out)
+{
+  int Ls=this->Ls;
+#if defined(GRID_CUDA) || defined(GRID_HIP) || defined(GRID_SYCL)
+  MpcChain(in,out,DaggerYes);
+#else
+  if ( in.Grid()->_rdimensions[0] != Ls ) { MpcChain(in,out,DaggerYes); return; }
+
+  Vector<Coeff_t> el, ed, eu;  MeooeDag5DCoefficients(el,ed,eu);
+  Vector<Coeff_t> ml, md, mu;  MooeeDagCoefficients(ml,md,mu);
+  Vector<Coeff_t> fl, flm, dinv, bu, bum;  MooeeInvSweepCoefficients(DaggerYes,fl,flm,dinv,bu,bum);
+  auto pel  = &el[0];   auto ped = &ed[0];   auto peu = &eu[0];
+  auto pml  = &ml[0];   auto pmd = &md[0];   auto pmu = &mu[0];
+  auto pfl  = &fl[0];   auto pflm= &flm[0];  auto pdinv = &dinv[0];
+  auto pbu  = &bu[0];   auto pbum= &bum[0];
+  Vector<SiteHalfSpinor> work(Ls*thread_max());
+  SiteHalfSpinor *pwork = &work[0];
+
+  FermionField tmp(in.Grid());
+
+  M5Dcalls+=3; MooeeInvCalls++;
+  DhopColumnFused(in,tmp,DaggerYes,[&](uint64_t ss,SiteSpinor *col){
+    CayleyColumnM5D(col,Ls,1,pel,ped,peu);
+    CayleyMooeeInvColumn<1,0>(col,col,&pwork[Ls*thread_num()],Ls,pfl,pflm,pdinv,pbu,pbum);
+  });
+
+  autoView(in_v,in,CpuRead);
+  const SiteSpinor *in_p = &in_v[0];
+  DhopColumnFused(tmp,out,DaggerYes,[&](uint64_t ss,SiteSpinor *col){
+    CayleyColumnM5D(col,Ls,1,pel,ped,peu);
+    CayleyColumnM5DSub(&in_p[ss],col,Ls,1,pml,pmd,pmu);
+  });
+#endif
+}
+
+NAMESPACE_END(Grid);
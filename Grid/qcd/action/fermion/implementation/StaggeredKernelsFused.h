@@ -0,0 +1,129 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./lib/qcd/action/fermion/implementation/StaggeredKernelsFused.h
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+*************************************************************************************/
+/*  END LEGAL */
+#pragma once
+
+NAMESPACE_BEGIN(Grid);
+
+///////////////////////////////////////////////////////////////////////////////////////
+// Fused improved staggered kernel for any colour dimension, written in Simt arithmetic
+// only so it vectorises on every SIMD target. The eight fat (U) and eight Naik (UUU)
+// legs are taken in one pass, and each link element is loaded once and applied to a
+// batch of Nb s-slices: in the ImprovedStaggeredFermion5D layout s is innermost
+// (sF=sU*Ls+s) and all slices of a 4d site share the same links and stencil geometry.
+///////////////////////////////////////////////////////////////////////////////////////
+template<class Impl> class StaggeredKernelsFused {
+public:
+  INHERIT_IMPL_TYPES(Impl);
+
+  static const int Dim = Impl::Dimension;
+  typedef decltype(coalescedRead(std::declval<SiteSpinor>()()()(0))) Simt;
+
+  enum { LegsAll, LegsInterior, LegsExterior };
+
+  // One leg for Nb slices starting at sF; returns 1 if the leg contributed
+  template<int Legs,int Nb>
+  static accelerator_inline int Leg(StencilView &st, const SiteDoubledGaugeField &U, SiteSpinor *buf,
+				    int sF, const FermionFieldView &in,
+				    Simt acc[Nb][Dim], int dir, int skew)
+  {
+    const int Nsimd = SiteSpinor::Nsimd();
+    const int lane  = acceleratorSIMTlane(Nsimd);
+
+    // Locality is a property of the 4d site, common to all the slices
+    int ptype;
+    StencilEntry *SE = st.GetEntry(ptype,dir+skew,sF);
+    int local = SE->_is_local;
+    int perm  = SE->_permute;
+    if ( Legs==LegsInterior && !local && !st.same_node[dir] ) return 0;
+    if ( Legs==LegsExterior && ( local || st.same_node[dir]) ) return 0;
+
+    Simt chi[Nb][Dim];
+    for(int s=0;s<Nb;s++){
+      SE = st.GetEntry(ptype,dir+skew,sF+s);
+      typedef decltype(coalescedRead(in[0])) calcSpinor;
+      calcSpinor nbr;
+      if ( local ) nbr = coalescedReadPermute(in[SE->_offset],ptype,perm,lane);
+      else         nbr = coalescedRead(buf[SE->_offset],lane);
+      for(int b=0;b<Dim;b++) chi[s][b] = nbr()()(b);
+    }
+
+    // link row by row, each element applied to all slices of the batch
+    for(int a=0;a<Dim;a++){
+      for(int b=0;b<Dim;b++){
+	Simt u = coalescedRead(U(dir)()(a,b),lane);
+	for(int s=0;s<Nb;s++) acc[s][a] = acc[s][a] + u*chi[s][b];
+      }
+    }
+    acceleratorSynchronise();
+    return 1;
+  }
+
+  template<int Naik,int Legs,int Nb>
+  static accelerator_inline void DhopSite(StencilView &st,
+					  DoubledGaugeFieldView &U, DoubledGaugeFieldView &UUU,
+					  SiteSpinor *buf, int sF, int sU,
+					  const FermionFieldView &in, FermionFieldView &out, int dag)
+  {
+    const int Nsimd = SiteSpinor::Nsimd();
+    const int lane  = acceleratorSIMTlane(Nsimd);
+
+    Simt acc[2][Nb][Dim];
+    for(int s=0;s<Nb;s++){
+      for(int a=0;a<Dim;a++){
+	zeroit(acc[0][s][a]);
+	zeroit(acc[1][s][a]);
+      }
+    }
+
+    // alternate legs accumulate into two sets to shorten the dependency chains
+    int nmu=0;
+    for(int mu=0;mu<2*Nd;mu+=2){
+      nmu+=Leg<Legs,Nb>(st,U[sU],buf,sF,in,acc[0],mu  ,0);
+      nmu+=Leg<Legs,Nb>(st,U[sU],buf,sF,in,acc[1],mu+1,0);
+    }
+    if ( Naik ) {
+      for(int mu=0;mu<2*Nd;mu+=2){
+	nmu+=Leg<Legs,Nb>(st,UUU[sU],buf,sF,in,acc[0],mu  ,8);
+	nmu+=Leg<Legs,Nb>(st,UUU[sU],buf,sF,in,acc[1],mu+1,8);
+      }
+    }
+    if ( Legs==LegsExterior && !nmu ) return;
+
+    for(int s=0;s<Nb;s++){
+      SiteSpinor &ref(out[sF+s]);
+      for(int a=0;a<Dim;a++){
+	Simt r = acc[0][s][a] + acc[1][s][a];
+	if ( dag ) r = -r;
+	if ( Legs==LegsExterior ) r = coalescedRead(ref()()(a),lane) + r;
+	coalescedWrite(ref()()(a),r,lane);
+      }
+    }
+  }
+};
+
+NAMESPACE_END(Grid);
@@ -30,6 +30,8 @@ directory
 
 #pragma once
 
+#include <Grid/qcd/action/fermion/implementation/StaggeredKernelsFused.h>
+
 NAMESPACE_BEGIN(Grid);
 
 #define GENERIC_STENCIL_LEG(U,Dir,skew,multLink)		\
@@ -247,6 +249,59 @@ void StaggeredKernels<Impl>::DhopDirKernel(StencilImpl &st, DoubledGaugeFieldVie
 
 #define KERNEL_CALL(A,improved) KERNEL_CALLNB(A,improved); accelerator_barrier(); 
 
+// Exterior only pass over the stencil surface_list on CPU; as for Wilson
+#if defined(GRID_CUDA) || defined(GRID_HIP) || defined(GRID_SYCL)
+#define KERNEL_CALL_EXT(A,improved) KERNEL_CALL(A,improved)
+#else
+#define KERNEL_CALL_EXT(A,improved)					\
+  const uint64_t    NN = st.surface_list.size()*Ls;			\
+  const int *surf = st.surface_list.data();				\
+  thread_for( ss, NN, {							\
+      int sU = surf[ss/Ls];						\
+      int sF = sU*Ls + ss%Ls;						\
+      ThisKernel:: template A<improved>(st_v,U_v,UUU_v,buf,sF,sU,in_v,out_v,dag); \
+  });
+#endif
+
+// Fused fat+Naik kernel; on the host each thread takes a 4d site and sweeps all its
+// s-slices, so the links come from memory once and are reused from cache. Batches of
+// FUSED_BATCH slices also share each link load in registers; this only pays with a
+// large register file, with 16 vector registers (AVX2) the accumulators spill.
+#ifdef AVX512
+#define FUSED_BATCH 2
+#else
+#define FUSED_BATCH 1
+#endif
+#if defined(GRID_CUDA) || defined(GRID_HIP) || defined(GRID_SYCL)
+#define FUSED_CALL(improved,legs)					\
+  const uint64_t    NN = Nsite*Ls;					\
+  accelerator_for( ss, NN, Simd::Nsimd(), {				\
+      int sF = ss;							\
+      int sU = ss/Ls;							\
+      FusedKernel:: template DhopSite<improved,FusedKernel::legs,1>(st_v,U_v,UUU_v,buf,sF,sU,in_v,out_v,dag); \
+    });
+#define FUSED_CALL_EXT(improved,legs) FUSED_CALL(improved,legs)
+#else
+#define FUSED_CALL_LIST(improved,legs,nsite,site)			\
+  const uint64_t NN = (nsite);						\
+  thread_for( ss, NN, {							\
+      int sU = site(ss);						\
+      int s=0;								\
+      for(;s+FUSED_BATCH<=Ls;s+=FUSED_BATCH) {				\
+	FusedKernel:: template DhopSite<improved,FusedKernel::legs,FUSED_BATCH>(st_v,U_v,UUU_v,buf,sU*Ls+s,sU,in_v,out_v,dag); \
+      }									\
+      for(;s<Ls;s++) {							\
+	FusedKernel:: template DhopSite<improved,FusedKernel::legs,1>(st_v,U_v,UUU_v,buf,sU*Ls+s,sU,in_v,out_v,dag); \
+      }									\
+  });
+#define FUSED_SITE(s) (s)
+#define FUSED_SURF(s) surf[s]
+#define FUSED_CALL(improved,legs) FUSED_CALL_LIST(improved,legs,Nsite,FUSED_SITE)
+#define FUSED_CALL_EXT(improved,legs)					\
+  const int *surf = st.surface_list.data();				\
+  FUSED_CALL_LIST(improved,legs,st.surface_list.size(),FUSED_SURF)
+#endif
+
 #define ASM_CALL(A)							\
   const uint64_t    NN = Nsite*Ls;					\
   thread_for( ss, NN, {							\
@@ -263,6 +318,7 @@ void StaggeredKernels<Impl>::DhopImproved(StencilImpl &st, LebesgueOrder &lo,
   GridBase *FGrid=in.Grid();  
   GridBase *UGrid=U.Grid();  
   typedef StaggeredKernels<Impl> ThisKernel;
+  typedef StaggeredKernelsFused<Impl> FusedKernel;
   const int Nsimd = SiteHalfSpinor::Nsimd();
   const int lane=acceleratorSIMTlane(Nsimd);
   autoView( UUU_v , UUU, AcceleratorRead);
@@ -280,19 +336,22 @@ void StaggeredKernels<Impl>::DhopImproved(StencilImpl &st, LebesgueOrder &lo,
 
   if( interior && exterior ) { 
     if (Opt == OptGeneric    ) { KERNEL_CALL(DhopSiteGeneric,1); return;}
+    if (Opt == OptFused      ) { FUSED_CALL(1,LegsAll);         return;}
 #ifndef GRID_CUDA
     if (Opt == OptHandUnroll ) { KERNEL_CALL(DhopSiteHand,1);    return;}
     if (Opt == OptInlineAsm  ) {  ASM_CALL(DhopSiteAsm);     return;}
 #endif
   } else if( interior ) {
     if (Opt == OptGeneric    ) { KERNEL_CALL(DhopSiteGenericInt,1); return;}
+    if (Opt == OptFused      ) { FUSED_CALL(1,LegsInterior);       return;}
 #ifndef GRID_CUDA
     if (Opt == OptHandUnroll ) { KERNEL_CALL(DhopSiteHandInt,1);    return;}
 #endif
   } else if( exterior ) { 
-    if (Opt == OptGeneric    ) { KERNEL_CALL(DhopSiteGenericExt,1); return;}
+    if (Opt == OptGeneric    ) { KERNEL_CALL_EXT(DhopSiteGenericExt,1); return;}
+    if (Opt == OptFused      ) { FUSED_CALL_EXT(1,LegsExterior);       return;}
 #ifndef GRID_CUDA
-    if (Opt == OptHandUnroll ) { KERNEL_CALL(DhopSiteHandExt,1);    return;}
+    if (Opt == OptHandUnroll ) { KERNEL_CALL_EXT(DhopSiteHandExt,1);    return;}
 #endif
   }
   assert(0 && " Kernel optimisation case not covered ");
@@ -305,6 +364,7 @@ void StaggeredKernels<Impl>::DhopNaive(StencilImpl &st, LebesgueOrder &lo,
   GridBase *FGrid=in.Grid();  
   GridBase *UGrid=U.Grid();  
   typedef StaggeredKernels<Impl> ThisKernel;
+  typedef StaggeredKernelsFused<Impl> FusedKernel;
   const int Nsimd = SiteHalfSpinor::Nsimd();
   const int lane=acceleratorSIMTlane(Nsimd);
   autoView( UUU_v ,   U, AcceleratorRead);
@@ -322,18 +382,21 @@ void StaggeredKernels<Impl>::DhopNaive(StencilImpl &st, LebesgueOrder &lo,
   
   if( interior && exterior ) { 
     if (Opt == OptGeneric    ) { KERNEL_CALL(DhopSiteGeneric,0); return;}
+    if (Opt == OptFused      ) { FUSED_CALL(0,LegsAll);         return;}
 #ifndef GRID_CUDA
     if (Opt == OptHandUnroll ) { KERNEL_CALL(DhopSiteHand,0);    return;}
 #endif
   } else if( interior ) {
     if (Opt == OptGeneric    ) { KERNEL_CALL(DhopSiteGenericInt,0); return;}
+    if (Opt == OptFused      ) { FUSED_CALL(0,LegsInterior);       return;}
 #ifndef GRID_CUDA
     if (Opt == OptHandUnroll ) { KERNEL_CALL(DhopSiteHandInt,0);    return;}
 #endif
   } else if( exterior ) { 
-    if (Opt == OptGeneric    ) { KERNEL_CALL(DhopSiteGenericExt,0); return;}
+    if (Opt == OptGeneric    ) { KERNEL_CALL_EXT(DhopSiteGenericExt,0); return;}
+    if (Opt == OptFused      ) { FUSED_CALL_EXT(0,LegsExterior);       return;}
 #ifndef GRID_CUDA
-    if (Opt == OptHandUnroll ) { KERNEL_CALL(DhopSiteHandExt,0);    return;}
+    if (Opt == OptHandUnroll ) { KERNEL_CALL_EXT(DhopSiteHandExt,0);    return;}
 #endif
   }
 }
@@ -342,6 +405,13 @@ void StaggeredKernels<Impl>::DhopNaive(StencilImpl &st, LebesgueOrder &lo,
 #undef KERNEL_CALLNB
 #undef KERNEL_CALL
 #undef ASM_CALL
+#undef KERNEL_CALL_EXT
+#undef FUSED_BATCH
+#undef FUSED_CALL
+#undef FUSED_CALL_EXT
+#undef FUSED_CALL_LIST
+#undef FUSED_SITE
+#undef FUSED_SURF
 
 NAMESPACE_END(Grid);
 
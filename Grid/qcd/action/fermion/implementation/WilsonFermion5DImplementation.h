@@ -128,6 +128,7 @@ WilsonFermion5D<Impl>::WilsonFermion5D(GaugeField &_Umu,
    //  std::cout << GridLogMessage << " SurfaceLists "<< Stencil.surface_list.size()
    //                       <<" " << StencilEven.surface_list.size()<<std::endl;
 
+  if ( DslashTuner::Enabled ) DslashTuner::Tune(*this,Tuning,Ls);
 }
      
 template<class Impl>
@@ -219,6 +220,10 @@ void WilsonFermion5D<Impl>::ImportGauge(const GaugeField &_Umu)
   GaugeField HUmu(_Umu.Grid());
   HUmu = _Umu*(-0.5);
   Impl::DoubleStore(GaugeGrid(),Umu,HUmu);
+  // DoubleStore may derive parameters from the links; refresh the kernels' copy
+  if ( ImplParamsFromLinks<Impl>::value ) {
+    Stencil.parameters = StencilEven.parameters = StencilOdd.parameters = this->Params;
+  }
   pickCheckerboard(Even,UmuEven,Umu);
   pickCheckerboard(Odd ,UmuOdd,Umu);
 }
@@ -360,6 +365,7 @@ void WilsonFermion5D<Impl>::DhopInternal(StencilImpl & st, LebesgueOrder &lo,
                                          DoubledGaugeField & U,
                                          const FermionField &in, FermionField &out,int dag)
 {
+  DslashTuner::Scope tuned(Tuning);
   DhopTotalTime-=usecond();
   if ( WilsonKernelsStatic::Comms == WilsonKernelsStatic::CommsAndCompute )
     DhopInternalOverlappedComms(st,lo,U,in,out,dag);
@@ -74,6 +74,8 @@ WilsonFermion<Impl>::WilsonFermion(GaugeField &_Umu, GridCartesian &Fgrid,
   vol4=Hgrid.oSites();
   StencilEven.BuildSurfaceList(1,vol4);
   StencilOdd.BuildSurfaceList(1,vol4);
+
+  if ( DslashTuner::Enabled ) DslashTuner::Tune(*this,Tuning,1);
 }
 
 template<class Impl>
@@ -184,6 +186,10 @@ void WilsonFermion<Impl>::ImportGauge(const GaugeField &_Umu)
     HUmu = _Umu * (-0.5);
   }
   Impl::DoubleStore(GaugeGrid(), Umu, HUmu);
+  // DoubleStore may derive parameters from the links; refresh the kernels' copy
+  if ( ImplParamsFromLinks<Impl>::value ) {
+    Stencil.parameters = StencilEven.parameters = StencilOdd.parameters = this->Params;
+  }
   pickCheckerboard(Even, UmuEven, Umu);
   pickCheckerboard(Odd, UmuOdd, Umu);
 }
@@ -488,6 +494,7 @@ void WilsonFermion<Impl>::DhopInternal(StencilImpl &st, LebesgueOrder &lo,
                                        const FermionField &in,
                                        FermionField &out, int dag)
 {
+  DslashTuner::Scope tuned(Tuning);
   DhopTotalTime-=usecond();
 #ifdef GRID_OMP
   if ( WilsonKernelsStatic::Comms == WilsonKernelsStatic::CommsAndCompute )
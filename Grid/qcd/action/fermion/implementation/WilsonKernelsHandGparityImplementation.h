@@ -645,6 +645,9 @@ NAMESPACE_BEGIN(Grid);
   HAND_STENCIL_LEG_EXT(TM_PROJ,0,Tm,TM_RECON_ACCUM,F,LOAD_CHI_IMPL,LOAD_CHIMU_IMPL,MULT_2SPIN_IMPL); \
   HAND_RESULT_EXT(ss,F)
 
+// The *Bulk kernels serve sites with no leg through a twisted boundary
+// (WilsonStencil::bulk_list): the flavours are gathered directly, without
+// the twist setup and lane exchange
 #define HAND_SPECIALISE_GPARITY(IMPL)					\
   template<> accelerator_inline void						\
   WilsonKernels<IMPL>::HandDhopSite(StencilView &st, DoubledGaugeFieldView &U,SiteHalfSpinor  *buf, \
@@ -743,6 +746,66 @@ NAMESPACE_BEGIN(Grid);
     HAND_DOP_SITE_DAG_EXT(0, LOAD_CHI_GPARITY,LOAD_CHIMU_GPARITY,MULT_2SPIN_GPARITY); \
     nmu = 0;								\
     HAND_DOP_SITE_DAG_EXT(1, LOAD_CHI_GPARITY,LOAD_CHIMU_GPARITY,MULT_2SPIN_GPARITY); \
+  }									\
+  template<> accelerator_inline void						\
+  WilsonKernels<IMPL>::HandDhopSiteBulk(StencilView &st, DoubledGaugeFieldView &U,SiteHalfSpinor *buf, \
+				int ss,int sU,const FermionFieldView &in, FermionFieldView &out) \
+  {									\
+    typedef IMPL Impl;							\
+    typedef typename Simd::scalar_type S;				\
+    typedef typename Simd::vector_type V;				\
+									\
+    HAND_DECLARATIONS(ignore);						\
+									\
+    int offset,local,perm, ptype;					\
+    StencilEntry *SE;							\
+    HAND_DOP_SITE(0, LOAD_CHI,LOAD_CHIMU,MULT_2SPIN_GPARITY);	\
+    HAND_DOP_SITE(1, LOAD_CHI,LOAD_CHIMU,MULT_2SPIN_GPARITY);	\
+  }									\
+  template<> accelerator_inline void						\
+  WilsonKernels<IMPL>::HandDhopSiteDagBulk(StencilView &st, DoubledGaugeFieldView &U,SiteHalfSpinor *buf, \
+				   int ss,int sU,const FermionFieldView &in, FermionFieldView &out) \
+  {									\
+    typedef IMPL Impl;							\
+    typedef typename Simd::scalar_type S;				\
+    typedef typename Simd::vector_type V;				\
+									\
+    HAND_DECLARATIONS(ignore);						\
+									\
+    int offset,local,perm, ptype;					\
+    StencilEntry *SE;							\
+    HAND_DOP_SITE_DAG(0, LOAD_CHI,LOAD_CHIMU,MULT_2SPIN_GPARITY);	\
+    HAND_DOP_SITE_DAG(1, LOAD_CHI,LOAD_CHIMU,MULT_2SPIN_GPARITY);	\
+  }									\
+  template<> accelerator_inline void						\
+  WilsonKernels<IMPL>::HandDhopSiteIntBulk(StencilView &st, DoubledGaugeFieldView &U,SiteHalfSpinor *buf, \
+				   int ss,int sU,const FermionFieldView &in, FermionFieldView &out) \
+  {									\
+    typedef IMPL Impl;							\
+    typedef typename Simd::scalar_type S;				\
+    typedef typename Simd::vector_type V;				\
+									\
+    HAND_DECLARATIONS(ignore);						\
+									\
+    int offset,local,perm, ptype;					\
+    StencilEntry *SE;							\
+    HAND_DOP_SITE_INT(0, LOAD_CHI,LOAD_CHIMU,MULT_2SPIN_GPARITY);	\
+    HAND_DOP_SITE_INT(1, LOAD_CHI,LOAD_CHIMU,MULT_2SPIN_GPARITY);	\
+  }									\
+  template<> accelerator_inline void						\
+  WilsonKernels<IMPL>::HandDhopSiteDagIntBulk(StencilView &st, DoubledGaugeFieldView &U,SiteHalfSpinor *buf, \
+				      int ss,int sU,const FermionFieldView &in, FermionFieldView &out) \
+  {									\
+    typedef IMPL Impl;							\
+    typedef typename Simd::scalar_type S;				\
+    typedef typename Simd::vector_type V;				\
+									\
+    HAND_DECLARATIONS(ignore);						\
+									\
+    int offset,local,perm, ptype;					\
+    StencilEntry *SE;							\
+    HAND_DOP_SITE_DAG_INT(0, LOAD_CHI,LOAD_CHIMU,MULT_2SPIN_GPARITY);	\
+    HAND_DOP_SITE_DAG_INT(1, LOAD_CHI,LOAD_CHIMU,MULT_2SPIN_GPARITY);	\
   }
 
 NAMESPACE_END(Grid);
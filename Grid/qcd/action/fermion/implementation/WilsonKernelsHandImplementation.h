@@ -30,11 +30,13 @@ Author: paboyle <paboyle@ph.ed.ac.uk>
 #pragma once
 
 #include <Grid/qcd/action/fermion/FermionCore.h>
+#include <Grid/qcd/action/fermion/implementation/WilsonKernelsUnrollImplementation.h>
 
 
 #undef LOAD_CHIMU  
 #undef LOAD_CHI 
 #undef MULT_2SPIN
+#undef HAND_LINK
 #undef PERMUTE_DIR
 #undef XP_PROJ  
 #undef YP_PROJ  
@@ -118,8 +120,11 @@ Author: paboyle <paboyle@ph.ed.ac.uk>
 
 #endif
 
+// Full link for leg A; Impl::loadLink reconstructs compressed storage
+#define HAND_LINK(A) Impl::loadLink(U[sU],A,SE,st)
+
 #define MULT_2SPIN(A)\
-  {auto & ref(U[sU](A));						\
+  {const auto & ref(HAND_LINK(A));					\
     U_00=coalescedRead(ref()(0,0),lane);				\
     U_10=coalescedRead(ref()(1,0),lane);				\
     U_20=coalescedRead(ref()(2,0),lane);				\
@@ -546,10 +551,20 @@ Author: paboyle <paboyle@ph.ed.ac.uk>
 #define Chimu_31 UChi_11
 #define Chimu_32 UChi_12
 
+// Colour dimensions other than 3 go to the compile time unrolled kernel
+#define HAND_UNROLL_OTHER_NC(DAG,LEGS)					\
+  if ( Impl::Dimension != 3 ) {						\
+    typedef WilsonKernelsUnroll<Impl> Unroll;				\
+    Unroll::template DhopSite<DAG,Unroll::LEGS>(st,U,buf,ss,sU,in,out);	\
+    return;								\
+  }
+
 NAMESPACE_BEGIN(Grid);
 
 
 #ifdef SYCL_HACK
+#undef  HAND_LINK
+#define HAND_LINK(A) U[sU](A)
 template<class Impl> accelerator_inline void 
 WilsonKernels<Impl>::HandDhopSiteSycl(StencilVector st_perm,StencilEntry *st_p, SiteDoubledGaugeField *U,SiteHalfSpinor  *buf,
 				      int ss,int sU,const SiteSpinor *in, SiteSpinor *out)
@@ -577,12 +592,15 @@ WilsonKernels<Impl>::HandDhopSiteSycl(StencilVector st_perm,StencilEntry *st_p,
   HAND_STENCIL_LEG(TP_PROJ,0,Tm,TP_RECON_ACCUM);
   HAND_RESULT(ss);
 }
+#undef  HAND_LINK
+#define HAND_LINK(A) Impl::loadLink(U[sU],A,SE,st)
 #endif
 
 template<class Impl> accelerator_inline void 
 WilsonKernels<Impl>::HandDhopSite(StencilView &st, DoubledGaugeFieldView &U,SiteHalfSpinor  *buf,
 				  int ss,int sU,const FermionFieldView &in, FermionFieldView &out)
 {
+  HAND_UNROLL_OTHER_NC(0,LegsAll);
   auto st_p = st._entries_p;						
   auto st_perm = st._permute_type;					
 // T==0, Z==1, Y==2, Z==3 expect 1,2,2,2 simd layout etc...
@@ -611,6 +629,7 @@ template<class Impl>  accelerator_inline
 void WilsonKernels<Impl>::HandDhopSiteDag(StencilView &st,DoubledGaugeFieldView &U,SiteHalfSpinor *buf,
 					  int ss,int sU,const FermionFieldView &in, FermionFieldView &out)
 {
+  HAND_UNROLL_OTHER_NC(1,LegsAll);
   auto st_p = st._entries_p;						
   auto st_perm = st._permute_type;					
   typedef typename Simd::scalar_type S;
@@ -638,6 +657,7 @@ template<class Impl>  accelerator_inline void
 WilsonKernels<Impl>::HandDhopSiteInt(StencilView &st,DoubledGaugeFieldView &U,SiteHalfSpinor  *buf,
 					  int ss,int sU,const FermionFieldView &in, FermionFieldView &out)
 {
+  HAND_UNROLL_OTHER_NC(0,LegsInterior);
   //  auto st_p = st._entries_p;						
   //  auto st_perm = st._permute_type;					
 // T==0, Z==1, Y==2, Z==3 expect 1,2,2,2 simd layout etc...
@@ -667,6 +687,7 @@ template<class Impl> accelerator_inline
 void WilsonKernels<Impl>::HandDhopSiteDagInt(StencilView &st,DoubledGaugeFieldView &U,SiteHalfSpinor *buf,
 						  int ss,int sU,const FermionFieldView &in, FermionFieldView &out)
 {
+  HAND_UNROLL_OTHER_NC(1,LegsInterior);
   //  auto st_p = st._entries_p;						
   //  auto st_perm = st._permute_type;					
   typedef typename Simd::scalar_type S;
@@ -695,6 +716,7 @@ template<class Impl>  accelerator_inline void
 WilsonKernels<Impl>::HandDhopSiteExt(StencilView &st,DoubledGaugeFieldView &U,SiteHalfSpinor  *buf,
 					  int ss,int sU,const FermionFieldView &in, FermionFieldView &out)
 {
+  HAND_UNROLL_OTHER_NC(0,LegsExterior);
   //  auto st_p = st._entries_p;						
   //  auto st_perm = st._permute_type;					
 // T==0, Z==1, Y==2, Z==3 expect 1,2,2,2 simd layout etc...
@@ -726,6 +748,7 @@ template<class Impl>  accelerator_inline
 void WilsonKernels<Impl>::HandDhopSiteDagExt(StencilView &st,DoubledGaugeFieldView &U,SiteHalfSpinor *buf,
 						  int ss,int sU,const FermionFieldView &in, FermionFieldView &out)
 {
+  HAND_UNROLL_OTHER_NC(1,LegsExterior);
   //  auto st_p = st._entries_p;						
   //  auto st_perm = st._permute_type;					
   typedef typename Simd::scalar_type S;
@@ -752,12 +775,39 @@ void WilsonKernels<Impl>::HandDhopSiteDagExt(StencilView &st,DoubledGaugeFieldVi
   HAND_RESULT_EXT(ss);
 }
 
+// Without a flavour twist there is nothing to separate; G-parity specialises these
+template<class Impl>  accelerator_inline
+void WilsonKernels<Impl>::HandDhopSiteBulk(StencilView &st,DoubledGaugeFieldView &U,SiteHalfSpinor *buf,
+					   int ss,int sU,const FermionFieldView &in, FermionFieldView &out)
+{
+  HandDhopSite(st,U,buf,ss,sU,in,out);
+}
+template<class Impl>  accelerator_inline
+void WilsonKernels<Impl>::HandDhopSiteDagBulk(StencilView &st,DoubledGaugeFieldView &U,SiteHalfSpinor *buf,
+					      int ss,int sU,const FermionFieldView &in, FermionFieldView &out)
+{
+  HandDhopSiteDag(st,U,buf,ss,sU,in,out);
+}
+template<class Impl>  accelerator_inline
+void WilsonKernels<Impl>::HandDhopSiteIntBulk(StencilView &st,DoubledGaugeFieldView &U,SiteHalfSpinor *buf,
+					      int ss,int sU,const FermionFieldView &in, FermionFieldView &out)
+{
+  HandDhopSiteInt(st,U,buf,ss,sU,in,out);
+}
+template<class Impl>  accelerator_inline
+void WilsonKernels<Impl>::HandDhopSiteDagIntBulk(StencilView &st,DoubledGaugeFieldView &U,SiteHalfSpinor *buf,
+						 int ss,int sU,const FermionFieldView &in, FermionFieldView &out)
+{
+  HandDhopSiteDagInt(st,U,buf,ss,sU,in,out);
+}
+
 ////////////// Wilson ; uses this implementation /////////////////////
 
 NAMESPACE_END(Grid);
 #undef LOAD_CHIMU  
 #undef LOAD_CHI 
 #undef MULT_2SPIN
+#undef HAND_LINK
 #undef PERMUTE_DIR
 #undef XP_PROJ  
 #undef YP_PROJ  
@@ -797,3 +847,4 @@ NAMESPACE_END(Grid);
 #undef HAND_RESULT_INT
 #undef HAND_RESULT_EXT
 #undef HAND_DECLARATIONS
+#undef HAND_UNROLL_OTHER_NC
@@ -440,6 +440,55 @@ void WilsonKernels<Impl>::DhopDirKernel( StencilImpl &st, DoubledGaugeField &U,S
 
 #define KERNEL_CALL(A) KERNEL_CALLNB(A); accelerator_barrier();
 
+////////////////////////////////////////////////////////////////////////
+// Exterior only pass: on CPU visit just the stencil surface_list, the 4d
+// sites with at least one off node leg, so the post comms work scales
+// with the surface. GPU keeps the full volume launch.
+////////////////////////////////////////////////////////////////////////
+#if defined(GRID_CUDA) || defined(GRID_HIP) || defined(GRID_SYCL)
+#define KERNEL_CALL_EXT(A) KERNEL_CALL(A)
+#define ASM_CALL_EXT(A)    ASM_CALL(A)
+#else
+#define KERNEL_CALL_EXT(A)						\
+  const uint64_t    NN = st.surface_list.size()*Ls;			\
+  const int *surf = st.surface_list.data();				\
+  thread_for( ss, NN, {							\
+      int sU = surf[ss/Ls];						\
+      int sF = sU*Ls + ss%Ls;						\
+      WilsonKernels<Impl>::A(st_v,U_v,buf,sF,sU,in_v,out_v);		\
+  });
+
+#define ASM_CALL_EXT(A)							\
+  const int *surf = st.surface_list.data();				\
+  thread_for( ss, st.surface_list.size(), {				\
+    int sU = surf[ss];							\
+    int sF = sU*Ls;							\
+    WilsonKernels<Impl>::A(st_v,U_v,buf,sF,sU,Ls,1,in_v,out_v);		\
+  });
+#endif
+
+// Pass over a list of 4d sites, all Ls slices of each
+#define KERNEL_CALL_LIST(A,list)					\
+  {									\
+    const uint64_t    NN = list.size()*Ls;				\
+    const int *sites = list.data();					\
+    accelerator_forNB( ss, NN, Simd::Nsimd(), {				\
+	int sU = sites[ss/Ls];						\
+	int sF = sU*Ls + ss%Ls;						\
+	WilsonKernels<Impl>::A(st_v,U_v,buf,sF,sU,in_v,out_v);		\
+      });								\
+  }
+
+////////////////////////////////////////////////////////////////////////
+// G-parity: only the sites on st.twist_list need the flavour twist, the
+// bulk goes through the plain two flavour kernel, the twisted boundary
+// sites follow as a separate pass
+////////////////////////////////////////////////////////////////////////
+#define KERNEL_CALL_GPARITY(A)						\
+  KERNEL_CALL_LIST(A##Bulk,st.bulk_list);				\
+  KERNEL_CALL_LIST(A,st.twist_list);					\
+  accelerator_barrier();
+
 #define ASM_CALL(A)							\
   thread_for( ss, Nsite, {						\
     int sU = ss;							\
@@ -457,7 +506,11 @@ void WilsonKernels<Impl>::DhopKernel(int Opt,StencilImpl &st,  DoubledGaugeField
     autoView(out_v,out,AcceleratorWrite);
     autoView(st_v , st,AcceleratorRead);
 
+   int gparity = Impl::isGparity && (Opt == WilsonKernelsStatic::OptHandUnroll)
+     && (st.bulk_list.size()+st.twist_list.size()==Nsite);
+
    if( interior && exterior ) {
+     if (gparity) { KERNEL_CALL_GPARITY(HandDhopSite); return;}
      if (Opt == WilsonKernelsStatic::OptGeneric    ) { KERNEL_CALL(GenericDhopSite); return;}
 #ifdef SYCL_HACK     
      if (Opt == WilsonKernelsStatic::OptHandUnroll ) { KERNEL_CALL_TMP(HandDhopSiteSycl);    return; }
@@ -468,16 +521,17 @@ void WilsonKernels<Impl>::DhopKernel(int Opt,StencilImpl &st,  DoubledGaugeField
      if (Opt == WilsonKernelsStatic::OptInlineAsm  ) {  ASM_CALL(AsmDhopSite);    return;}
 #endif
    } else if( interior ) {
+     if (gparity) { KERNEL_CALL_GPARITY(HandDhopSiteInt); return;}
      if (Opt == WilsonKernelsStatic::OptGeneric    ) { KERNEL_CALLNB(GenericDhopSiteInt); return;}
      if (Opt == WilsonKernelsStatic::OptHandUnroll ) { KERNEL_CALLNB(HandDhopSiteInt);    return;}
 #ifndef GRID_CUDA
      if (Opt == WilsonKernelsStatic::OptInlineAsm  ) {  ASM_CALL(AsmDhopSiteInt);    return;}
 #endif
    } else if( exterior ) {
-     if (Opt == WilsonKernelsStatic::OptGeneric    ) { KERNEL_CALL(GenericDhopSiteExt); return;}
-     if (Opt == WilsonKernelsStatic::OptHandUnroll ) { KERNEL_CALL(HandDhopSiteExt);    return;}
+     if (Opt == WilsonKernelsStatic::OptGeneric    ) { KERNEL_CALL_EXT(GenericDhopSiteExt); return;}
+     if (Opt == WilsonKernelsStatic::OptHandUnroll ) { KERNEL_CALL_EXT(HandDhopSiteExt);    return;}
 #ifndef GRID_CUDA
-     if (Opt == WilsonKernelsStatic::OptInlineAsm  ) {  ASM_CALL(AsmDhopSiteExt);    return;}
+     if (Opt == WilsonKernelsStatic::OptInlineAsm  ) {  ASM_CALL_EXT(AsmDhopSiteExt);    return;}
 #endif
    }
    assert(0 && " Kernel optimisation case not covered ");
@@ -492,7 +546,11 @@ void WilsonKernels<Impl>::DhopKernel(int Opt,StencilImpl &st,  DoubledGaugeField
     autoView(out_v,out,AcceleratorWrite);
     autoView(st_v ,st,AcceleratorRead);
 
+   int gparity = Impl::isGparity && (Opt == WilsonKernelsStatic::OptHandUnroll)
+     && (st.bulk_list.size()+st.twist_list.size()==Nsite);
+
    if( interior && exterior ) {
+     if (gparity) { KERNEL_CALL_GPARITY(HandDhopSiteDag); return;}
      if (Opt == WilsonKernelsStatic::OptGeneric    ) { KERNEL_CALL(GenericDhopSiteDag); return;}
      if (Opt == WilsonKernelsStatic::OptHandUnroll ) { KERNEL_CALL(HandDhopSiteDag);    return;}
 #ifndef GRID_CUDA
@@ -500,6 +558,7 @@ void WilsonKernels<Impl>::DhopKernel(int Opt,StencilImpl &st,  DoubledGaugeField
 #endif
      acceleratorFenceComputeStream();
    } else if( interior ) {
+     if (gparity) { KERNEL_CALL_GPARITY(HandDhopSiteDagInt); return;}
      if (Opt == WilsonKernelsStatic::OptGeneric    ) { KERNEL_CALL(GenericDhopSiteDagInt); return;}
      if (Opt == WilsonKernelsStatic::OptHandUnroll ) { KERNEL_CALL(HandDhopSiteDagInt);    return;}
 #ifndef GRID_CUDA
@@ -507,18 +566,45 @@ void WilsonKernels<Impl>::DhopKernel(int Opt,StencilImpl &st,  DoubledGaugeField
 #endif
    } else if( exterior ) {
      acceleratorFenceComputeStream();
-     if (Opt == WilsonKernelsStatic::OptGeneric    ) { KERNEL_CALL(GenericDhopSiteDagExt); return;}
-     if (Opt == WilsonKernelsStatic::OptHandUnroll ) { KERNEL_CALL(HandDhopSiteDagExt);    return;}
+     if (Opt == WilsonKernelsStatic::OptGeneric    ) { KERNEL_CALL_EXT(GenericDhopSiteDagExt); return;}
+     if (Opt == WilsonKernelsStatic::OptHandUnroll ) { KERNEL_CALL_EXT(HandDhopSiteDagExt);    return;}
 #ifndef GRID_CUDA
-     if (Opt == WilsonKernelsStatic::OptInlineAsm  ) {  ASM_CALL(AsmDhopSiteDagExt);     return;}
+     if (Opt == WilsonKernelsStatic::OptInlineAsm  ) {  ASM_CALL_EXT(AsmDhopSiteDagExt);     return;}
 #endif
      acceleratorFenceComputeStream();
    }
    assert(0 && " Kernel optimisation case not covered ");
   }
 
+template <class Impl>
+void WilsonKernels<Impl>::DhopSiteColumn(int Opt,int dag,StencilView &st, DoubledGaugeFieldView &U, SiteHalfSpinor * buf,
+					 int Ls, int sU, const FermionFieldView &in, FermionFieldView &out)
+{
+  int sF = sU*Ls;
+#ifndef GRID_CUDA
+  if (Opt == WilsonKernelsStatic::OptInlineAsm ) {
+    if ( dag == DaggerYes ) AsmDhopSiteDag(st,U,buf,sF,sU,Ls,1,in,out);
+    else                    AsmDhopSite   (st,U,buf,sF,sU,Ls,1,in,out);
+    return;
+  }
+#endif
+  for(int s=0;s<Ls;s++){
+    if (Opt == WilsonKernelsStatic::OptHandUnroll ) {
+      if ( dag == DaggerYes ) HandDhopSiteDag(st,U,buf,sF+s,sU,in,out);
+      else                    HandDhopSite   (st,U,buf,sF+s,sU,in,out);
+    } else {
+      if ( dag == DaggerYes ) GenericDhopSiteDag(st,U,buf,sF+s,sU,in,out);
+      else                    GenericDhopSite   (st,U,buf,sF+s,sU,in,out);
+    }
+  }
+}
+
 #undef KERNEL_CALLNB
 #undef KERNEL_CALL
 #undef ASM_CALL
+#undef KERNEL_CALL_EXT
+#undef ASM_CALL_EXT
+#undef KERNEL_CALL_LIST
+#undef KERNEL_CALL_GPARITY
 
 NAMESPACE_END(Grid);
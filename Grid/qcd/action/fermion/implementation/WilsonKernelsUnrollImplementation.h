@@ -0,0 +1,224 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./lib/qcd/action/fermion/implementation/WilsonKernelsUnrollImplementation.h
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+*************************************************************************************/
+/*  END LEGAL */
+#pragma once
+
+#include <Grid/qcd/action/fermion/FermionCore.h>
+
+NAMESPACE_BEGIN(Grid);
+
+///////////////////////////////////////////////////////////////////////////////////////
+// Hand unrolled Wilson kernel for any colour dimension (Nc != 3 fundamental, adjoint,
+// two index representations). The same structure as WilsonKernelsHand, with the
+// colour loops expanded at compile time: the projected half spinor and the result
+// are held in Simt registers, and each link element is loaded once and applied to
+// both spin components of the half spinor.
+///////////////////////////////////////////////////////////////////////////////////////
+
+// f(0) ... f(N-1) as N separate inlined calls with constant index
+template<int N> struct WilsonUnroll {
+  template<class F> static accelerator_inline void loop(const F &f) { WilsonUnroll<N-1>::loop(f); f(N-1); }
+};
+template<> struct WilsonUnroll<0> {
+  template<class F> static accelerator_inline void loop(const F &f) { }
+};
+
+// Phases appearing in the spin projectors: +1, -1, +i, -i
+enum { UnrollPlus, UnrollMinus, UnrollTimesI, UnrollTimesMinusI };
+
+template<int C> struct WilsonUnrollPhase;
+template<> struct WilsonUnrollPhase<UnrollPlus> {
+  enum { conj = UnrollPlus };
+  template<class S> static accelerator_inline void accum(S &r,const S &a) { r = r + a; }
+};
+template<> struct WilsonUnrollPhase<UnrollMinus> {
+  enum { conj = UnrollMinus };
+  template<class S> static accelerator_inline void accum(S &r,const S &a) { r = r - a; }
+};
+template<> struct WilsonUnrollPhase<UnrollTimesI> {
+  enum { conj = UnrollTimesMinusI };
+  template<class S> static accelerator_inline void accum(S &r,const S &a) { r = r + timesI(a); }
+};
+template<> struct WilsonUnrollPhase<UnrollTimesMinusI> {
+  enum { conj = UnrollTimesI };
+  template<class S> static accelerator_inline void accum(S &r,const S &a) { r = r - timesI(a); }
+};
+
+// Projector 1 -/+ gamma_mu in the chiral basis:
+//   chi_0 = psi_0 + c0 psi_p0 ,  chi_1 = psi_1 + c1 psi_p1
+// and its reconstruction
+//   psi_0 += chi_0, psi_1 += chi_1, psi_p0 += conj(c0) chi_0, psi_p1 += conj(c1) chi_1
+// (the XP_PROJ ... TM_RECON_ACCUM macros of WilsonKernelsHand).
+enum { UnrollXp, UnrollYp, UnrollZp, UnrollTp, UnrollXm, UnrollYm, UnrollZm, UnrollTm };
+
+template<int P> struct WilsonUnrollSpin;
+#define WILSON_UNROLL_SPIN(P,P0,C0,P1,C1)			\
+  template<> struct WilsonUnrollSpin<P> {			\
+    enum { p0 = P0, c0 = C0, p1 = P1, c1 = C1 };		\
+  };
+WILSON_UNROLL_SPIN(UnrollXp,3,UnrollTimesI     ,2,UnrollTimesI);
+WILSON_UNROLL_SPIN(UnrollYp,3,UnrollMinus      ,2,UnrollPlus);
+WILSON_UNROLL_SPIN(UnrollZp,2,UnrollTimesI     ,3,UnrollTimesMinusI);
+WILSON_UNROLL_SPIN(UnrollTp,2,UnrollPlus       ,3,UnrollPlus);
+WILSON_UNROLL_SPIN(UnrollXm,3,UnrollTimesMinusI,2,UnrollTimesMinusI);
+WILSON_UNROLL_SPIN(UnrollYm,3,UnrollPlus       ,2,UnrollMinus);
+WILSON_UNROLL_SPIN(UnrollZm,2,UnrollTimesMinusI,3,UnrollTimesI);
+WILSON_UNROLL_SPIN(UnrollTm,2,UnrollMinus      ,3,UnrollMinus);
+#undef WILSON_UNROLL_SPIN
+
+template<class Impl> class WilsonKernelsUnroll {
+public:
+  INHERIT_IMPL_TYPES(Impl);
+
+  static const int Dim = Impl::Dimension;
+  typedef decltype(coalescedRead(std::declval<SiteSpinor>()()(0)(0))) Simt;
+
+  enum { LegsAll, LegsInterior, LegsExterior };
+
+  // One stencil leg: project (or take the halo half spinor), multiply by the link
+  // and reconstruct into result
+  template<int Proj,int Perm,int Legs>
+  static accelerator_inline void Leg(StencilView &st, DoubledGaugeFieldView &U, SiteHalfSpinor *buf,
+				     int ss, int sU, const FermionFieldView &in,
+				     Simt result[Ns][Dim], int Dir)
+  {
+    typedef WilsonUnrollSpin<Proj> Spin;
+    typedef WilsonUnrollPhase<Spin::c0> Phase0;
+    typedef WilsonUnrollPhase<Spin::c1> Phase1;
+    typedef WilsonUnrollPhase<Phase0::conj> Recon0;
+    typedef WilsonUnrollPhase<Phase1::conj> Recon1;
+
+    const int Nsimd = SiteHalfSpinor::Nsimd();
+    const int lane  = acceleratorSIMTlane(Nsimd);
+
+    int ptype;
+    StencilEntry *SE = st.GetEntry(ptype,Dir,ss);
+    auto offset = SE->_offset;
+    auto local  = SE->_is_local;
+    auto perm   = SE->_permute;
+
+    bool halo = !local && ( Legs!=LegsInterior || st.same_node[Dir] );
+    bool use  = local || halo;
+    if ( Legs==LegsExterior ) use = halo = !local && !st.same_node[Dir];
+
+    Simt chi[2][Dim];
+    if ( local && Legs!=LegsExterior ) {
+      const SiteSpinor &ref(in[offset]);
+      WilsonUnroll<Dim>::loop([&](int c) {
+#ifdef GRID_SIMT
+	chi[0][c] = coalescedReadPermute<Perm>(ref()(0)(c),perm,lane);
+	chi[1][c] = coalescedReadPermute<Perm>(ref()(1)(c),perm,lane);
+	Phase0::accum(chi[0][c],coalescedReadPermute<Perm>(ref()(Spin::p0)(c),perm,lane));
+	Phase1::accum(chi[1][c],coalescedReadPermute<Perm>(ref()(Spin::p1)(c),perm,lane));
+#else
+	chi[0][c] = ref()(0)(c);
+	chi[1][c] = ref()(1)(c);
+	Phase0::accum(chi[0][c],ref()(Spin::p0)(c));
+	Phase1::accum(chi[1][c],ref()(Spin::p1)(c));
+	if ( perm ) {
+	  permute(chi[0][c],chi[0][c],Perm);
+	  permute(chi[1][c],chi[1][c],Perm);
+	}
+#endif
+      });
+    } else if ( halo ) {
+      const SiteHalfSpinor &ref(buf[offset]);
+      WilsonUnroll<Dim>::loop([&](int c) {
+	chi[0][c] = coalescedRead(ref()(0)(c),lane);
+	chi[1][c] = coalescedRead(ref()(1)(c),lane);
+      });
+    }
+    acceleratorSynchronise();
+    if ( !use ) return;
+
+    // link row by row: the half spinor stays in registers, each row of U chi is
+    // reconstructed into the result as soon as it is complete
+    const auto & link(Impl::loadLink(U[sU],Dir,SE,st));
+    WilsonUnroll<Dim>::loop([&](int a) {
+      Simt u = coalescedRead(link()(a,0),lane);
+      Simt Uchi_0 = u*chi[0][0];
+      Simt Uchi_1 = u*chi[1][0];
+      WilsonUnroll<Dim-1>::loop([&](int bm) {
+	const int b = bm+1;
+	Simt ub = coalescedRead(link()(a,b),lane);
+	Uchi_0 = Uchi_0 + ub*chi[0][b];
+	Uchi_1 = Uchi_1 + ub*chi[1][b];
+      });
+      result[0][a] = result[0][a] + Uchi_0;
+      result[1][a] = result[1][a] + Uchi_1;
+      Recon0::accum(result[Spin::p0][a],Uchi_0);
+      Recon1::accum(result[Spin::p1][a],Uchi_1);
+    });
+  }
+
+  template<int Dag,int Legs>
+  static accelerator_inline void DhopSite(StencilView &st, DoubledGaugeFieldView &U, SiteHalfSpinor *buf,
+					  int ss, int sU, const FermionFieldView &in, FermionFieldView &out)
+  {
+    const int Nsimd = SiteHalfSpinor::Nsimd();
+    const int lane  = acceleratorSIMTlane(Nsimd);
+
+    Simt result[Ns][Dim];
+    WilsonUnroll<Dim>::loop([&](int c) {
+      zeroit(result[0][c]); zeroit(result[1][c]);
+      zeroit(result[2][c]); zeroit(result[3][c]);
+    });
+
+    if ( Dag ) {
+      Leg<UnrollXp,3,Legs>(st,U,buf,ss,sU,in,result,Xp);
+      Leg<UnrollYp,2,Legs>(st,U,buf,ss,sU,in,result,Yp);
+      Leg<UnrollZp,1,Legs>(st,U,buf,ss,sU,in,result,Zp);
+      Leg<UnrollTp,0,Legs>(st,U,buf,ss,sU,in,result,Tp);
+      Leg<UnrollXm,3,Legs>(st,U,buf,ss,sU,in,result,Xm);
+      Leg<UnrollYm,2,Legs>(st,U,buf,ss,sU,in,result,Ym);
+      Leg<UnrollZm,1,Legs>(st,U,buf,ss,sU,in,result,Zm);
+      Leg<UnrollTm,0,Legs>(st,U,buf,ss,sU,in,result,Tm);
+    } else {
+      Leg<UnrollXm,3,Legs>(st,U,buf,ss,sU,in,result,Xp);
+      Leg<UnrollYm,2,Legs>(st,U,buf,ss,sU,in,result,Yp);
+      Leg<UnrollZm,1,Legs>(st,U,buf,ss,sU,in,result,Zp);
+      Leg<UnrollTm,0,Legs>(st,U,buf,ss,sU,in,result,Tp);
+      Leg<UnrollXp,3,Legs>(st,U,buf,ss,sU,in,result,Xm);
+      Leg<UnrollYp,2,Legs>(st,U,buf,ss,sU,in,result,Ym);
+      Leg<UnrollZp,1,Legs>(st,U,buf,ss,sU,in,result,Zm);
+      Leg<UnrollTp,0,Legs>(st,U,buf,ss,sU,in,result,Tm);
+    }
+
+    SiteSpinor &ref(out[ss]);
+    if ( Legs==LegsExterior ) {
+      WilsonUnroll<Dim>::loop([&](int c) {
+	for(int s=0;s<Ns;s++) coalescedWrite(ref()(s)(c),coalescedRead(ref()(s)(c))+result[s][c],lane);
+      });
+    } else {
+      WilsonUnroll<Dim>::loop([&](int c) {
+	for(int s=0;s<Ns;s++) coalescedWrite(ref()(s)(c),result[s][c],lane);
+      });
+    }
+  }
+};
+
+NAMESPACE_END(Grid);
@@ -0,0 +1 @@
+#define IMPLEMENTATION CompressedLinkWilsonImplD
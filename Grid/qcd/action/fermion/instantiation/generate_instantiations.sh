@@ -32,7 +32,15 @@ GDWF_IMPL_LIST=" \
 	   GparityWilsonImplF \
 	   GparityWilsonImplD "
 
-IMPL_LIST="$STAG_IMPL_LIST  $WILSON_IMPL_LIST $DWF_IMPL_LIST $GDWF_IMPL_LIST"
+COMPRESSED_IMPL_LIST=" \
+	   CompressedLinkWilsonImplF \
+	   CompressedLinkWilsonImplD "
+
+TWIST_IMPL_LIST=" \
+	   TwistPhaseWilsonImplF \
+	   TwistPhaseWilsonImplD "
+
+IMPL_LIST="$STAG_IMPL_LIST  $WILSON_IMPL_LIST $DWF_IMPL_LIST $GDWF_IMPL_LIST $COMPRESSED_IMPL_LIST $TWIST_IMPL_LIST"
 
 for impl in $IMPL_LIST
 do
@@ -87,6 +95,20 @@ do
   ln -f -s ../WilsonKernelsInstantiationGparity.cc.master $impl/WilsonKernelsInstantiation$impl.cc
 done
 
+CC_LIST=" \
+  CayleyFermion5DInstantiation \
+  WilsonFermion5DInstantiation \
+  WilsonFermionInstantiation \
+  WilsonKernelsInstantiation "
+
+for impl in $COMPRESSED_IMPL_LIST $TWIST_IMPL_LIST
+do
+for f in $CC_LIST
+do
+  ln -f -s ../$f.cc.master $impl/$f$impl.cc
+done
+done
+
 
 CC_LIST=" \
   ImprovedStaggeredFermion5DInstantiation \
@@ -267,6 +267,8 @@ public:
 
   RegisterLoadCheckPointerFunction(Binary);
   RegisterLoadCheckPointerFunction(Nersc);
+  RegisterLoadCheckPointerFunction(AsyncBinary);
+  RegisterLoadCheckPointerFunction(AsyncNersc);
 #ifdef HAVE_LIME
   RegisterLoadCheckPointerFunction(ILDG);
   RegisterLoadCheckPointerMetadataFunction(Scidac);
@@ -40,6 +40,9 @@ directory
 #include <Grid/parallelIO/IldgIO.h>
 #include <Grid/parallelIO/NerscIO.h>
 #include <Grid/parallelIO/OpenQcdIO.h>
+#ifdef HAVE_HDF5
+#include <Grid/parallelIO/Hdf5ParallelIO.h>
+#endif
 #if !defined(GRID_COMMS_NONE)
 #include <Grid/parallelIO/OpenQcdIOChromaReference.h>
 #endif
@@ -0,0 +1,108 @@
+/*************************************************************************************
+
+Grid physics library, www.github.com/paboyle/Grid
+
+Source file: ./lib/qcd/hmc/AsyncCheckpointWriter.h
+
+Copyright (C) 2015
+
+Author: Guido Cossu <guido.cossu@ed.ac.uk>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+See the full license in the file "LICENSE" in the top level distribution
+directory
+*************************************************************************************/
+			   /*  END LEGAL */
+#ifndef ASYNC_CHECKPOINT_WRITER
+#define ASYNC_CHECKPOINT_WRITER
+
+#include <thread>
+
+NAMESPACE_BEGIN(Grid);
+
+//////////////////////////////////////////////////////////////////////////////
+// Drains staged checkpoint files (BinaryIO::StagedObject) on a background
+// thread while the next trajectory runs. The staging is collective and done by
+// the caller; the drain uses no MPI, so this works with MPI_THREAD_SERIALIZED.
+// A failed drain is reported, and the job aborted, by Wait on the main thread.
+// One checkpoint is in flight at a time: a new one, a restore or the
+// destructor waits for the previous drain to finish.
+//////////////////////////////////////////////////////////////////////////////
+class AsyncCheckpointWriter {
+private:
+  std::thread io;
+  std::vector<BinaryIO::StagedObject> staged;
+  GridStopWatch drain;
+  uint64_t drained;
+  std::string error;   // first failure of the drain, empty if none
+
+public:
+  ~AsyncCheckpointWriter() { Wait(); }
+
+  void Wait(void) {
+    if ( io.joinable() ) {
+      GridStopWatch timer;
+      timer.Start();
+      io.join();
+      timer.Stop();
+      if ( !error.empty() ) {
+	std::cout << GridLogError << "AsyncCheckpointWriter: " << error << std::endl;
+#ifdef USE_MPI_IO
+	MPI_Abort(MPI_COMM_WORLD,1);
+#else
+	exit(1);
+#endif
+      }
+      std::cout << GridLogMessage << "AsyncCheckpointWriter: drained " << drained << " bytes per rank in "
+		<< drain.Elapsed() << ", waited " << timer.Elapsed() << std::endl;
+    }
+  }
+
+  // Buffers for the next checkpoint, once the previous drain is done
+  std::vector<BinaryIO::StagedObject> &Stage(int n) {
+    Wait();
+    staged.resize(n);
+    return staged;
+  }
+
+  // Collective: the files have been created by the boss
+  void Launch(GridBase *grid) {
+    grid->Barrier();
+    io = std::thread([this] {
+      drain.Reset();
+      drain.Start();
+      drained = 0;
+      error.clear();
+      for(auto &s : staged) {
+	if ( error.empty() && BinaryIO::writeStagedObject(s,error) ) {
+	  drained += s.data.size() + s.tail.size();
+	}
+	s = BinaryIO::StagedObject(); // the staging copy is not held between checkpoints
+      }
+      drain.Stop();
+    });
+  }
+
+  // Collective: every rank's drain is complete
+  void Sync(GridBase *grid) {
+    Wait();
+    grid->Barrier();
+  }
+};
+
+NAMESPACE_END(Grid);
+
+#endif
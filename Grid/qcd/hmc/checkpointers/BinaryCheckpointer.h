@@ -36,10 +36,13 @@ directory
 NAMESPACE_BEGIN(Grid);
 
 // Simple checkpointer, only binary file
+// With async the files are written by a background thread (AsyncCheckpointWriter)
 template <class Impl>
 class BinaryHmcCheckpointer : public BaseHmcCheckpointer<Impl> {
 private:
   CheckpointerParameters Params;
+  bool async;
+  AsyncCheckpointWriter writer;
 
 public:
   INHERIT_FIELD_TYPES(Impl);  // Gets the Field type, a Lattice object
@@ -50,7 +53,7 @@ public:
   typedef typename getPrecision<sobj>::real_scalar_type sobj_stype;
   typedef typename sobj::DoublePrecision sobj_double;
 
-  BinaryHmcCheckpointer(const CheckpointerParameters &Params_) {
+  BinaryHmcCheckpointer(const CheckpointerParameters &Params_, bool async_ = false) : async(async_) {
     initialize(Params_);
   }
 
@@ -72,6 +75,25 @@ public:
       uint32_t scidac_csumb;
       
       BinarySimpleUnmunger<sobj_double, sobj> munge;
+      if ( async ) {
+	GridBase *grid = U.Grid();
+	auto &staged = writer.Stage(2);
+	if ( grid->IsBoss() ) {
+	  truncate(rng);
+	  truncate(config);
+	}
+	BinaryIO::stageRNG(staged[0], sRNG, pRNG, rng, 0,nersc_csum,scidac_csuma,scidac_csumb);
+	BinaryIO::stageLatticeObject<vobj, sobj_double>(staged[1], U, config, munge, 0, Params.format,
+							nersc_csum,scidac_csuma,scidac_csumb);
+	writer.Launch(grid);
+	std::cout << GridLogMessage << "Staged Binary Configuration " << config
+		  << " checksum " << std::hex 
+		  << nersc_csum   <<"/"
+		  << scidac_csuma   <<"/"
+		  << scidac_csumb 
+		  << std::dec << std::endl;
+	return;
+      }
       truncate(rng);
       BinaryIO::writeRNG(sRNG, pRNG, rng, 0,nersc_csum,scidac_csuma,scidac_csumb);
       truncate(config);
@@ -91,6 +113,7 @@ public:
 
   void CheckpointRestore(int traj, Field &U, GridSerialRNG &sRNG, GridParallelRNG &pRNG) {
     std::string config, rng;
+    writer.Sync(U.Grid());
     this->build_filenames(traj, Params, config, rng);
     this->check_filename(rng);
     this->check_filename(config);
@@ -113,6 +113,32 @@ class NerscCPModule: public CheckPointerModule< ImplementationPolicy> {
 };
 
 
+// Files written on a background thread while the next trajectory runs
+template<class ImplementationPolicy>
+class AsyncBinaryCPModule: public CheckPointerModule< ImplementationPolicy> {
+  typedef CheckPointerModule< ImplementationPolicy> CPBase;
+  using CPBase::CPBase; // for constructors
+
+  // acquire resource
+  virtual void initialize(){
+    this->CheckPointPtr.reset(new BinaryHmcCheckpointer<ImplementationPolicy>(this->Par_,true));
+  }
+
+};
+
+template<class ImplementationPolicy>
+class AsyncNerscCPModule: public CheckPointerModule< ImplementationPolicy> {
+  typedef CheckPointerModule< ImplementationPolicy> CPBase;
+  using CPBase::CPBase; // for constructors
+
+  // acquire resource
+  virtual void initialize(){
+    this->CheckPointPtr.reset(new NerscHmcCheckpointer<ImplementationPolicy>(this->Par_,true));
+  }
+
+};
+
+
 #ifdef HAVE_LIME
   
 template<class ImplementationPolicy>
@@ -36,16 +36,19 @@ directory
 NAMESPACE_BEGIN(Grid);
 
 // Only for Gauge fields
+// With async the files are written by a background thread (AsyncCheckpointWriter)
 template <class Gimpl>
 class NerscHmcCheckpointer : public BaseHmcCheckpointer<Gimpl> {
 private:
   CheckpointerParameters Params;
+  bool async;
+  AsyncCheckpointWriter writer;
 
 public:
   INHERIT_GIMPL_TYPES(Gimpl);  // only for gauge configurations
   typedef GaugeStatistics<Gimpl> GaugeStats;
   
-  NerscHmcCheckpointer(const CheckpointerParameters &Params_) { initialize(Params_); }
+  NerscHmcCheckpointer(const CheckpointerParameters &Params_, bool async_ = false) : async(async_) { initialize(Params_); }
 
   void initialize(const CheckpointerParameters &Params_) {
     Params = Params_;
@@ -60,14 +63,22 @@ public:
 
       int precision32 = 1;
       int tworow = 0;
-      NerscIO::writeRNGState(sRNG, pRNG, rng);
-      NerscIO::writeConfiguration<GaugeStats>(U, config, tworow, precision32);
+      if ( async ) {
+	auto &staged = writer.Stage(2);
+	NerscIO::stageRNGState(staged[0], sRNG, pRNG, rng);
+	NerscIO::stageConfiguration<GaugeStats>(staged[1], U, config, tworow, precision32);
+	writer.Launch(U.Grid());
+      } else {
+	NerscIO::writeRNGState(sRNG, pRNG, rng);
+	NerscIO::writeConfiguration<GaugeStats>(U, config, tworow, precision32);
+      }
     }
   };
 
   void CheckpointRestore(int traj, GaugeField &U, GridSerialRNG &sRNG,
                          GridParallelRNG &pRNG) {
     std::string config, rng;
+    writer.Sync(U.Grid());
     this->build_filenames(traj, Params, config, rng);
     this->check_filename(rng);
     this->check_filename(config);
@@ -113,6 +113,8 @@ static Registrar<PlaquetteMod<ImplementationPolicy>, HMC_ObservablesModuleFactor
 
 static Registrar<BinaryCPModule<ImplementationPolicy>, HMC_CPModuleFactory<cp_string, ImplementationPolicy, Serialiser> > __CPBinarymodXMLInit("Binary");
 static Registrar<NerscCPModule<ImplementationPolicy> , HMC_CPModuleFactory<cp_string, ImplementationPolicy, Serialiser> > __CPNerscmodXMLInit("Nersc");
+static Registrar<AsyncBinaryCPModule<ImplementationPolicy>, HMC_CPModuleFactory<cp_string, ImplementationPolicy, Serialiser> > __CPAsyncBinarymodXMLInit("AsyncBinary");
+static Registrar<AsyncNerscCPModule<ImplementationPolicy> , HMC_CPModuleFactory<cp_string, ImplementationPolicy, Serialiser> > __CPAsyncNerscmodXMLInit("AsyncNersc");
 
 #ifdef HAVE_LIME
 static Registrar<ILDGCPModule<ImplementationPolicy>  , HMC_CPModuleFactory<cp_string, ImplementationPolicy, Serialiser> > __CPILDGmodXMLInit("ILDG");
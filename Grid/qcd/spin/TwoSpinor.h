@@ -978,5 +978,27 @@ template<class vtype,int N,IfNotCoarsened<iScalar<vtype> > = 0> accelerator_inli
     }}
 }
 
+////////
+// 5 join
+////////
+// Full spinor from its two chiral halves, spProj5p and spProj5m inverted without the factor of two in spRecon5
+template<class vtype,IfSpinor<iVector<vtype,Ns> > = 0> accelerator_inline void spJoin5 (iVector<vtype,Ns> &fspin,const iVector<vtype,Nhs> &hp,const iVector<vtype,Nhs> &hm)
+{
+  fspin(0)=hp(0);
+  fspin(1)=hp(1);
+  fspin(2)=hm(0);
+  fspin(3)=hm(1);
+}
+template<class rtype,class vtype> accelerator_inline void spJoin5 (iScalar<rtype> &fspin,const iScalar<vtype> &hp,const iScalar<vtype> &hm)
+{
+  spJoin5(fspin._internal,hp._internal,hm._internal);
+}
+template<class rtype,class vtype,int N,IfNotSpinor<iVector<vtype,N> > = 0> accelerator_inline void spJoin5 (iVector<rtype,N> &fspin,const iVector<vtype,N> &hp,const iVector<vtype,N> &hm)
+{
+  for(int i=0;i<N;i++) {
+    spJoin5(fspin._internal[i],hp._internal[i],hm._internal[i]);
+  }
+}
+
 NAMESPACE_END(Grid);
 #endif
@@ -638,6 +638,8 @@ public:
   // FIXME Explicit Ls in interface is a pain. Should just use a vol
   void BuildSurfaceList(int Ls,int vol4){
 
+    surface_list.resize(0);
+
     // find same node for SHM
     // Here we know the distance is 1 for WilsonStencil
     for(int point=0;point<this->_npoints;point++){
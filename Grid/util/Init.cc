@@ -453,12 +453,22 @@ void Grid_init(int *argc,char ***argv)
     std::cout<<GridLogMessage<<"  --comms-overlap    : Overlap comms with compute "<<std::endl;    
     std::cout<<GridLogMessage<<std::endl;
     std::cout<<GridLogMessage<<"  --dslash-generic: Wilson kernel for generic Nc"<<std::endl;    
-    std::cout<<GridLogMessage<<"  --dslash-unroll : Wilson kernel for Nc=3"<<std::endl;    
+    std::cout<<GridLogMessage<<"  --dslash-unroll : Wilson kernel unrolled (by hand for Nc=3, at compile time otherwise)"<<std::endl;    
     std::cout<<GridLogMessage<<"  --dslash-asm    : Wilson kernel for AVX512"<<std::endl;    
+    std::cout<<GridLogMessage<<"  --dslash-fused  : Staggered kernel with fat and Naik links in one pass, links shared across Ls"<<std::endl;    
+    std::cout<<GridLogMessage<<"  --dslash-autotune : time kernel and comms choices per Wilson operator and cache the fastest"<<std::endl;    
+    std::cout<<GridLogMessage<<"  --dslash-tune-cache file : autotune cache (default grid_dslash_tune.txt)"<<std::endl;    
     std::cout<<GridLogMessage<<std::endl;
     std::cout<<GridLogMessage<<"  --lebesgue      : Cache oblivious Lebesgue curve/Morton order/Z-graph stencil looping"<<std::endl;    
     std::cout<<GridLogMessage<<"  --cacheblocking n.m.o.p : Hypercuboidal cache blocking"<<std::endl;    
     std::cout<<GridLogMessage<<std::endl;
+    std::cout<<GridLogMessage<<"  --io-chunk M    : lattice file I/O in slabs of at most M megabytes per rank; 0 for the whole local volume"<<std::endl;    
+    std::cout<<GridLogMessage<<"  --io-aggregators N : lexicographic file I/O through N aggregator ranks (e.g. one per node) instead of MPI-IO"<<std::endl;    
+    std::cout<<GridLogMessage<<"  --io-stripe K   : aggregator file domains aligned to K kilobytes; match the file system stripe"<<std::endl;    
+    std::cout<<GridLogMessage<<"  --io-mmap       : read lattice files through a memory mapping, without intermediate buffers"<<std::endl;    
+    std::cout<<GridLogMessage<<"  --io-verify full|sampled|none : check lattice writes by re-reading every chunk, a random sample, or not at all"<<std::endl;    
+    std::cout<<GridLogMessage<<"  --io-verify-fraction f : fraction of the chunks re-read by sampled verification (default 0.05)"<<std::endl;    
+    std::cout<<GridLogMessage<<std::endl;
     exit(EXIT_SUCCESS);
   }
 
@@ -474,10 +484,19 @@ void Grid_init(int *argc,char ***argv)
     WilsonKernelsStatic::Opt=WilsonKernelsStatic::OptInlineAsm;
     StaggeredKernelsStatic::Opt=StaggeredKernelsStatic::OptInlineAsm;
   }
+  if( GridCmdOptionExists(*argv,*argv+*argc,"--dslash-fused") ){
+    StaggeredKernelsStatic::Opt=StaggeredKernelsStatic::OptFused;
+  }
   if( GridCmdOptionExists(*argv,*argv+*argc,"--dslash-generic") ){
     WilsonKernelsStatic::Opt=WilsonKernelsStatic::OptGeneric;
     StaggeredKernelsStatic::Opt=StaggeredKernelsStatic::OptGeneric;
   }
+  if( GridCmdOptionExists(*argv,*argv+*argc,"--dslash-autotune") ){
+    DslashTuner::Enabled=1;
+  }
+  if( GridCmdOptionExists(*argv,*argv+*argc,"--dslash-tune-cache") ){
+    DslashTuner::CacheFile=GridCmdOptionPayload(*argv,*argv+*argc,"--dslash-tune-cache");
+  }
   if( GridCmdOptionExists(*argv,*argv+*argc,"--comms-overlap") ){
     WilsonKernelsStatic::Comms = WilsonKernelsStatic::CommsAndCompute;
     StaggeredKernelsStatic::Comms = StaggeredKernelsStatic::CommsAndCompute;
@@ -507,6 +526,45 @@ void Grid_init(int *argc,char ***argv)
     arg= GridCmdOptionPayload(*argv,*argv+*argc,"--cacheblocking");
     GridCmdOptionIntVector(arg,LebesgueOrder::Block);
   }
+  if( GridCmdOptionExists(*argv,*argv+*argc,"--io-chunk") ){
+    int MB;
+    arg= GridCmdOptionPayload(*argv,*argv+*argc,"--io-chunk");
+    GridCmdOptionInt(arg,MB);
+    uint64_t MB64 = MB;
+    BinaryIO::latticeIOChunkBytes = MB64*1024LL*1024LL;
+  }
+  if( GridCmdOptionExists(*argv,*argv+*argc,"--io-aggregators") ){
+    arg= GridCmdOptionPayload(*argv,*argv+*argc,"--io-aggregators");
+    GridCmdOptionInt(arg,BinaryIO::ioAggregators);
+  }
+  if( GridCmdOptionExists(*argv,*argv+*argc,"--io-stripe") ){
+    int KB;
+    arg= GridCmdOptionPayload(*argv,*argv+*argc,"--io-stripe");
+    GridCmdOptionInt(arg,KB);
+    assert(KB > 0);
+    uint64_t KB64 = KB;
+    BinaryIO::ioStripeBytes = KB64*1024LL;
+  }
+  if( GridCmdOptionExists(*argv,*argv+*argc,"--io-mmap") ){
+    BinaryIO::latticeReadMapped = true;
+  }
+  if( GridCmdOptionExists(*argv,*argv+*argc,"--io-verify") ){
+    arg= GridCmdOptionPayload(*argv,*argv+*argc,"--io-verify");
+    if      ( arg == "full"    ) BinaryIO::latticeWriteVerify = BinaryIO::VerifyFull;
+    else if ( arg == "sampled" ) BinaryIO::latticeWriteVerify = BinaryIO::VerifySampled;
+    else if ( arg == "none"    ) BinaryIO::latticeWriteVerify = BinaryIO::VerifyNone;
+    else assert(0);
+    if ( BinaryIO::latticeWriteVerify != BinaryIO::VerifyNone ) {
+      BinaryIO::latticeWriteMaxRetry = std::max(BinaryIO::latticeWriteMaxRetry,0);
+    }
+  }
+  if( GridCmdOptionExists(*argv,*argv+*argc,"--io-verify-fraction") ){
+    float f;
+    arg= GridCmdOptionPayload(*argv,*argv+*argc,"--io-verify-fraction");
+    GridCmdOptionFloat(arg,f);
+    assert(f>0.0 && f<=1.0);
+    BinaryIO::latticeWriteVerifyFraction = f;
+  }
   if( GridCmdOptionExists(*argv,*argv+*argc,"--notimestamp") ){
     GridLogTimestamp(0);
   } else {
@@ -12,9 +12,69 @@
 #define BENCH_IO_NPASS 10
 #endif
 
-#ifdef HAVE_LIME
 using namespace Grid;
 
+///////////////////////////////////////////////////////////////////////////////
+// BinaryIO byte order and checksum kernels on a site buffer in memory: zlib
+// against table crc32, and the separate passes against the fused pass.
+///////////////////////////////////////////////////////////////////////////////
+template <typename fobj>
+void checksumBenchmark(GridBase *grid, const std::string &name, const int npass = 5)
+{
+  uint64_t          lsites = grid->lSites();
+  uint64_t          bytes  = lsites*sizeof(fobj);
+  std::vector<fobj> buf(lsites);
+  unsigned char     *c = (unsigned char *)&buf[0];
+  std::vector<uint32_t> zcrc(lsites), tcrc(lsites);
+  uint32_t          n, a, b;
+  GridStopWatch     zlib, table, split, fused;
+
+  for (uint64_t i = 0; i < bytes; ++i) c[i] = (i*2654435761ULL) >> 13;
+  for (int p = 0; p < npass; ++p)
+  {
+    zlib.Start();
+    thread_for(s, lsites, { zcrc[s] = crc32(0, (unsigned char *)&buf[s], sizeof(fobj)); });
+    zlib.Stop();
+    table.Start();
+    thread_for(s, lsites, { tcrc[s] = Grid_crc32((unsigned char *)&buf[s], sizeof(fobj)); });
+    table.Stop();
+    assert(zcrc == tcrc);
+
+    split.Start();
+    n = a = b = 0;
+    BinaryIO::ScidacChecksum(grid, buf, a, b);
+    BinaryIO::be64toh_v((void *)&buf[0], bytes);
+    BinaryIO::NerscChecksum(grid, buf, n);
+    split.Stop();
+    fused.Start();
+    n = a = b = 0;
+    BinaryIO::ConvertChecksum(grid, buf, "IEEE64BIG", false, n, a, b);
+    fused.Stop();
+  }
+  auto gbs = [&](GridStopWatch &w) { return npass*bytes/1.0e3/w.useconds(); };
+  MSG << name << " (" << sizeof(fobj) << " bytes/site) crc32 zlib "
+      << gbs(zlib) << " GB/s, table " << gbs(table) << " GB/s" << std::endl;
+  MSG << name << " (" << sizeof(fobj) << " bytes/site) byte order + checksums: three passes "
+      << gbs(split) << " GB/s, fused " << gbs(fused) << " GB/s" << std::endl;
+}
+
+void checksumBenchmarks(const int l)
+{
+  auto mpi  = GridDefaultMpi();
+  std::vector<int> latt = {l*mpi[0], l*mpi[1], l*mpi[2], l*mpi[3]};
+  std::shared_ptr<GridCartesian> grid(SpaceTimeGrid::makeFourDimGrid(latt,
+                                      GridDefaultSimd(Nd, vComplex::Nsimd()), mpi));
+
+  MSG << SEP << std::endl;
+  MSG << "Benchmark BinaryIO byte order and checksum kernels, local volume " << l << "^4" << std::endl;
+  MSG << SEP << std::endl;
+  checksumBenchmark<LorentzColour2x3F>(grid.get(), "Gauge 2x3 single");
+  checksumBenchmark<SpinColourVectorD>(grid.get(), "Fermion double   ");
+  checksumBenchmark<LorentzColourMatrixD>(grid.get(), "Gauge double     ");
+}
+
+#ifdef HAVE_LIME
+
 std::string filestem(const int l)
 {
   return "iobench_l" + std::to_string(l);
@@ -72,6 +132,7 @@ int main (int argc, char ** argv)
 
   MSG << "Grid is setup to use " << threads << " threads" << std::endl;
   MSG << "MPI partition " << mpi << std::endl;
+  checksumBenchmarks(16);
   for (unsigned int i = 0; i < BENCH_IO_NPASS; ++i)
   {
     MSG << BIGSEP << std::endl;
@@ -197,5 +258,12 @@ int main (int argc, char ** argv)
   return EXIT_SUCCESS;
 }
 #else
-int main(int argc,char ** argv){}
+int main(int argc,char ** argv)
+{
+  Grid_init(&argc,&argv);
+  checksumBenchmarks(16);
+  Grid_finalize();
+
+  return EXIT_SUCCESS;
+}
 #endif
@@ -332,6 +332,44 @@ int main (int argc, char ** argv)
     std::cout<<GridLogMessage << "Deo mflop/s per node   "<< flops/(t1-t0)/NN<<std::endl;
     Dw.Report();
   }
+
+  if ( GridCmdOptionExists(argv,argv+argc,"--interior-exterior") ) {
+    ////////////////////////////////////////////////////////////////////
+    // Overlapped comms: interior kernel over the volume while comms are
+    // in flight, exterior kernel over the surface sites only afterwards
+    ////////////////////////////////////////////////////////////////////
+    int comms = WilsonKernelsStatic::Comms;
+    WilsonKernelsStatic::Comms = WilsonKernelsStatic::CommsAndCompute;
+
+    std::cout << GridLogMessage<< "*********************************************************" <<std::endl;
+    std::cout << GridLogMessage<< "* Benchmarking DomainWallFermionR::DhopEO interior vs exterior " <<std::endl;
+    std::cout << GridLogMessage<< "*********************************************************" <<std::endl;
+    Dw.DhopEO(src_o,r_e,DaggerNo);
+    Dw.ZeroCounters();
+    FGrid->Barrier();
+    for(int i=0;i<ncall;i++){
+      Dw.DhopEO(src_o,r_e,DaggerNo);
+    }
+    FGrid->Barrier();
+
+    RealD surface = Dw.StencilOdd.surface_list.size();
+    RealD vol4    = UrbGrid->oSites();
+    std::cout<<GridLogMessage << "Surface sites "<< surface <<" of "<< vol4 <<" ("<< 100.0*surface/vol4<<"%)"<<std::endl;
+    std::cout<<GridLogMessage << "Interior us/call "<< Dw.DhopComputeTime /Dw.DhopCalls<<std::endl;
+    std::cout<<GridLogMessage << "Exterior us/call "<< Dw.DhopComputeTime2/Dw.DhopCalls<<std::endl;
+    std::cout<<GridLogMessage << "Comms    us/call "<< Dw.DhopCommTime    /Dw.DhopCalls<<std::endl;
+    std::cout<<GridLogMessage << "Face     us/call "<< Dw.DhopFaceTime    /Dw.DhopCalls<<std::endl;
+
+    LatticeFermion r_seq(FrbGrid);
+    LatticeFermion r_err(FrbGrid);
+    WilsonKernelsStatic::Comms = WilsonKernelsStatic::CommsThenCompute;
+    Dw.DhopEO(src_o,r_seq,DaggerNo);
+    r_err = r_e - r_seq;
+    std::cout<<GridLogMessage << "overlapped vs sequential norm diff "<< norm2(r_err)<<std::endl;
+    assert(norm2(r_err)<1.0e-4);
+
+    WilsonKernelsStatic::Comms = comms;
+  }
   Dw.DhopEO(src_o,r_e,DaggerNo);
   Dw.DhopOE(src_e,r_o,DaggerNo);
   Dw.Dhop  (src  ,result,DaggerNo);
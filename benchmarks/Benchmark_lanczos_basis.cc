@@ -0,0 +1,148 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./benchmarks/Benchmark_lanczos_basis.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+////////////////////////////////////////////////////////////////////////
+// basisRotate and basisOrthogonalize as used in the IRL restart and
+// reorthogonalisation, scanned in Nm. Single precision basis storage is
+// the same kernels instantiated on LatticeFermionF.
+////////////////////////////////////////////////////////////////////////
+template<class Field>
+void BenchmarkBasis(GridBase *grid,std::vector<int> Nms,int Nloop)
+{
+  typedef typename Field::scalar_object sobj;
+  typedef typename getPrecision<sobj>::real_scalar_type Word;
+
+  double vol   = grid->gSites();
+  double fbytes= vol*sizeof(sobj);
+  double words = vol*sizeof(sobj)/sizeof(Word);
+
+  GridParallelRNG RNG(grid);
+  RNG.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+
+  std::cout<<GridLogMessage << "  Nm  "<<"\t"<<"kernel"<<"\t\t"<<"GB/s"<<"\t\t"<<"Gflop/s"<<"\t\t"<<"ms/call"<<std::endl;
+  std::cout<<GridLogMessage << "----------------------------------------------------------"<<std::endl;
+
+  for(auto Nm : Nms){
+
+    std::vector<Field> basis(Nm,grid);
+    for(int i=0;i<Nm;i++){
+      gaussian(RNG,basis[i]);
+      basisOrthogonalize(basis,basis[i],i);
+      basis[i] = basis[i]*(1.0/std::sqrt(norm2(basis[i])));
+    }
+
+    Eigen::MatrixXd Qt = Eigen::MatrixXd::Identity(Nm,Nm);
+    for(int j=0;j<Nm;j++){
+      for(int k=0;k<Nm;k++){
+	Qt(j,k) += 1.0e-3*((j*Nm+k)%7);
+      }
+    }
+
+    ////////////////////////////////////////
+    // Check the tiled rotation
+    ////////////////////////////////////////
+    {
+      std::vector<Field> ref(Nm,grid);
+      for(int j=0;j<Nm;j++) basisRotateJ(ref[j],basis,Qt,j,0,Nm,Nm);
+      std::vector<Field> rot(basis);
+      basisRotate(rot,Qt,0,Nm,0,Nm,Nm);
+      Field diff(grid);
+      RealD err=0.0;
+      for(int j=0;j<Nm;j++){
+	diff = rot[j]-ref[j];
+	err += norm2(diff)/norm2(ref[j]);
+      }
+      std::cout<<GridLogMessage << "basisRotate check relative error "<<err<<std::endl;
+    }
+
+    ////////////////////////////////////////
+    // Rotation: read Nm, write Nm
+    ////////////////////////////////////////
+    double start=usecond();
+    for(int i=0;i<Nloop;i++){
+      basisRotate(basis,Qt,0,Nm,0,Nm,Nm);
+    }
+    double stop=usecond();
+    double time = (stop-start)/Nloop;
+    double bytes= 2.0*Nm*fbytes;
+    double flops= 2.0*Nm*Nm*words;
+    std::cout<<GridLogMessage<<std::setprecision(3) << Nm<<"\t"<<"rotate"<<"\t\t"
+	     <<bytes/time/1000.<<"\t\t"<<flops/time/1000.<<"\t\t"<<time/1000.<<std::endl;
+
+    ////////////////////////////////////////
+    // Orthogonalise against Nm-1 : read basis twice, w twice, write w
+    ////////////////////////////////////////
+    for(int i=0;i<Nm;i++) basis[i] = basis[i]*(1.0/std::sqrt(norm2(basis[i])));
+    Field w(grid);
+    gaussian(RNG,w);
+    start=usecond();
+    for(int i=0;i<Nloop;i++){
+      basisOrthogonalize(basis,w,Nm-1);
+    }
+    stop=usecond();
+    time = (stop-start)/Nloop;
+    bytes= (2.0*(Nm-1)+3.0)*fbytes;
+    flops= 2.0*4.0*(Nm-1)*words;
+    std::cout<<GridLogMessage<<std::setprecision(3) << Nm<<"\t"<<"orthog"<<"\t\t"
+	     <<bytes/time/1000.<<"\t\t"<<flops/time/1000.<<"\t\t"<<time/1000.<<std::endl;
+  }
+}
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  int threads = GridThread::GetThreads();
+  std::cout<<GridLogMessage << "Grid is setup to use "<<threads<<" threads"<<std::endl;
+
+  GridCartesian *UGrid = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(),
+							 GridDefaultSimd(Nd,vComplex::Nsimd()),
+							 GridDefaultMpi());
+  GridCartesian *UGridF = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(),
+							  GridDefaultSimd(Nd,vComplexF::Nsimd()),
+							  GridDefaultMpi());
+
+  std::vector<int> Nms({16,32,64,128});
+  int Nloop = 4;
+
+  std::cout<<GridLogMessage << "===================================================================================================="<<std::endl;
+  std::cout<<GridLogMessage << "= Benchmarking Lanczos basis kernels; double precision basis"<<std::endl;
+  std::cout<<GridLogMessage << "===================================================================================================="<<std::endl;
+  BenchmarkBasis<LatticeFermionD>(UGrid,Nms,Nloop);
+
+  std::cout<<GridLogMessage << "===================================================================================================="<<std::endl;
+  std::cout<<GridLogMessage << "= Benchmarking Lanczos basis kernels; single precision basis"<<std::endl;
+  std::cout<<GridLogMessage << "===================================================================================================="<<std::endl;
+  BenchmarkBasis<LatticeFermionF>(UGridF,Nms,Nloop);
+
+  Grid_finalize();
+}
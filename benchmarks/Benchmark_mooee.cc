@@ -153,5 +153,63 @@ int main (int argc, char ** argv)
 
   }
 
+  if (1)
+  {
+    const int ncall=200;
+
+    std::cout << GridLogMessage<< "*********************************************************" <<std::endl;
+    std::cout << GridLogMessage<< "* Ls sweep of MobiusFermionR fifth dimension operators"<<std::endl;
+    std::cout << GridLogMessage<< "*********************************************************" <<std::endl;
+
+    typedef LatticeFermion::vector_object vobj;
+    std::vector<int> Ls_list({8,12,16,24,32});
+    for(auto Lsx : Ls_list){
+
+      GridCartesian         * FGridx   = SpaceTimeGrid::makeFiveDimGrid(Lsx,UGrid);
+      GridRedBlackCartesian * FrbGridx = SpaceTimeGrid::makeFiveDimRedBlackGrid(Lsx,UGrid);
+
+      GridParallelRNG RNG5(FGridx); RNG5.SeedFixedIntegers(seeds5);
+      LatticeFermion src(FGridx); random(RNG5,src);
+      LatticeFermion src_o(FrbGridx);
+      LatticeFermion r_o  (FrbGridx);
+      LatticeFermion chk  (FrbGridx);
+      pickCheckerboard(Odd,src_o,src);
+
+      MobiusFermionR Dmob(Umu,*FGridx,*FrbGridx,*UGrid,*UrbGrid,mass,M5,1.5,0.5);
+
+      // Mooee MooeeInv = 1 and MooeeDag MooeeInvDag = 1
+      Dmob.MooeeInv(src_o,r_o);    Dmob.Mooee(r_o,chk);    chk = chk - src_o;
+      RealD err    = norm2(chk)/norm2(src_o);
+      Dmob.MooeeInvDag(src_o,r_o); Dmob.MooeeDag(r_o,chk); chk = chk - src_o;
+      RealD errdag = norm2(chk)/norm2(src_o);
+      assert(err    < 1.0e-20);
+      assert(errdag < 1.0e-20);
+
+      // read psi, write chi
+      double bytes = 2.0*sizeof(vobj)*FrbGridx->oSites()*FrbGridx->_Nprocessors;
+      double t0,t1;
+
+#define BENCH_LS(A)							\
+      FGridx->Barrier();						\
+      t0=usecond();							\
+      for(int i=0;i<ncall;i++){						\
+	Dmob. A (src_o,r_o);						\
+      }									\
+      t1=usecond();							\
+      FGridx->Barrier();						\
+      std::cout<<GridLogMessage << "Ls "<<Lsx<<" " #A " \t"<< (t1-t0)/ncall<<" us "\
+	       << bytes*ncall/(t1-t0)/1000.<<" GB/s"<<std::endl;
+
+      BENCH_LS(Mooee);
+      BENCH_LS(MooeeInv);
+      BENCH_LS(MooeeInvDag);
+#undef BENCH_LS
+      std::cout<<GridLogMessage << "Ls "<<Lsx<<" |Mooee MooeeInv - 1|^2 "<<err<<" dag "<<errdag<<std::endl;
+
+      delete FrbGridx;
+      delete FGridx;
+    }
+  }
+
   Grid_finalize();
 }
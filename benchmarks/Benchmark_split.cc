@@ -0,0 +1,117 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./benchmarks/Benchmark_split.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+////////////////////////////////////////////////////////////////////////
+// Grid_split / Grid_unsplit of one LatticeFermion per subcommunicator,
+// single AllToAllv against the per dimension path. Split layout from
+// --split (default 1.1.1.1: one source per rank).
+////////////////////////////////////////////////////////////////////////
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  Coordinate simd_layout = GridDefaultSimd(Nd,vComplexD::Nsimd());
+  Coordinate mpi_layout  = GridDefaultMpi();
+  Coordinate mpi_split (Nd,1);
+  if( GridCmdOptionExists(argv,argv+argc,"--split") ){
+    std::string arg = GridCmdOptionPayload(argv,argv+argc,"--split");
+    GridCmdOptionIntVector(arg,mpi_split);
+  }
+  int threads = GridThread::GetThreads();
+  std::cout<<GridLogMessage << "Grid is setup to use "<<threads<<" threads"<<std::endl;
+
+  const int Ls    = 8;
+  const int Nloop = 10;
+  int maxlat=16;
+
+  std::cout<<GridLogMessage << "===================================================================================================="<<std::endl;
+  std::cout<<GridLogMessage << "= Benchmarking Grid_split/Grid_unsplit of Ls="<<Ls<<" fermions onto split "<<mpi_split<<std::endl;
+  std::cout<<GridLogMessage << "===================================================================================================="<<std::endl;
+  std::cout<<GridLogMessage << " L  "<<"\t"<<"Nvec"<<"\t"<<"MB/rank"<<"\t\t"
+	   <<"dimwise split/unsplit ms"<<"\t"<<"alltoallv split/unsplit ms"<<std::endl;
+
+  for(int lat=4;lat<=maxlat;lat+=4){
+
+    Coordinate latt_size  ({lat*mpi_layout[0],
+			    lat*mpi_layout[1],
+			    lat*mpi_layout[2],
+			    lat*mpi_layout[3]});
+
+    GridCartesian         * UGrid = SpaceTimeGrid::makeFourDimGrid(latt_size,simd_layout,mpi_layout);
+    GridCartesian         * FGrid = SpaceTimeGrid::makeFiveDimGrid(Ls,UGrid);
+    int me;
+    GridCartesian         * SGrid = new GridCartesian(latt_size,simd_layout,mpi_split,*UGrid,me);
+    GridCartesian         * SFGrid= SpaceTimeGrid::makeFiveDimGrid(Ls,SGrid);
+
+    int nvec = UGrid->_Nprocessors/SGrid->_Nprocessors;
+
+    GridParallelRNG RNG(FGrid); RNG.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+    std::vector<LatticeFermion> full(nvec,FGrid);
+    std::vector<LatticeFermion> back(nvec,FGrid);
+    for(int v=0;v<nvec;v++) random(RNG,full[v]);
+    LatticeFermion s_ref(SFGrid);
+    LatticeFermion s_new(SFGrid);
+
+    // First call builds the cached index map; check agreement with the reference
+    Grid_split_dimwise(full,s_ref);
+    Grid_split(full,s_new);
+    s_ref = s_ref - s_new;
+    assert(norm2(s_ref)==0.0);
+
+    double t0=usecond();
+    for(int i=0;i<Nloop;i++) Grid_split_dimwise(full,s_ref);
+    double t1=usecond();
+    for(int i=0;i<Nloop;i++) Grid_unsplit_dimwise(back,s_ref);
+    double t2=usecond();
+    for(int i=0;i<Nloop;i++) Grid_split(full,s_new);
+    double t3=usecond();
+    for(int i=0;i<Nloop;i++) Grid_unsplit(back,s_new);
+    double t4=usecond();
+
+    for(int v=0;v<nvec;v++){
+      back[v] = back[v] - full[v];
+      assert(norm2(back[v])==0.0);
+    }
+
+    double MB = 1.0e-6*nvec*FGrid->lSites()*sizeof(SpinColourVector);
+    std::cout<<GridLogMessage << lat<<"\t"<<nvec<<"\t"<<MB<<"\t\t"
+	     <<(t1-t0)/Nloop/1000.<<" / "<<(t2-t1)/Nloop/1000.<<"\t\t"
+	     <<(t3-t2)/Nloop/1000.<<" / "<<(t4-t3)/Nloop/1000.<<std::endl;
+
+    delete SFGrid;
+    delete SGrid;
+    delete FGrid;
+    delete UGrid;
+  }
+
+  Grid_finalize();
+}
@@ -95,18 +95,65 @@ int main (int argc, char ** argv)
   RealD u0=1.0;
   ImprovedStaggeredFermionR Ds(Umu,Umu,Grid,RBGrid,mass,c1,c2,u0,params);
   
-  std::cout<<GridLogMessage << "Calling Ds"<<std::endl;
   int ncall=1000;
-  double t0=usecond();
-  for(int i=0;i<ncall;i++){
-    Ds.Dhop(src,result,0);
-  }
-  double t1=usecond();
   double flops=(16*(3*(6+8+8)) + 15*3*2)*volume*ncall; // == 66*16 +  == 1146
-  
-  std::cout<<GridLogMessage << "Called Ds"<<std::endl;
-  std::cout<<GridLogMessage << "norm result "<< norm2(result)<<std::endl;
-  std::cout<<GridLogMessage << "mflop/s =   "<< flops/(t1-t0)<<std::endl;
+
+  std::vector<int> opts({StaggeredKernelsStatic::OptGeneric,
+			 StaggeredKernelsStatic::OptHandUnroll,
+			 StaggeredKernelsStatic::OptFused});
+  std::vector<std::string> names({"Generic","HandUnroll","Fused"});
+
+  for(int o=0;o<opts.size();o++){
+    StaggeredKernelsStatic::Opt=opts[o];
+    std::cout<<GridLogMessage << "Calling Ds "<<names[o]<<std::endl;
+    double t0=usecond();
+    for(int i=0;i<ncall;i++){
+      Ds.Dhop(src,result,0);
+    }
+    double t1=usecond();
+    if ( o==0 ) ref = result;
+    err = ref - result;
+    std::cout<<GridLogMessage << "Called Ds "<<names[o]<<std::endl;
+    std::cout<<GridLogMessage << "norm result "<< norm2(result)<<" deviation from generic "<<norm2(err)<<std::endl;
+    std::cout<<GridLogMessage << "mflop/s =   "<< flops/(t1-t0)<<std::endl;
+  }
+
+  ////////////////////////////////////////////////////////////////
+  // 5d: Ls sources/masses share the links of each 4d site
+  ////////////////////////////////////////////////////////////////
+  int Ls=8;
+  if( GridCmdOptionExists(argv,argv+argc,"--Ls") ){
+    std::string arg = GridCmdOptionPayload(argv,argv+argc,"--Ls");
+    GridCmdOptionInt(arg,Ls);
+  }
+  GridCartesian         * FGrid   = SpaceTimeGrid::makeFiveDimGrid(Ls,&Grid);
+  GridRedBlackCartesian * FrbGrid = SpaceTimeGrid::makeFiveDimRedBlackGrid(Ls,&Grid);
+  GridParallelRNG          pRNG5(FGrid);
+  pRNG5.SeedFixedIntegers(seeds);
+
+  typedef typename ImprovedStaggeredFermion5DR::FermionField FermionField5;
+  FermionField5 src5   (FGrid); random(pRNG5,src5);
+  FermionField5 result5(FGrid); result5=Zero();
+  FermionField5    ref5(FGrid);    ref5=Zero();
+  FermionField5    err5(FGrid);    err5=Zero();
+
+  ImprovedStaggeredFermion5DR Ds5(Umu,Umu,*FGrid,*FrbGrid,Grid,RBGrid,mass,c1,c2,u0,params);
+
+  int ncall5=ncall/Ls+1;
+  double flops5=(16*(3*(6+8+8)) + 15*3*2)*volume*Ls*ncall5;
+  for(int o=0;o<opts.size();o++){
+    StaggeredKernelsStatic::Opt=opts[o];
+    std::cout<<GridLogMessage << "Calling Ds5 Ls="<<Ls<<" "<<names[o]<<std::endl;
+    double t0=usecond();
+    for(int i=0;i<ncall5;i++){
+      Ds5.Dhop(src5,result5,0);
+    }
+    double t1=usecond();
+    if ( o==0 ) ref5 = result5;
+    err5 = ref5 - result5;
+    std::cout<<GridLogMessage << "norm result "<< norm2(result5)<<" deviation from generic "<<norm2(err5)<<std::endl;
+    std::cout<<GridLogMessage << "mflop/s =   "<< flops5/(t1-t0)<<std::endl;
+  }
 
   Grid_finalize();
 }
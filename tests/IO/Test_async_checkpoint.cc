@@ -0,0 +1,118 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/IO/Test_async_checkpoint.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+std::vector<char> ReadFile(const std::string &file)
+{
+  std::ifstream fin(file,std::ios::binary);
+  return std::vector<char>((std::istreambuf_iterator<char>(fin)),std::istreambuf_iterator<char>());
+}
+
+// Same files from the synchronous and the background writer; restore from the latter
+template<class Checkpointer>
+void CheckAsync(const std::string &name,GridCartesian *UGrid,bool header)
+{
+  GridParallelRNG pRNG(UGrid); pRNG.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+  GridSerialRNG   sRNG;        sRNG.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+
+  LatticeGaugeField U(UGrid);
+  SU<Nc>::HotConfiguration(pRNG,U);
+
+  CheckpointerParameters sync_params (name+"_sync_cfg" ,name+"_sync_rng");
+  CheckpointerParameters async_params(name+"_async_cfg",name+"_async_rng");
+  Checkpointer Sync (sync_params);
+  Checkpointer Async(async_params,true);
+
+  const int ntraj=3;
+  std::vector<LatticeGaugeField> Us(ntraj+1,UGrid);
+  std::vector<std::vector<RealD> > draws(ntraj+1);
+  for(int traj=1;traj<=ntraj;traj++){
+    SU<Nc>::HotConfiguration(pRNG,U);
+    Sync.TrajectoryComplete (traj,U,sRNG,pRNG);
+    Async.TrajectoryComplete(traj,U,sRNG,pRNG);
+    Us[traj] = U;
+    // the trajectory moves on while the files drain
+    LatticeComplex eta(UGrid); gaussian(pRNG,eta);
+    RealD r; random(sRNG,r);
+    draws[traj] = std::vector<RealD>({norm2(eta),r});
+  }
+
+  GridParallelRNG pRNGr(UGrid);
+  GridSerialRNG   sRNGr;
+  LatticeGaugeField Ur(UGrid);
+  for(int traj=ntraj;traj>=1;traj--){
+    Async.CheckpointRestore(traj,Ur,sRNGr,pRNGr);
+    if ( UGrid->IsBoss() ) {
+      std::string sc,sr,ac,ar;
+      Sync.build_filenames (traj,sync_params ,sc,sr);
+      Async.build_filenames(traj,async_params,ac,ar);
+      std::vector<char> fs = ReadFile(sc), fa = ReadFile(ac);
+      // NERSC headers carry the creation time
+      if ( header ) {
+	fs.erase(fs.begin(),fs.end()-UGrid->gSites()*sizeof(LorentzColourMatrixD));
+	fa.erase(fa.begin(),fa.end()-UGrid->gSites()*sizeof(LorentzColourMatrixD));
+      } else {
+	// writeRNG appends the serial state once per rank, the staged write once
+	std::vector<char> rs = ReadFile(sr), ra = ReadFile(ar);
+	assert(rs.size()>=ra.size());
+	assert(std::equal(ra.begin(),ra.end(),rs.begin()));
+      }
+      assert(fs==fa);
+    }
+    LatticeGaugeField diff(UGrid);
+    diff = Ur - Us[traj];
+    LatticeComplex eta(UGrid); gaussian(pRNGr,eta);
+    RealD r; random(sRNGr,r);
+    std::cout<<GridLogMessage<<name<<" traj "<<traj<<" gauge diff "<<norm2(diff)
+	     <<" rng draws "<<norm2(eta)-draws[traj][0]<<" "<<r-draws[traj][1]<<std::endl;
+    assert(norm2(diff)<1.0e-20);
+    assert(norm2(eta)==draws[traj][0] && r==draws[traj][1]);
+  }
+}
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  GridCartesian * UGrid = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplex::Nsimd()),GridDefaultMpi());
+
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= Binary checkpoints drained in the background"<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  CheckAsync<BinaryHmcCheckpointer<PeriodicGimplR> >("ckpoint_binary",UGrid,false);
+
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= NERSC checkpoints drained in the background"<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  CheckAsync<NerscHmcCheckpointer<PeriodicGimplR> >("ckpoint_nersc",UGrid,true);
+
+  Grid_finalize();
+}
@@ -0,0 +1,131 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/IO/Test_binary_io_aggregate.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+std::vector<char> ReadFile(const std::string &file)
+{
+  std::ifstream fin(file,std::ios::binary);
+  return std::vector<char>((std::istreambuf_iterator<char>(fin)),std::istreambuf_iterator<char>());
+}
+
+// Run with several ranks, e.g. mpirun -np 4 ... --mpi 1.1.2.2
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+#ifdef USE_MPI_IO
+  const int Ls=4;
+  GridCartesian * UGrid = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplexD::Nsimd()),GridDefaultMpi());
+  GridCartesian * FGrid = SpaceTimeGrid::makeFiveDimGrid(Ls,UGrid);
+  int nrank = UGrid->ProcessorCount();
+
+  GridParallelRNG RNG5(FGrid);  RNG5.SeedFixedIntegers(std::vector<int>({5,6,7,8}));
+
+  typedef SpinColourVectorD   FermionD;
+  typedef vSpinColourVectorD vFermionD;
+
+  LatticeFermionD src(FGrid); random(RNG5,src);
+  LatticeFermionD res(FGrid);
+  LatticeFermionD diff(FGrid);
+
+  int      Lt    = FGrid->LocalDimensions()[FGrid->Nd()-1];
+  uint64_t slice = FGrid->lSites()/Lt;
+
+  // Aggregator counts, stripes down to a fraction of a site and slabbed volumes
+  std::vector<int>      aggregators({1,2,nrank,2*nrank});
+  std::vector<uint64_t> stripes({1024*1024,4096,1000});
+  std::vector<uint64_t> budgets({0,1});
+
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= Aggregated write and read against MPI-IO"<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  BinarySimpleMunger<FermionD,FermionD> munge;
+  uint32_t nersc_ref,scidaca_ref,scidacb_ref;
+  uint32_t nersc_csum,scidac_csuma,scidac_csumb;
+  std::vector<char> ref;
+  {
+    BinaryIO::ioAggregators = 0;
+    std::string file("./ckpoint_aggregate.ref");
+    BinaryIO::writeLatticeObject<vFermionD,FermionD>(src,file,munge,0,"IEEE64BIG",nersc_ref,scidaca_ref,scidacb_ref);
+    if ( FGrid->IsBoss() ) ref = ReadFile(file);
+  }
+  for(auto agg : aggregators){
+  for(auto stripe : stripes){
+  for(auto budget : budgets){
+    BinaryIO::ioAggregators       = agg;
+    BinaryIO::ioStripeBytes       = stripe;
+    BinaryIO::latticeIOChunkBytes = budget;
+    std::string file("./ckpoint_aggregate."+std::to_string(agg)+"."+std::to_string(stripe)+"."+std::to_string(budget));
+
+    BinaryIO::writeLatticeObject<vFermionD,FermionD>(src,file,munge,0,"IEEE64BIG",nersc_csum,scidac_csuma,scidac_csumb);
+    assert(nersc_csum==nersc_ref && scidac_csuma==scidaca_ref && scidac_csumb==scidacb_ref);
+    if ( FGrid->IsBoss() ) assert(ReadFile(file)==ref);
+
+    res = Zero();
+    BinaryIO::readLatticeObject<vFermionD,FermionD>(res,file,munge,0,"IEEE64BIG",nersc_csum,scidac_csuma,scidac_csumb);
+    assert(nersc_csum==nersc_ref && scidac_csuma==scidaca_ref && scidac_csumb==scidacb_ref);
+    diff = res - src;
+    std::cout<<GridLogMessage<<"aggregators "<<agg<<" stripe "<<stripe<<" budget "<<budget
+	     <<" read back diff "<<norm2(diff)<<std::endl;
+    assert(norm2(diff)==0.0);
+  }}}
+
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= Array behind a header, off the stripe boundaries"<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  {
+    BinaryIO::latticeIOChunkBytes = 256*1024*1024;
+    BinaryIO::ioStripeBytes       = 4096;
+    const uint64_t header = 1234;
+    std::vector<char> mpiio;
+    for(auto agg : std::vector<int>({0,2})){
+      BinaryIO::ioAggregators = agg;
+      std::string file("./ckpoint_aggregate.header."+std::to_string(agg));
+      if ( FGrid->IsBoss() ) {
+	std::ofstream fout(file,std::ios::binary);
+	fout << std::string(header,'#');
+      }
+      FGrid->Barrier();
+      BinaryIO::writeLatticeObject<vFermionD,FermionD>(src,file,munge,header,"IEEE64",nersc_csum,scidac_csuma,scidac_csumb);
+      res = Zero();
+      BinaryIO::readLatticeObject<vFermionD,FermionD>(res,file,munge,header,"IEEE64",nersc_csum,scidac_csuma,scidac_csumb);
+      diff = res - src;
+      std::cout<<GridLogMessage<<"aggregators "<<agg<<" header "<<header<<" read back diff "<<norm2(diff)<<std::endl;
+      assert(norm2(diff)==0.0);
+      if ( FGrid->IsBoss() ) {
+	if ( agg==0 ) mpiio = ReadFile(file);
+	else          assert(ReadFile(file)==mpiio);
+      }
+    }
+  }
+  BinaryIO::ioAggregators = 0;
+#endif
+  Grid_finalize();
+}
@@ -0,0 +1,183 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/IO/Test_binary_io_compressed.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+std::vector<char> ReadFile(const std::string &file)
+{
+  std::ifstream fin(file,std::ios::binary);
+  return std::vector<char>((std::istreambuf_iterator<char>(fin)),std::istreambuf_iterator<char>());
+}
+
+// Largest relative error of any real word
+template<class Field>
+RealD MaxRelError(const Field &a,const Field &b)
+{
+  typedef typename Field::vector_object::scalar_object sobj;
+  typedef typename sobj::Realified::scalar_type word;
+  std::vector<sobj> sa(a.Grid()->lSites()), sb(b.Grid()->lSites());
+  unvectorizeToLexOrdArray(sa,a);
+  unvectorizeToLexOrdArray(sb,b);
+  word *wa = (word *)&sa[0];
+  word *wb = (word *)&sb[0];
+  RealD err = 0.0;
+  for(uint64_t i=0;i<sa.size()*sizeof(sobj)/sizeof(word);i++){
+    if ( wa[i]!=0.0 ) err = std::max(err,(RealD)std::fabs((wa[i]-wb[i])/wa[i]));
+  }
+  a.Grid()->GlobalMax(err);
+  return err;
+}
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  const int Ls=8;
+  GridCartesian * UGrid = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplexD::Nsimd()),GridDefaultMpi());
+  GridCartesian * FGrid = SpaceTimeGrid::makeFiveDimGrid(Ls,UGrid);
+
+  GridParallelRNG RNG5(FGrid);  RNG5.SeedFixedIntegers(std::vector<int>({5,6,7,8}));
+  GridParallelRNG RNG4(UGrid);  RNG4.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+
+  typedef SpinColourVectorD   FermionD;
+  typedef vSpinColourVectorD vFermionD;
+  typedef SpinColourVectorF   FermionF;
+
+  LatticeFermionD src(FGrid); random(RNG5,src);
+  LatticeFermionD res(FGrid);
+  LatticeFermionD diff(FGrid);
+
+  int      Lt    = FGrid->LocalDimensions()[FGrid->Nd()-1];
+  uint64_t slice = FGrid->lSites()/Lt;
+
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= Lossless round trip, whole local volume and single slice chunks"<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::vector<uint64_t> chunks({4*1024*1024, 1, 2*slice*sizeof(FermionD)});
+  // Reader slabs of the whole volume, one slice, and three slices straddling two slice chunks
+  std::vector<uint64_t> budgets({0, 1, 3*slice*2*sizeof(FermionD)});
+  uint64_t lossless_bytes = 0;
+  for(int c=0;c<chunks.size();c++){
+    BinaryIO::latticeCompressChunkBytes = chunks[c];
+    BinarySimpleMunger<FermionD,FermionD> munge;
+    std::string file("./ckpoint_compressed."+std::to_string(c));
+    BinaryIO::writeLatticeCompressed<vFermionD,FermionD>(src,file,munge);
+    for(auto b : budgets){
+      BinaryIO::latticeIOChunkBytes = b;
+      res = Zero();
+      BinaryIO::readLatticeCompressed<vFermionD,FermionD>(res,file,munge);
+      diff = res - src;
+      std::cout<<GridLogMessage<<"chunk bytes "<<chunks[c]<<" read budget "<<b<<" read back diff "<<norm2(diff)<<std::endl;
+      assert(norm2(diff)==0.0);
+    }
+    BinaryIO::latticeIOChunkBytes = 0;
+    if ( FGrid->IsBoss() ) lossless_bytes = ReadFile(file).size();
+  }
+  BinaryIO::latticeCompressChunkBytes = 4*1024*1024;
+
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= Lossless single precision file"<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  {
+    BinarySimpleUnmunger<FermionF,FermionD> unmunge;
+    BinarySimpleMunger  <FermionF,FermionD> munge;
+    LatticeFermionD ref(FGrid);
+    std::string file("./ckpoint_compressed.F");
+    uint32_t nersc_csum,scidac_csuma,scidac_csumb;
+    BinaryIO::writeLatticeObject<vFermionD,FermionF>(src,file,unmunge,0,"IEEE32BIG",nersc_csum,scidac_csuma,scidac_csumb);
+    BinaryIO::readLatticeObject <vFermionD,FermionF>(ref,file,munge  ,0,"IEEE32BIG",nersc_csum,scidac_csuma,scidac_csumb);
+    BinaryIO::writeLatticeCompressed<vFermionD,FermionF>(src,file,unmunge);
+    BinaryIO::readLatticeCompressed <vFermionD,FermionF>(res,file,munge);
+    diff = res - ref;
+    std::cout<<GridLogMessage<<"single precision read back diff "<<norm2(diff)<<std::endl;
+    assert(norm2(diff)==0.0);
+  }
+
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= Lossy mantissa truncation within its error bound"<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  for(int bits : std::vector<int>({BinaryIO::CompressFP32,BinaryIO::CompressFP16,BinaryIO::CompressBF16,3})){
+    BinarySimpleMunger<FermionD,FermionD> munge;
+    std::string file("./ckpoint_compressed.lossy");
+    BinaryIO::writeLatticeCompressed<vFermionD,FermionD>(src,file,munge,bits);
+    BinaryIO::readLatticeCompressed <vFermionD,FermionD>(res,file,munge);
+    RealD err   = MaxRelError(src,res);
+    RealD bound = std::ldexp(1.0,-(bits+1));
+    std::cout<<GridLogMessage<<bits<<" mantissa bits max relative error "<<err<<" bound "<<bound<<std::endl;
+    assert(err <= bound);
+    if ( FGrid->IsBoss() ) assert(ReadFile(file).size() < lossless_bytes);
+  }
+
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= Truncation does not round past the largest finite value"<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  {
+    std::vector<float>  f({std::numeric_limits<float>::max(),-std::numeric_limits<float>::max(),
+			   std::numeric_limits<float>::infinity(),1.0f});
+    std::vector<double> d({std::numeric_limits<double>::max(),-std::numeric_limits<double>::max(),
+			   std::numeric_limits<double>::infinity(),1.0});
+    BinaryIO::truncateMantissa(&f[0],f.size()*sizeof(float) ,sizeof(float) ,BinaryIO::CompressBF16);
+    BinaryIO::truncateMantissa(&d[0],d.size()*sizeof(double),sizeof(double),BinaryIO::CompressFP16);
+    std::cout<<GridLogMessage<<"float "<<f[0]<<" "<<f[1]<<" "<<f[2]<<" double "<<d[0]<<" "<<d[1]<<" "<<d[2]<<std::endl;
+    assert(std::isfinite(f[0]) && std::isfinite(f[1]) && std::isinf(f[2]) && f[3]==1.0f);
+    assert(std::isfinite(d[0]) && std::isfinite(d[1]) && std::isinf(d[2]) && d[3]==1.0);
+    assert(f[0]==-f[1] && f[0] > 0.99f*std::numeric_limits<float>::max());
+    assert(d[0]==-d[1] && d[0] > 0.99*std::numeric_limits<double>::max());
+  }
+
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= Read with another decomposition"<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  {
+    Coordinate mpi = GridDefaultMpi();
+    Coordinate rmpi(Nd);
+    for(int d=0;d<Nd;d++) rmpi[d] = mpi[Nd-1-d];
+    GridCartesian * RGrid = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplexD::Nsimd()),rmpi);
+
+    BinaryIO::latticeCompressChunkBytes = 1;
+    BinarySimpleMunger<ColourMatrixD,ColourMatrixD> munge;
+    LatticeColourMatrixD U(UGrid);  random(RNG4,U);
+    LatticeColourMatrixD Ur(RGrid);
+    BinaryIO::writeLatticeCompressed<vColourMatrixD,ColourMatrixD>(U,"./ckpoint_compressed.U",munge);
+    BinaryIO::readLatticeCompressed <vColourMatrixD,ColourMatrixD>(Ur,"./ckpoint_compressed.U",munge);
+
+    // Same lexicographic file from either decomposition
+    uint32_t nersc_csum,scidac_csuma,scidac_csumb;
+    uint32_t nersc_ck,scidaca_ck,scidacb_ck;
+    BinaryIO::writeLatticeObject<vColourMatrixD,ColourMatrixD>(U ,"./ckpoint_compressed.U0",munge,0,"IEEE64BIG",nersc_csum,scidac_csuma,scidac_csumb);
+    BinaryIO::writeLatticeObject<vColourMatrixD,ColourMatrixD>(Ur,"./ckpoint_compressed.U1",munge,0,"IEEE64BIG",nersc_ck,scidaca_ck,scidacb_ck);
+    std::cout<<GridLogMessage<<"mpi "<<rmpi<<" checksums "<<std::hex<<nersc_csum<<" "<<nersc_ck<<std::dec<<std::endl;
+    assert(nersc_csum==nersc_ck && scidac_csuma==scidaca_ck && scidac_csumb==scidacb_ck);
+    if ( UGrid->IsBoss() ) assert(ReadFile("./ckpoint_compressed.U0")==ReadFile("./ckpoint_compressed.U1"));
+    BinaryIO::latticeCompressChunkBytes = 4*1024*1024;
+  }
+
+  Grid_finalize();
+}
@@ -0,0 +1,119 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/IO/Test_binary_io_mmap.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  const int Ls=4;
+  GridCartesian * UGrid = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplexD::Nsimd()),GridDefaultMpi());
+  GridCartesian * FGrid = SpaceTimeGrid::makeFiveDimGrid(Ls,UGrid);
+
+  GridParallelRNG RNG5(FGrid);  RNG5.SeedFixedIntegers(std::vector<int>({5,6,7,8}));
+  GridParallelRNG RNG4(UGrid);  RNG4.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+
+  typedef SpinColourVectorD   FermionD;
+  typedef vSpinColourVectorD vFermionD;
+  typedef SpinColourVectorF   FermionF;
+
+  LatticeFermionD src(FGrid); random(RNG5,src);
+  LatticeFermionD ref(FGrid);
+  LatticeFermionD res(FGrid);
+  LatticeFermionD diff(FGrid);
+
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= Mapped read against the buffered read, all file formats"<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  {
+    const uint64_t header = 1001; // the array need not start on a page
+    BinarySimpleMunger  <FermionD,FermionD> munge;
+    BinarySimpleMunger  <FermionF,FermionD> mungeF;
+    BinarySimpleUnmunger<FermionF,FermionD> unmungeF;
+    for(auto format : std::vector<std::string>({"IEEE64BIG","IEEE64","IEEE32BIG","IEEE32"})){
+      bool single = (format=="IEEE32BIG" || format=="IEEE32");
+      std::string file("./ckpoint_mmap."+format);
+      uint32_t nersc_csum,scidac_csuma,scidac_csumb;
+      uint32_t nersc_ck,scidaca_ck,scidacb_ck;
+      if ( FGrid->IsBoss() ) {
+	std::ofstream fout(file,std::ios::binary);
+	fout << std::string(header,'#');
+      }
+      FGrid->Barrier();
+      BinaryIO::latticeReadMapped = false;
+      if ( single ) {
+	BinaryIO::writeLatticeObject<vFermionD,FermionF>(src,file,unmungeF,header,format,nersc_csum,scidac_csuma,scidac_csumb);
+	BinaryIO::readLatticeObject <vFermionD,FermionF>(ref,file,mungeF  ,header,format,nersc_ck,scidaca_ck,scidacb_ck);
+      } else {
+	BinaryIO::writeLatticeObject<vFermionD,FermionD>(src,file,munge,header,format,nersc_csum,scidac_csuma,scidac_csumb);
+	BinaryIO::readLatticeObject <vFermionD,FermionD>(ref,file,munge,header,format,nersc_ck,scidaca_ck,scidacb_ck);
+      }
+      assert(nersc_csum==nersc_ck && scidac_csuma==scidaca_ck && scidac_csumb==scidacb_ck);
+
+      BinaryIO::latticeReadMapped = true;
+      res = Zero();
+      if ( single ) BinaryIO::readLatticeObject<vFermionD,FermionF>(res,file,mungeF,header,format,nersc_ck,scidaca_ck,scidacb_ck);
+      else          BinaryIO::readLatticeObject<vFermionD,FermionD>(res,file,munge ,header,format,nersc_ck,scidaca_ck,scidacb_ck);
+      std::cout<<GridLogMessage<<format<<" checksums "<<std::hex<<nersc_csum<<" "<<scidac_csuma<<" "<<scidac_csumb
+	       <<" mapped "<<nersc_ck<<" "<<scidaca_ck<<" "<<scidacb_ck<<std::dec<<std::endl;
+      assert(nersc_csum==nersc_ck && scidac_csuma==scidaca_ck && scidac_csumb==scidacb_ck);
+      diff = res - ref;
+      std::cout<<GridLogMessage<<format<<" mapped against buffered read diff "<<norm2(diff)<<std::endl;
+      assert(norm2(diff)==0.0);
+    }
+    BinaryIO::latticeReadMapped = false;
+  }
+
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= NERSC gauge configurations, full and two row"<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  {
+    LatticeGaugeFieldD Umu(UGrid);
+    LatticeGaugeFieldD Uref(UGrid);
+    LatticeGaugeFieldD Umap(UGrid);
+    SU<Nc>::HotConfiguration(RNG4,Umu);
+    for(int two_row=0;two_row<2;two_row++){
+      FieldMetaData header;
+      std::string file("./ckpoint_mmap.nersc."+std::to_string(two_row));
+      NerscIO::writeConfiguration(Umu,file,two_row,0);
+      BinaryIO::latticeReadMapped = false;
+      NerscIO::readConfiguration(Uref,header,file);
+      BinaryIO::latticeReadMapped = true;
+      NerscIO::readConfiguration(Umap,header,file);
+      BinaryIO::latticeReadMapped = false;
+      Umap = Umap - Uref;
+      std::cout<<GridLogMessage<<"NERSC two_row "<<two_row<<" mapped against buffered read diff "<<norm2(Umap)<<std::endl;
+      assert(norm2(Umap) == 0.0);
+    }
+  }
+
+  Grid_finalize();
+}
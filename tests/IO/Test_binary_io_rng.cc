@@ -0,0 +1,108 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/IO/Test_binary_io_rng.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+// Checksums of the lexicographic image of a field, independent of the decomposition
+std::vector<uint32_t> Checksums(LatticeComplexD &f)
+{
+  BinarySimpleMunger<TComplexD,TComplexD> munge;
+  uint32_t nersc_csum,scidac_csuma,scidac_csumb;
+  BinaryIO::writeLatticeObject<vTComplexD,TComplexD>(f,"./ckpoint_rng.field",munge,0,"IEEE64BIG",
+						     nersc_csum,scidac_csuma,scidac_csumb);
+  return std::vector<uint32_t>({nersc_csum,scidac_csuma,scidac_csumb});
+}
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  GridCartesian * UGrid = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplexD::Nsimd()),GridDefaultMpi());
+
+  GridSerialRNG   sRNG;        sRNG.SeedFixedIntegers(std::vector<int>({1,2,3,4}));
+  GridParallelRNG pRNG(UGrid); pRNG.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+
+  // Move the generators on from their seeded state
+  LatticeComplexD eta(UGrid);
+  gaussian(pRNG,eta);
+  RealD r;
+  random(sRNG,r);
+
+  std::string file("./ckpoint_rng.native");
+  BinaryIO::writeRNGNative(sRNG,pRNG,file);
+
+  // Reference draws following the checkpoint
+  LatticeComplexD ref(UGrid);
+  gaussian(pRNG,ref);
+  random(sRNG,r);
+  std::vector<uint32_t> ref_csum = Checksums(ref);
+
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= Native decomposition, whole block and single site pieces"<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  for(uint64_t budget : std::vector<uint64_t>({0,1,256*1024*1024})){
+    BinaryIO::latticeIOChunkBytes = budget;
+    GridSerialRNG   sRNGr;
+    GridParallelRNG pRNGr(UGrid);
+    BinaryIO::readRNGNative(sRNGr,pRNGr,file);
+    LatticeComplexD res(UGrid);
+    gaussian(pRNGr,res);
+    RealD rr;
+    random(sRNGr,rr);
+    res = res - ref;
+    std::cout<<GridLogMessage<<"budget "<<budget<<" parallel draw diff "<<norm2(res)<<" serial draw diff "<<rr-r<<std::endl;
+    assert(norm2(res)==0.0 && rr==r);
+  }
+  BinaryIO::latticeIOChunkBytes = 256*1024*1024;
+
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= Re-mapped onto another decomposition"<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  {
+    Coordinate mpi = GridDefaultMpi();
+    Coordinate rmpi(Nd);
+    for(int d=0;d<Nd;d++) rmpi[d] = mpi[Nd-1-d];
+    GridCartesian * RGrid = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplexD::Nsimd()),rmpi);
+    for(uint64_t budget : std::vector<uint64_t>({0,1,256*1024*1024})){
+      BinaryIO::latticeIOChunkBytes = budget;
+      GridSerialRNG   sRNGr;
+      GridParallelRNG pRNGr(RGrid);
+      BinaryIO::readRNGNative(sRNGr,pRNGr,file);
+      LatticeComplexD res(RGrid);
+      gaussian(pRNGr,res);
+      std::vector<uint32_t> csum = Checksums(res);
+      std::cout<<GridLogMessage<<"mpi "<<rmpi<<" budget "<<budget<<" draw checksums "<<std::hex<<csum[0]<<" "<<ref_csum[0]<<std::dec<<std::endl;
+      assert(csum==ref_csum);
+    }
+    BinaryIO::latticeIOChunkBytes = 256*1024*1024;
+  }
+
+  Grid_finalize();
+}
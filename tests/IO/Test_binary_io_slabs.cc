@@ -0,0 +1,133 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/IO/Test_binary_io_slabs.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+std::vector<char> ReadFile(const std::string &file)
+{
+  std::ifstream fin(file,std::ios::binary);
+  return std::vector<char>((std::istreambuf_iterator<char>(fin)),std::istreambuf_iterator<char>());
+}
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  const int Ls=8;
+  GridCartesian * UGrid = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplexD::Nsimd()),GridDefaultMpi());
+  GridCartesian * FGrid = SpaceTimeGrid::makeFiveDimGrid(Ls,UGrid);
+
+  GridParallelRNG RNG5(FGrid);  RNG5.SeedFixedIntegers(std::vector<int>({5,6,7,8}));
+  GridParallelRNG RNG4(UGrid);  RNG4.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+
+  typedef SpinColourVectorD   FermionD;
+  typedef vSpinColourVectorD vFermionD;
+  typedef SpinColourVectorF   FermionF;
+
+  LatticeFermionD src(FGrid); random(RNG5,src);
+  LatticeFermionD res(FGrid);
+  LatticeFermionD diff(FGrid);
+
+  int      Lt    = FGrid->LocalDimensions()[FGrid->Nd()-1];
+  uint64_t slice = FGrid->lSites()/Lt;
+
+  // Budgets giving the whole local volume, one slice, and a ragged last slab
+  std::vector<uint64_t> budgets({0, 1, 3*slice*(sizeof(FermionD)+sizeof(FermionD)) });
+
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= Slabbed write and read against the whole local volume"<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  for(auto format : std::vector<std::string>({"IEEE64BIG","IEEE64"})){
+    BinarySimpleMunger<FermionD,FermionD> munge;
+    uint32_t nersc_ref,scidaca_ref,scidacb_ref;
+    std::vector<char> ref;
+    for(int b=0;b<budgets.size();b++){
+      BinaryIO::latticeIOChunkBytes = budgets[b];
+      std::string file("./ckpoint_slabs."+std::to_string(b));
+      uint32_t nersc_csum,scidac_csuma,scidac_csumb;
+
+      BinaryIO::writeLatticeObject<vFermionD,FermionD>(src,file,munge,0,format,nersc_csum,scidac_csuma,scidac_csumb);
+      std::cout<<GridLogMessage<<format<<" budget "<<budgets[b]<<" write checksums "<<std::hex
+	       <<nersc_csum<<" "<<scidac_csuma<<" "<<scidac_csumb<<std::dec<<std::endl;
+      if ( b==0 ) {
+	nersc_ref=nersc_csum; scidaca_ref=scidac_csuma; scidacb_ref=scidac_csumb;
+	if ( FGrid->IsBoss() ) ref = ReadFile(file);
+      }
+      assert(nersc_csum==nersc_ref && scidac_csuma==scidaca_ref && scidac_csumb==scidacb_ref);
+      if ( FGrid->IsBoss() ) assert(ReadFile(file)==ref);
+
+      res = Zero();
+      BinaryIO::readLatticeObject<vFermionD,FermionD>(res,file,munge,0,format,nersc_csum,scidac_csuma,scidac_csumb);
+      assert(nersc_csum==nersc_ref && scidac_csuma==scidaca_ref && scidac_csumb==scidacb_ref);
+      diff = res - src;
+      std::cout<<GridLogMessage<<format<<" budget "<<budgets[b]<<" read back diff "<<norm2(diff)<<std::endl;
+      assert(norm2(diff)==0.0);
+    }
+  }
+
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= Single precision file with write verification"<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  {
+    BinaryIO::latticeWriteMaxRetry = 1;
+    BinaryIO::latticeIOChunkBytes  = 1;
+    BinarySimpleUnmunger<FermionF,FermionD> unmunge;
+    BinarySimpleMunger  <FermionF,FermionD> munge;
+    uint32_t nersc_csum,scidac_csuma,scidac_csumb;
+    uint32_t nersc_ck,scidaca_ck,scidacb_ck;
+    std::string file("./ckpoint_slabs.F");
+    BinaryIO::writeLatticeObject<vFermionD,FermionF>(src,file,unmunge,0,"IEEE32BIG",nersc_csum,scidac_csuma,scidac_csumb);
+    BinaryIO::readLatticeObject <vFermionD,FermionF>(res,file,munge  ,0,"IEEE32BIG",nersc_ck,scidaca_ck,scidacb_ck);
+    assert(nersc_csum==nersc_ck && scidac_csuma==scidaca_ck && scidac_csumb==scidacb_ck);
+    diff = res - src;
+    std::cout<<GridLogMessage<<"IEEE32BIG read back rel diff "<<std::sqrt(norm2(diff)/norm2(src))<<std::endl;
+    assert(std::sqrt(norm2(diff)/norm2(src)) < 1.0e-6);
+    BinaryIO::latticeWriteMaxRetry = -1;
+  }
+
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= NERSC gauge configuration in single slice slabs"<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  {
+    BinaryIO::latticeIOChunkBytes = 1;
+    LatticeGaugeFieldD Umu(UGrid);
+    LatticeGaugeFieldD Uread(UGrid);
+    SU<Nc>::HotConfiguration(RNG4,Umu);
+    FieldMetaData header;
+    std::string file("./ckpoint_slabs.nersc");
+    NerscIO::writeConfiguration(Umu,file,1,0);
+    NerscIO::readConfiguration(Uread,header,file);
+    Uread = Uread - Umu;
+    std::cout<<GridLogMessage<<"NERSC read back diff "<<norm2(Uread)<<std::endl;
+    assert(norm2(Uread) < 1.0e-20);
+  }
+
+  Grid_finalize();
+}
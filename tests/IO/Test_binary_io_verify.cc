@@ -0,0 +1,114 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/IO/Test_binary_io_verify.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+std::vector<char> ReadFile(const std::string &file)
+{
+  std::ifstream fin(file,std::ios::binary);
+  return std::vector<char>((std::istreambuf_iterator<char>(fin)),std::istreambuf_iterator<char>());
+}
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  const int Ls=4;
+  GridCartesian * UGrid = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplexD::Nsimd()),GridDefaultMpi());
+  GridCartesian * FGrid = SpaceTimeGrid::makeFiveDimGrid(Ls,UGrid);
+
+  GridParallelRNG RNG5(FGrid);  RNG5.SeedFixedIntegers(std::vector<int>({5,6,7,8}));
+
+  typedef SpinColourVectorD   FermionD;
+  typedef vSpinColourVectorD vFermionD;
+
+  LatticeFermionD src(FGrid); random(RNG5,src);
+  LatticeFermionD res(FGrid);
+  LatticeFermionD diff(FGrid);
+  BinarySimpleMunger<FermionD,FermionD> munge;
+  uint32_t nersc_csum,scidac_csuma,scidac_csumb;
+
+  // Small chunks and slabs so there are many of each
+  BinaryIO::latticeWriteVerifyChunkBytes = 4096;
+  BinaryIO::latticeIOChunkBytes          = 1;
+
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= Verified writes against an unverified one"<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::vector<char> ref;
+  BinaryIO::latticeWriteMaxRetry = 1;
+  for(auto mode : std::vector<int>({BinaryIO::VerifyNone,BinaryIO::VerifySampled,BinaryIO::VerifyFull})){
+    BinaryIO::latticeWriteVerify = mode;
+    std::string file("./ckpoint_verify."+std::to_string(mode));
+    BinaryIO::writeLatticeObject<vFermionD,FermionD>(src,file,munge,0,"IEEE64BIG",nersc_csum,scidac_csuma,scidac_csumb);
+    res = Zero();
+    BinaryIO::readLatticeObject<vFermionD,FermionD>(res,file,munge,0,"IEEE64BIG",nersc_csum,scidac_csuma,scidac_csumb);
+    diff = res - src;
+    std::cout<<GridLogMessage<<"verify mode "<<mode<<" read back diff "<<norm2(diff)<<std::endl;
+    assert(norm2(diff)==0.0);
+    if ( FGrid->IsBoss() ) {
+      if ( mode==BinaryIO::VerifyNone ) ref = ReadFile(file);
+      else                              assert(ReadFile(file)==ref);
+    }
+  }
+
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= A corrupted chunk is caught"<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  {
+    typedef vFermionD::Realified::scalar_type word;    word w=0;
+    std::string file("./ckpoint_verify.bad");
+    std::vector<FermionD> iodata;
+    std::vector<BinaryIO::ChunkDigest> digests;
+    BinaryIO::IOobjectSlabs(w,FGrid,iodata,BinaryIO::SlabSlices<FermionD,FermionD>(FGrid),file,0,"IEEE64BIG",
+			    BinaryIO::BINARYIO_WRITE|BinaryIO::BINARYIO_LEXICOGRAPHIC,
+			    nersc_csum,scidac_csuma,scidac_csumb,
+			    [&](int t0,int nt) { BinaryIO::unvectorizeSlab(iodata,src,t0,nt); },
+			    &digests);
+    BinaryIO::latticeWriteVerify         = BinaryIO::VerifyFull;
+    assert(BinaryIO::verifyChunks(FGrid,file,digests,0));
+
+    // One byte of the last chunk of the boss
+    if ( FGrid->IsBoss() ) {
+      std::fstream f(file,std::ios::binary|std::ios::in|std::ios::out);
+      f.seekp(digests.back().pos+digests.back().len/2);
+      f.put('!');
+    }
+    FGrid->Barrier();
+    assert(!BinaryIO::verifyChunks(FGrid,file,digests,0));
+    BinaryIO::latticeWriteVerify         = BinaryIO::VerifySampled;
+    BinaryIO::latticeWriteVerifyFraction = 1.0;
+    assert(!BinaryIO::verifyChunks(FGrid,file,digests,0));
+    BinaryIO::latticeWriteVerifyFraction = 0.05;
+  }
+  BinaryIO::latticeWriteMaxRetry = -1;
+
+  Grid_finalize();
+}
@@ -0,0 +1,129 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/IO/Test_hdf5_parallel.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+#ifdef HAVE_HDF5
+std::vector<char> ReadFile(const std::string &file)
+{
+  std::ifstream fin(file,std::ios::binary);
+  return std::vector<char>((std::istreambuf_iterator<char>(fin)),std::istreambuf_iterator<char>());
+}
+#endif
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+#ifdef HAVE_HDF5
+  const int Ls=8;
+  GridCartesian * UGrid = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplexD::Nsimd()),GridDefaultMpi());
+  GridCartesian * FGrid = SpaceTimeGrid::makeFiveDimGrid(Ls,UGrid);
+
+  GridParallelRNG RNG5(FGrid);  RNG5.SeedFixedIntegers(std::vector<int>({5,6,7,8}));
+  GridParallelRNG RNG4(UGrid);  RNG4.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+
+  LatticeFermionD src(FGrid); random(RNG5,src);
+  LatticeFermionD res(FGrid);
+  LatticeComplexD phi(UGrid); random(RNG4,phi);
+  LatticeComplexD chi(UGrid);
+
+  // A meson field shaped tensor [mom][gamma][t][i][j], the same on every rank
+  const int Nt = UGrid->GlobalDimensions()[Nd-1];
+  std::vector<size_t> mdims({2,3,(size_t)Nt,7,5});
+  std::vector<ComplexD> meson(2*3*Nt*7*5);
+  for(int i=0;i<meson.size();i++) meson[i] = ComplexD(i,-0.5*i);
+  std::vector<size_t> tdims({2,3});
+  std::vector<RealD> tiny({1.,2.,3.,4.,5.,6.});
+
+  std::string file("./hdf5_parallel.h5");
+  {
+    Hdf5ParallelWriter w(UGrid,file);
+    w.writeLattice("fermion",src);
+    w.writeLattice("complex",phi);
+    w.writeMultiDim("meson",mdims,&meson[0]);
+    w.writeMultiDim("tiny",tdims,&tiny[0]);
+  }
+
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= Lattice fields read back by hyperslab"<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  {
+    Hdf5ParallelReader r(UGrid,file);
+    r.readLattice("fermion",res);
+    r.readLattice("complex",chi);
+  }
+  res = res - src;
+  chi = chi - phi;
+  std::cout<<GridLogMessage<<"fermion diff "<<norm2(res)<<" complex diff "<<norm2(chi)<<std::endl;
+  assert(norm2(res)==0.0 && norm2(chi)==0.0);
+
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= Global lexicographic datasets, read by Hdf5Reader"<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  {
+    // The lattice dataset holds the bytes of a native order BinaryIO file
+    BinarySimpleMunger<SpinColourVectorD,SpinColourVectorD> munge;
+    uint32_t nersc_csum,scidac_csuma,scidac_csumb;
+    BinaryIO::writeLatticeObject<vSpinColourVectorD,SpinColourVectorD>(src,"./hdf5_parallel.bin",munge,0,
+#if BYTE_ORDER == BIG_ENDIAN
+								       "IEEE64BIG",
+#else
+								       "IEEE64",
+#endif
+								       nersc_csum,scidac_csuma,scidac_csumb);
+    if ( UGrid->IsBoss() ) {
+      Hdf5Reader r(file);
+      std::vector<ComplexD> buf;
+      std::vector<size_t>   dim;
+      r.readMultiDim("fermion",buf,dim);
+      std::vector<size_t> fdims;
+      for(int d=FGrid->Nd()-1;d>=0;d--) fdims.push_back(FGrid->GlobalDimensions()[d]);
+      fdims.push_back(Ns*Nc);
+      assert(dim==fdims);
+      std::vector<char> bin = ReadFile("./hdf5_parallel.bin");
+      assert(bin.size()==buf.size()*sizeof(ComplexD));
+      assert(std::memcmp(&bin[0],&buf[0],bin.size())==0);
+
+      buf.resize(0); dim.resize(0);
+      r.readMultiDim("meson",buf,dim);
+      assert(dim==mdims && buf==meson);
+
+      std::vector<RealD> tbuf;
+      dim.resize(0);
+      r.readMultiDim("tiny",tbuf,dim);
+      assert(dim==tdims && tbuf==tiny);
+      std::cout<<GridLogMessage<<"lattice, meson field and attribute datasets match"<<std::endl;
+    }
+  }
+#endif
+
+  Grid_finalize();
+}
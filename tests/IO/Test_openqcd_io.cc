@@ -33,7 +33,6 @@ See the full license in the file "LICENSE" in the top level distribution directo
 using namespace Grid;
 
 int main(int argc, char** argv) {
-#if !defined(GRID_COMMS_NONE)
   Grid_init(&argc, &argv);
 
   auto simd_layout = GridDefaultSimd(Nd, vComplex::Nsimd());
@@ -53,10 +52,52 @@ int main(int argc, char** argv) {
   FieldMetaData header_ref;
   FieldMetaData header_me;
 
-  Umu_ref = Zero();
-  Umu_me  = Zero();
+  // Round trip through the parallel writer and the single pass reader
+  std::string file_rt("./ckpoint_openqcd");
+  {
+    LatticeGaugeField Umu(&grid);
+    SU<Nc>::HotConfiguration(pRNG, Umu);
+
+    OpenQcdIO::writeConfiguration(Umu, file_rt);
+    OpenQcdIO::readConfiguration(Umu_me, header_me, file_rt);
+
+    Umu_diff = Umu_me - Umu;
+    std::cout << GridLogMessage << "round trip norm2(Umu_diff) = " << norm2(Umu_diff) << std::endl;
+    assert(norm2(Umu_diff) == 0.0);
+
+    // The eight links of the first odd site, z = 1, in openQCD order T X Y Z
+    Coordinate site({0, 0, 1, 0});
+    std::vector<ColourMatrixD> links;
+    for(int mu_o = 0; mu_o < Nd; ++mu_o) {
+      int        mu_g = (mu_o + Nd - 1) % Nd;
+      Coordinate down = site;
+      down[mu_g]      = (down[mu_g] + latt_size[mu_g] - 1) % latt_size[mu_g];
+      LorentzColourMatrixD fwd, bwd;
+      ColourMatrixD        link;
+      peekSite(fwd, Umu, site);
+      peekSite(bwd, Umu, down);
+      link() = fwd(mu_g);
+      links.push_back(link);
+      link() = bwd(mu_g);
+      links.push_back(link);
+    }
+    if(grid.IsBoss()) {
+      std::vector<ColourMatrixD> file_links(2 * Nd);
+      std::ifstream fin(file_rt, std::ios::in | std::ios::binary);
+      fin.seekg(sizeof(OpenQcdHeader));
+      fin.read(reinterpret_cast<char*>(&file_links[0]), file_links.size() * sizeof(ColourMatrixD));
+      assert(!fin.fail());
+      for(int l = 0; l < 2 * Nd; ++l) {
+        ColourMatrixD d = file_links[l] - links[l];
+        assert(norm2(d) == 0.0);
+      }
+      std::cout << GridLogMessage << "file layout of the first odd site agrees" << std::endl;
+    }
+  }
 
-  std::string file("/home/daniel/configs/openqcd/test_16x8_pbcn6");
+#if !defined(GRID_COMMS_NONE)
+  // Against the reference reader, on the file written above unless given one
+  std::string file(file_rt);
 
   if(GridCmdOptionExists(argv, argv + argc, "--config")) {
     file = GridCmdOptionPayload(argv, argv + argc, "--config");
@@ -64,6 +105,9 @@ int main(int argc, char** argv) {
     assert(!file.empty());
   }
 
+  Umu_ref = Zero();
+  Umu_me  = Zero();
+
   OpenQcdIOChromaReference::readConfiguration(Umu_ref, header_ref, file);
   OpenQcdIO::readConfiguration(Umu_me, header_me, file);
 
@@ -78,7 +122,7 @@ int main(int argc, char** argv) {
             << " norm2(Umu_me) = " << norm2(Umu_me)
             << " norm2(Umu_diff) = " << norm2(Umu_diff) << std::endl;
   // clang-format on
+#endif
 
   Grid_finalize();
-#endif
 }
@@ -0,0 +1,90 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/core/Test_basis_deflate.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace Grid;
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  const int Nevec = 24;
+  const int Nsrc  = 4;
+
+  GridCartesian * UGrid = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(),
+							  GridDefaultSimd(Nd,vComplex::Nsimd()),
+							  GridDefaultMpi());
+
+  GridParallelRNG RNG(UGrid);
+  RNG.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+
+  std::vector<LatticeFermion> evec(Nevec,UGrid);
+  std::vector<RealD>          eval(Nevec);
+  for(int i=0;i<Nevec;i++){
+    gaussian(RNG,evec[i]);
+    basisOrthogonalize(evec,evec[i],i);
+    evec[i] = evec[i]*(1.0/std::sqrt(norm2(evec[i])));
+    eval[i] = 0.1*(i+1);
+  }
+
+  std::vector<LatticeFermion> src(Nsrc,UGrid);
+  for(int j=0;j<Nsrc;j++) gaussian(RNG,src[j]);
+
+  ////////////////////////////////////////////////
+  // Reference: one vector at a time
+  ////////////////////////////////////////////////
+  std::vector<LatticeFermion> ref(Nsrc,UGrid);
+  double t0=usecond();
+  for(int j=0;j<Nsrc;j++) basisDeflate(evec,eval,src[j],ref[j]);
+  double t1=usecond();
+
+  ////////////////////////////////////////////////
+  // Blocked projection, all sources at once
+  ////////////////////////////////////////////////
+  std::vector<LatticeFermion> guess(Nsrc,UGrid);
+  DeflatedGuesser<LatticeFermion> Guesser(evec,eval);
+  Guesser(src,guess);
+  double t2=usecond();
+
+  std::cout << GridLogMessage << "Vector at a time " << (t1-t0)/1000. << " ms; blocked " << (t2-t1)/1000. << " ms" << std::endl;
+
+  LatticeFermion diff(UGrid);
+  for(int j=0;j<Nsrc;j++){
+    diff = ref[j]-guess[j];
+    std::cout << GridLogMessage << "src " << j << " |ref-blocked|^2 " << norm2(diff) << " |ref|^2 " << norm2(ref[j]) << std::endl;
+    assert(norm2(diff) < 1.0e-24*norm2(ref[j]));
+  }
+
+  // Single source path goes through the same kernel
+  Guesser(src[0],diff);
+  diff = diff-ref[0];
+  std::cout << GridLogMessage << "single source |ref-blocked|^2 " << norm2(diff) << std::endl;
+  assert(norm2(diff) < 1.0e-24*norm2(ref[0]));
+
+  Grid_finalize();
+}
@@ -0,0 +1,74 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/core/Test_basis_orthogonalize.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace Grid;
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  const int   Nvec = 24;
+  const RealD eps  = 1.0e-7;
+
+  GridCartesian * UGrid = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(),
+							  GridDefaultSimd(Nd,vComplex::Nsimd()),
+							  GridDefaultMpi());
+
+  GridParallelRNG RNG(UGrid);
+  RNG.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+
+  ////////////////////////////////////////////////
+  // Nearly parallel vectors, u + eps g_i, orthonormalised one at a time as
+  // in the Lanczos iteration; the new direction is a 1e-7 remnant of w, so a
+  // single classical Gram-Schmidt pass leaves O(1) overlaps behind
+  ////////////////////////////////////////////////
+  LatticeFermion u(UGrid); gaussian(RNG,u);
+  LatticeFermion g(UGrid);
+  std::vector<LatticeFermion> basis(Nvec,UGrid);
+  for(int i=0;i<Nvec;i++){
+    gaussian(RNG,g);
+    basis[i] = u + eps*g;
+    basisOrthogonalize(basis,basis[i],i);
+    basis[i] = basis[i]*(1.0/std::sqrt(norm2(basis[i])));
+  }
+
+  RealD err = 0.0;
+  for(int i=0;i<Nvec;i++){
+    for(int j=0;j<Nvec;j++){
+      ComplexD ip = innerProduct(basis[i],basis[j]);
+      if ( i==j ) ip = ip - 1.0;
+      err += norm(ip);
+    }
+  }
+  err = std::sqrt(err);
+  std::cout << GridLogMessage << "|V^dag V - 1| " << err << std::endl;
+  assert(err < 1.0e-12);
+
+  Grid_finalize();
+}
@@ -213,6 +213,56 @@ void runBenchmark(int* argc, char*** argv) {
   BENCH_CLOVER_KERNEL(MooeeInv);
   BENCH_CLOVER_KERNEL(MooeeInvDag);
 
+  // even-odd preconditioned operator: Mpc = Mee - Meo Moo^-1 Moe on the odd checkerboard,
+  // per checkerboard site 2 hops, clover + clover inverse and the final subtraction
+  double mpc_flop_per_site = 2 * hop_flop_per_site + 2 * clov_flop_per_site + 24;
+  double mpc_byte_per_site = 2 * hop_byte_per_site + 2 * clov_byte_per_site;
+  double mpc_gflop_total   = volume / 2 * nIter * mpc_flop_per_site / 1e9;
+  double mpc_gbyte_total   = volume / 2 * nIter * mpc_byte_per_site / 1e9;
+
+  Fermion src_o(UrbGrid); pickCheckerboard(Odd, src_o, src);
+  Fermion ref_o(UrbGrid); ref_o = Zero();
+  Fermion res_o(UrbGrid); res_o = Zero();
+
+  SchurDiagMooeeOperator<WilsonCloverOperator, Fermion>             HermOp(Dwc);
+  SchurDiagMooeeOperator<CompactWilsonCloverOperator, Fermion>      HermOp_compact(Dwc_compact);
+  SchurDiagMooeeFusedOperator<CompactWilsonCloverOperator, Fermion> HermOp_fused(Dwc_compact);
+
+#define BENCH_MPC_OPERATOR(NAME, OP, KERNEL, OUT) { \
+  for(auto n : {1, 2, 3, 4, 5}) OP.KERNEL(src_o, OUT); \
+  double t6 = usecond(); \
+  for(int n = 0; n < nIter; n++) OP.KERNEL(src_o, OUT); \
+  double t7 = usecond(); \
+  secs_##NAME = (t7-t6)/1e6; \
+  grid_printf_msg("Performance(%35s, %s): %2.4f s, %6.0f GFlop/s, %6.0f GByte/s, speedup vs ref = %.2f, fraction of hop = %.2f\n", \
+                  #NAME"_"#KERNEL, precision.c_str(), secs_##NAME, mpc_gflop_total/secs_##NAME, mpc_gbyte_total/secs_##NAME, secs_reference/secs_##NAME, secs_##NAME/secs_hop); \
+}
+
+#define BENCH_MPC(KERNEL) { \
+  double secs_reference = 1.0, secs_compact = 1.0, secs_fused = 1.0; \
+  BENCH_MPC_OPERATOR(reference, HermOp,         KERNEL, ref_o); \
+  BENCH_MPC_OPERATOR(compact,   HermOp_compact, KERNEL, res_o); \
+  BENCH_MPC_OPERATOR(fused,     HermOp_fused,   KERNEL, res_o); \
+  assert(resultsAgree(ref_o, res_o, #KERNEL)); \
+}
+
+  BENCH_MPC(Mpc);
+  BENCH_MPC(MpcDag);
+
+  // fused operator with open boundaries in time against the unfused one
+  {
+    typename CompactWilsonCloverOperator::ImplParams openParams;
+    std::vector<Complex> open_phases(Nd, 1.); open_phases[Nd-1] = 0.;
+    openParams.boundary_phases = open_phases;
+    CompactWilsonCloverOperator Dwc_open(Umu, *UGrid, *UrbGrid, mass, csw, csw, cF, anisParams, openParams);
+    SchurDiagMooeeOperator<CompactWilsonCloverOperator, Fermion>      HermOp_open(Dwc_open);
+    SchurDiagMooeeFusedOperator<CompactWilsonCloverOperator, Fermion> HermOp_open_fused(Dwc_open);
+    HermOp_open.Mpc(src_o, ref_o);          HermOp_open_fused.Mpc(src_o, res_o);
+    assert(resultsAgree(ref_o, res_o, "Mpc_open"));
+    HermOp_open.MpcDag(src_o, ref_o);       HermOp_open_fused.MpcDag(src_o, res_o);
+    assert(resultsAgree(ref_o, res_o, "MpcDag_open"));
+  }
+
   grid_printf_msg("finalize %s\n", precision.c_str());
 }
 
@@ -0,0 +1,120 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/core/Test_dslash_autotune.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  const int Ls=8;
+
+  GridCartesian         * UGrid   = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplexD::Nsimd()),GridDefaultMpi());
+  GridRedBlackCartesian * UrbGrid = SpaceTimeGrid::makeFourDimRedBlackGrid(UGrid);
+  GridCartesian         * FGrid   = SpaceTimeGrid::makeFiveDimGrid(Ls,UGrid);
+  GridRedBlackCartesian * FrbGrid = SpaceTimeGrid::makeFiveDimRedBlackGrid(Ls,UGrid);
+
+  GridParallelRNG RNG4(UGrid);  RNG4.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+  GridParallelRNG RNG5(FGrid);  RNG5.SeedFixedIntegers(std::vector<int>({5,6,7,8}));
+
+  LatticeGaugeFieldD Umu(UGrid);
+  SU<Nc>::HotConfiguration(RNG4,Umu);
+
+  RealD mass=0.1;
+  RealD M5  =1.8;
+
+  LatticeFermionD src(FGrid); random(RNG5,src);
+  LatticeFermionD src_e(FrbGrid);
+  LatticeFermionD ref(FrbGrid);
+  LatticeFermionD res(FrbGrid);
+  LatticeFermionD err(FrbGrid);
+  pickCheckerboard(Even,src_e,src);
+
+  // Reference with the command line kernel choice
+  DomainWallFermionD Ddwf(Umu,*FGrid,*FrbGrid,*UGrid,*UrbGrid,mass,M5);
+  Ddwf.Meooe(src_e,ref);
+
+  ////////////////////////////////////////////////////////////////////
+  // Start from an empty cache file
+  ////////////////////////////////////////////////////////////////////
+  DslashTuner::Enabled   = 1;
+  DslashTuner::CacheFile = "Test_dslash_autotune.cache";
+  if ( UGrid->IsBoss() ) std::remove(DslashTuner::CacheFile.c_str());
+  UGrid->Barrier();
+
+  int opt   = WilsonKernelsStatic::Opt;
+  int comms = WilsonKernelsStatic::Comms;
+
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= First construction times the candidates"<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  DslashTuning first;
+  {
+    DomainWallFermionD Dtuned(Umu,*FGrid,*FrbGrid,*UGrid,*UrbGrid,mass,M5);
+    first = Dtuned.Tuning;
+    assert(first.Opt   >= 0);
+    assert(first.Comms >= 0);
+    Dtuned.Meooe(src_e,res);
+    err = res - ref;
+    std::cout<<GridLogMessage<<"tuned Meooe diff "<<norm2(err)<<std::endl;
+    assert(norm2(err) < 1.0e-20*norm2(ref));
+  }
+  // The global choice is untouched outside the operator
+  assert(WilsonKernelsStatic::Opt   == opt);
+  assert(WilsonKernelsStatic::Comms == comms);
+
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= Second construction reuses the decision"<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  {
+    DomainWallFermionD Dcached(Umu,*FGrid,*FrbGrid,*UGrid,*UrbGrid,mass,M5);
+    assert(Dcached.Tuning.Opt   == first.Opt);
+    assert(Dcached.Tuning.Comms == first.Comms);
+  }
+
+  // One record was written for the key
+  if ( UGrid->IsBoss() ) {
+    std::ifstream fin(DslashTuner::CacheFile);
+    std::string key;
+    int o,c;
+    double usec;
+    int lines=0;
+    while ( fin >> key >> o >> c >> usec ) {
+      assert(o == first.Opt);
+      assert(c == first.Comms);
+      lines++;
+    }
+    std::cout<<GridLogMessage<<"cache records "<<lines<<std::endl;
+    assert(lines==1);
+    std::remove(DslashTuner::CacheFile.c_str());
+  }
+
+  Grid_finalize();
+}
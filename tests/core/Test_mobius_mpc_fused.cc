@@ -0,0 +1,129 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/core/Test_mobius_mpc_fused.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+// Fused per site Schur operator against the Meooe/MooeeInv/Mooee chain
+template<class Action>
+void CompareMpc(Action &D,GridBase *FGrid,GridBase *FrbGrid,GridParallelRNG &RNG)
+{
+  typedef typename Action::FermionField FermionField;
+
+  SchurDiagMooeeOperator<Action,FermionField>      HermOp(D);
+  SchurDiagMooeeFusedOperator<Action,FermionField> HermOpFused(D);
+
+  FermionField src(FGrid); random(RNG,src);
+  FermionField src_o(FrbGrid);
+  FermionField ref  (FrbGrid);
+  FermionField res  (FrbGrid);
+  FermionField err  (FrbGrid);
+
+  std::vector<int> opts({WilsonKernelsStatic::OptGeneric,WilsonKernelsStatic::OptHandUnroll});
+  std::vector<int> cbs ({Odd,Even});
+  for(auto opt : opts){
+    WilsonKernelsStatic::Opt = opt;
+    for(auto cb : cbs){
+      pickCheckerboard(cb,src_o,src);
+
+      HermOp.Mpc(src_o,ref);
+      HermOpFused.Mpc(src_o,res);
+      err = ref - res;
+      std::cout<<GridLogMessage<<"Opt "<<opt<<" cb "<<cb<<" Mpc    "<<norm2(ref)<<" diff "<<norm2(err)<<std::endl;
+      assert(res.Checkerboard()==ref.Checkerboard());
+      assert(norm2(err) < 1.0e-24*norm2(ref));
+
+      HermOp.MpcDag(src_o,ref);
+      HermOpFused.MpcDag(src_o,res);
+      err = ref - res;
+      std::cout<<GridLogMessage<<"Opt "<<opt<<" cb "<<cb<<" MpcDag "<<norm2(ref)<<" diff "<<norm2(err)<<std::endl;
+      assert(norm2(err) < 1.0e-24*norm2(ref));
+    }
+  }
+  WilsonKernelsStatic::Opt = WilsonKernelsStatic::OptGeneric;
+
+  // <src|MpcDag Mpc|src> = |Mpc src|^2 through the fused pair
+  pickCheckerboard(Odd,src_o,src);
+  FermionField phi(FrbGrid);
+  RealD n1,n2;
+  HermOpFused.HermOpAndNorm(src_o,phi,n1,n2);
+  HermOpFused.Mpc(src_o,res);
+  RealD nm = norm2(res);
+  std::cout<<GridLogMessage<<"<src|MpcDagMpc src> "<<n1<<" |Mpc src|^2 "<<nm<<std::endl;
+  assert(fabs(n1-nm) < 1.0e-10*nm);
+
+  int ncall=100;
+  double t0=usecond();
+  for(int i=0;i<ncall;i++) HermOp.Mpc(src_o,ref);
+  double t1=usecond();
+  for(int i=0;i<ncall;i++) HermOpFused.Mpc(src_o,res);
+  double t2=usecond();
+  std::cout<<GridLogMessage<<"Mpc chain "<<(t1-t0)/ncall<<" us fused "<<(t2-t1)/ncall<<" us"<<std::endl;
+}
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  const int Ls=8;
+
+  GridCartesian         * UGrid   = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplexD::Nsimd()),GridDefaultMpi());
+  GridRedBlackCartesian * UrbGrid = SpaceTimeGrid::makeFourDimRedBlackGrid(UGrid);
+  GridCartesian         * FGrid   = SpaceTimeGrid::makeFiveDimGrid(Ls,UGrid);
+  GridRedBlackCartesian * FrbGrid = SpaceTimeGrid::makeFiveDimRedBlackGrid(Ls,UGrid);
+
+  GridParallelRNG RNG4(UGrid);  RNG4.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+  GridParallelRNG RNG5(FGrid);  RNG5.SeedFixedIntegers(std::vector<int>({5,6,7,8}));
+
+  LatticeGaugeFieldD Umu(UGrid);
+  SU<Nc>::HotConfiguration(RNG4,Umu);
+
+  RealD mass=0.1;
+  RealD M5  =1.8;
+  RealD b   =1.5;
+  RealD c   =0.5;
+
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= Mobius fused Mpc"<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  {
+    MobiusFermionD Dmob(Umu,*FGrid,*FrbGrid,*UGrid,*UrbGrid,mass,M5,b,c);
+    CompareMpc(Dmob,FGrid,FrbGrid,RNG5);
+  }
+
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= Domain wall fused Mpc"<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  {
+    DomainWallFermionD Ddwf(Umu,*FGrid,*FrbGrid,*UGrid,*UrbGrid,mass,M5);
+    CompareMpc(Ddwf,FGrid,FrbGrid,RNG5);
+  }
+
+  Grid_finalize();
+}
@@ -0,0 +1,141 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/core/Test_wilson_compressed_links.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+#ifdef ENABLE_COMPRESSED_LINKS
+template<class Field>
+RealD Compare(const std::string &name,const Field &full,const Field &comp)
+{
+  Field err(full.Grid());
+  err = full - comp;
+  RealD rel = std::sqrt(norm2(err)/norm2(full));
+  std::cout<<GridLogMessage << name <<" full "<<norm2(full)<<" compressed "<<norm2(comp)<<" rel diff "<<rel<<std::endl;
+  assert(rel < 1.0e-10);
+  return rel;
+}
+
+// Full and two row storage applied to the same source through each kernel variant
+template<class Full,class Comp>
+void CompareOperators(Full &Df,Comp &Dc,GridBase *FGrid,GridBase *FrbGrid,GridParallelRNG &RNG)
+{
+  typedef typename Full::FermionField FermionField;
+
+  FermionField src(FGrid); random(RNG,src);
+  FermionField rf (FGrid);
+  FermionField rc (FGrid);
+  FermionField src_e(FrbGrid);
+  FermionField rf_o (FrbGrid);
+  FermionField rc_o (FrbGrid);
+  pickCheckerboard(Even,src_e,src);
+
+  std::vector<int> opts({WilsonKernelsStatic::OptGeneric,WilsonKernelsStatic::OptHandUnroll});
+  std::vector<int> comms({WilsonKernelsStatic::CommsAndCompute,WilsonKernelsStatic::CommsThenCompute});
+  for(auto opt : opts){
+    for(auto comm : comms){
+      WilsonKernelsStatic::Opt   = opt;
+      WilsonKernelsStatic::Comms = comm;
+      std::cout<<GridLogMessage << "Opt "<<opt<<" Comms "<<comm<<std::endl;
+
+      Df.M(src,rf);           Dc.M(src,rc);           Compare("M     ",rf,rc);
+      Df.Mdag(src,rf);        Dc.Mdag(src,rc);        Compare("Mdag  ",rf,rc);
+      Df.Dhop(src,rf,DaggerNo);  Dc.Dhop(src,rc,DaggerNo);  Compare("Dhop  ",rf,rc);
+      Df.Dhop(src,rf,DaggerYes); Dc.Dhop(src,rc,DaggerYes); Compare("Dhop^+",rf,rc);
+      Df.Meooe(src_e,rf_o);   Dc.Meooe(src_e,rc_o);   Compare("Meooe ",rf_o,rc_o);
+      Df.MeooeDag(src_e,rf_o);Dc.MeooeDag(src_e,rc_o);Compare("Meo^+ ",rf_o,rc_o);
+    }
+  }
+  WilsonKernelsStatic::Opt   = WilsonKernelsStatic::OptGeneric;
+  WilsonKernelsStatic::Comms = WilsonKernelsStatic::CommsAndCompute;
+}
+#endif
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+#ifdef ENABLE_COMPRESSED_LINKS
+  const int Ls=4;
+
+  GridCartesian         * UGrid   = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplexD::Nsimd()),GridDefaultMpi());
+  GridRedBlackCartesian * UrbGrid = SpaceTimeGrid::makeFourDimRedBlackGrid(UGrid);
+  GridCartesian         * FGrid   = SpaceTimeGrid::makeFiveDimGrid(Ls,UGrid);
+  GridRedBlackCartesian * FrbGrid = SpaceTimeGrid::makeFiveDimRedBlackGrid(Ls,UGrid);
+
+  GridParallelRNG RNG4(UGrid);  RNG4.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+  GridParallelRNG RNG5(FGrid);  RNG5.SeedFixedIntegers(std::vector<int>({5,6,7,8}));
+
+  LatticeGaugeFieldD Umu(UGrid);
+  SU<Nc>::HotConfiguration(RNG4,Umu);
+
+  // Antiperiodic in time, twisted in x: the boundary legs take a different kappa
+  WilsonImplParams params;
+  params.boundary_phases[Nd-1] = -1.0;
+  params.twist_n_2pi_L[0]      = 0.5;
+
+  RealD mass=0.1;
+  RealD M5  =1.8;
+  RealD b   =1.5;
+  RealD c   =0.5;
+
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= Wilson: two row links against full storage"<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  {
+    WilsonFermionD               Dw (Umu,*UGrid,*UrbGrid,mass,params);
+    CompressedLinkWilsonFermionD Dwc(Umu,*UGrid,*UrbGrid,mass,CompressedLinkWilsonImplParams(params));
+    CompareOperators(Dw,Dwc,UGrid,UrbGrid,RNG4);
+  }
+
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= Mobius: two row links against full storage"<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  {
+    MobiusFermionD               Dm (Umu,*FGrid,*FrbGrid,*UGrid,*UrbGrid,mass,M5,b,c,params);
+    CompressedLinkMobiusFermionD Dmc(Umu,*FGrid,*FrbGrid,*UGrid,*UrbGrid,mass,M5,b,c,CompressedLinkWilsonImplParams(params));
+    CompareOperators(Dm,Dmc,FGrid,FrbGrid,RNG5);
+  }
+
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= Conserved current through the expanded links"<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  {
+    WilsonFermionD               Dw (Umu,*UGrid,*UrbGrid,mass,params);
+    CompressedLinkWilsonFermionD Dwc(Umu,*UGrid,*UrbGrid,mass,CompressedLinkWilsonImplParams(params));
+    LatticePropagatorD q1(UGrid); random(RNG4,q1);
+    LatticePropagatorD q2(UGrid); random(RNG4,q2);
+    LatticePropagatorD cf(UGrid);
+    LatticePropagatorD cc(UGrid);
+    Dw .ContractConservedCurrent(q1,q2,cf,q1,Current::Vector,Tdir);
+    Dwc.ContractConservedCurrent(q1,q2,cc,q1,Current::Vector,Tdir);
+    Compare("J_t   ",cf,cc);
+  }
+#endif
+  Grid_finalize();
+}
@@ -0,0 +1,171 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/core/Test_wilson_twist_phase.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+#ifdef ENABLE_TWIST_PHASE
+template<class Field>
+RealD Compare(const std::string &name,const Field &ref,const Field &res)
+{
+  Field err(ref.Grid());
+  err = ref - res;
+  RealD rel = std::sqrt(norm2(err)/norm2(ref));
+  std::cout<<GridLogMessage << name <<" links "<<norm2(ref)<<" kernel "<<norm2(res)<<" rel diff "<<rel<<std::endl;
+  assert(rel < 1.0e-10);
+  return rel;
+}
+
+// Twist folded into the links against twist applied in the kernels
+template<class Ref,class Twisted>
+void CompareOperators(Ref &Dr,Twisted &Dt,GridBase *FGrid,GridBase *FrbGrid,GridParallelRNG &RNG)
+{
+  typedef typename Ref::FermionField FermionField;
+
+  FermionField src(FGrid); random(RNG,src);
+  FermionField rr (FGrid);
+  FermionField rt (FGrid);
+  FermionField src_e(FrbGrid);
+  FermionField rr_o (FrbGrid);
+  FermionField rt_o (FrbGrid);
+  pickCheckerboard(Even,src_e,src);
+
+  std::vector<int> opts({WilsonKernelsStatic::OptGeneric,WilsonKernelsStatic::OptHandUnroll});
+  std::vector<int> comms({WilsonKernelsStatic::CommsAndCompute,WilsonKernelsStatic::CommsThenCompute});
+  for(auto opt : opts){
+    for(auto comm : comms){
+      WilsonKernelsStatic::Opt   = opt;
+      WilsonKernelsStatic::Comms = comm;
+      std::cout<<GridLogMessage << "Opt "<<opt<<" Comms "<<comm<<std::endl;
+
+      Dr.M(src,rr);           Dt.M(src,rt);           Compare("M     ",rr,rt);
+      Dr.Mdag(src,rr);        Dt.Mdag(src,rt);        Compare("Mdag  ",rr,rt);
+      Dr.Dhop(src,rr,DaggerNo);  Dt.Dhop(src,rt,DaggerNo);  Compare("Dhop  ",rr,rt);
+      Dr.Dhop(src,rr,DaggerYes); Dt.Dhop(src,rt,DaggerYes); Compare("Dhop^+",rr,rt);
+      Dr.Meooe(src_e,rr_o);   Dt.Meooe(src_e,rt_o);   Compare("Meooe ",rr_o,rt_o);
+      Dr.MeooeDag(src_e,rr_o);Dt.MeooeDag(src_e,rt_o);Compare("Meo^+ ",rr_o,rt_o);
+    }
+  }
+  WilsonKernelsStatic::Opt   = WilsonKernelsStatic::OptGeneric;
+  WilsonKernelsStatic::Comms = WilsonKernelsStatic::CommsAndCompute;
+}
+#endif
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+#ifdef ENABLE_TWIST_PHASE
+  const int Ls=4;
+
+  GridCartesian         * UGrid   = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplexD::Nsimd()),GridDefaultMpi());
+  GridRedBlackCartesian * UrbGrid = SpaceTimeGrid::makeFourDimRedBlackGrid(UGrid);
+  GridCartesian         * FGrid   = SpaceTimeGrid::makeFiveDimGrid(Ls,UGrid);
+  GridRedBlackCartesian * FrbGrid = SpaceTimeGrid::makeFiveDimRedBlackGrid(Ls,UGrid);
+
+  GridParallelRNG RNG4(UGrid);  RNG4.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+  GridParallelRNG RNG5(FGrid);  RNG5.SeedFixedIntegers(std::vector<int>({5,6,7,8}));
+
+  LatticeGaugeFieldD Umu(UGrid);
+  SU<Nc>::HotConfiguration(RNG4,Umu);
+
+  // Antiperiodic in time; the twists are scanned over one shared operator
+  WilsonImplParams params;
+  params.boundary_phases[Nd-1] = -1.0;
+
+  std::vector<std::vector<RealD> > twists({ {0.0 ,0.0,0.0  ,0.0},
+					     {0.5 ,0.0,0.0  ,0.0},
+					     {0.25,1.0,-0.75,0.0},
+					     {0.0 ,0.0,0.0  ,0.5} });
+
+  RealD mass=0.1;
+  RealD M5  =1.8;
+  RealD b   =1.5;
+  RealD c   =0.5;
+
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= Wilson: twists in the kernels against twists in the links"<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  {
+    TwistPhaseWilsonFermionD Dw(Umu,*UGrid,*UrbGrid,mass,TwistPhaseWilsonImplParams(params));
+    for(auto twist : twists){
+      std::cout<<GridLogMessage<<"Twist "<<twist<<std::endl;
+      WilsonImplParams p(params);
+      for(int mu=0;mu<Nd;mu++) p.twist_n_2pi_L[mu] = twist[mu];
+      WilsonFermionD Dr(Umu,*UGrid,*UrbGrid,mass,p);
+      TwistPhaseFermion<TwistPhaseWilsonFermionD> Dt(Dw,twist);
+      CompareOperators(Dr,Dt,UGrid,UrbGrid,RNG4);
+    }
+    // The shared operator keeps its own (zero) twist
+    WilsonFermionD Dr(Umu,*UGrid,*UrbGrid,mass,params);
+    CompareOperators(Dr,Dw,UGrid,UrbGrid,RNG4);
+  }
+
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= Mobius: twists in the kernels against twists in the links"<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  {
+    TwistPhaseMobiusFermionD Dm(Umu,*FGrid,*FrbGrid,*UGrid,*UrbGrid,mass,M5,b,c,TwistPhaseWilsonImplParams(params));
+    std::vector<TwistPhaseFermion<TwistPhaseMobiusFermionD> *> Dt;
+    for(auto twist : twists) Dt.push_back(new TwistPhaseFermion<TwistPhaseMobiusFermionD>(Dm,twist));
+
+    // Interleave the twisted views of the one gauge field
+    for(int pass=0;pass<2;pass++){
+      for(int t=0;t<twists.size();t++){
+	std::cout<<GridLogMessage<<"Twist "<<twists[t]<<std::endl;
+	WilsonImplParams p(params);
+	for(int mu=0;mu<Nd;mu++) p.twist_n_2pi_L[mu] = twists[t][mu];
+	MobiusFermionD Dr(Umu,*FGrid,*FrbGrid,*UGrid,*UrbGrid,mass,M5,b,c,p);
+	CompareOperators(Dr,*Dt[t],FGrid,FrbGrid,RNG5);
+      }
+    }
+    for(auto D : Dt) delete D;
+  }
+
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= Conserved current through the twisted links"<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  {
+    WilsonImplParams p(params);
+    for(int mu=0;mu<Nd;mu++) p.twist_n_2pi_L[mu] = twists[2][mu];
+    WilsonFermionD           Dr(Umu,*UGrid,*UrbGrid,mass,p);
+    TwistPhaseWilsonFermionD Dw(Umu,*UGrid,*UrbGrid,mass,TwistPhaseWilsonImplParams(params));
+    TwistPhaseFermion<TwistPhaseWilsonFermionD> Dt(Dw,twists[2]);
+    LatticePropagatorD q1(UGrid); random(RNG4,q1);
+    LatticePropagatorD q2(UGrid); random(RNG4,q2);
+    LatticePropagatorD cr(UGrid);
+    LatticePropagatorD ct(UGrid);
+    for(int mu=0;mu<Nd;mu++){
+      Dr.ContractConservedCurrent(q1,q2,cr,q1,Current::Vector,mu);
+      Dt.ContractConservedCurrent(q1,q2,ct,q1,Current::Vector,mu);
+      Compare("J_mu  ",cr,ct);
+    }
+  }
+#endif
+  Grid_finalize();
+}
@@ -0,0 +1,139 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/core/Test_wilson_unroll_representations.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+template<class Field>
+RealD Compare(const std::string &name,const Field &gen,const Field &unr)
+{
+  Field err(gen.Grid());
+  err = gen - unr;
+  RealD rel = std::sqrt(norm2(err)/norm2(gen));
+  std::cout<<GridLogMessage << name <<" generic "<<norm2(gen)<<" unrolled "<<norm2(unr)<<" rel diff "<<rel<<std::endl;
+  assert(rel < 1.0e-12);
+  return rel;
+}
+
+// Generic and unrolled kernels on the same source, all legs and interior/exterior split
+template<class Action>
+void CompareKernels(const std::string &name,Action &D,GridBase *FGrid,GridBase *FrbGrid,GridParallelRNG &RNG)
+{
+  typedef typename Action::FermionField FermionField;
+
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= "<<name<<" : colour dimension "<<Action::Dimension<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+
+  FermionField src(FGrid); random(RNG,src);
+  FermionField rg (FGrid);
+  FermionField ru (FGrid);
+  FermionField src_e(FrbGrid);
+  FermionField rg_o (FrbGrid);
+  FermionField ru_o (FrbGrid);
+  pickCheckerboard(Even,src_e,src);
+
+  std::vector<int> comms({WilsonKernelsStatic::CommsAndCompute,WilsonKernelsStatic::CommsThenCompute});
+  for(auto comm : comms){
+    WilsonKernelsStatic::Comms = comm;
+    std::cout<<GridLogMessage << "Comms "<<comm<<std::endl;
+#define UNROLL_COMPARE(NAME,CALL_G,CALL_U,RG,RU)			\
+    WilsonKernelsStatic::Opt = WilsonKernelsStatic::OptGeneric;    CALL_G; \
+    WilsonKernelsStatic::Opt = WilsonKernelsStatic::OptHandUnroll; CALL_U; \
+    Compare(NAME,RG,RU);
+    UNROLL_COMPARE("Dhop  ",D.Dhop(src,rg,DaggerNo), D.Dhop(src,ru,DaggerNo), rg,ru);
+    UNROLL_COMPARE("Dhop^+",D.Dhop(src,rg,DaggerYes),D.Dhop(src,ru,DaggerYes),rg,ru);
+    UNROLL_COMPARE("Meooe ",D.Meooe(src_e,rg_o),     D.Meooe(src_e,ru_o),     rg_o,ru_o);
+    UNROLL_COMPARE("Meo^+ ",D.MeooeDag(src_e,rg_o),  D.MeooeDag(src_e,ru_o),  rg_o,ru_o);
+#undef UNROLL_COMPARE
+  }
+
+  // Timing of the two kernels
+  int ncall=100;
+  GridBase *grid = FGrid;
+  RealD volume = grid->gSites();
+  RealD Dim    = Action::Dimension;
+  RealD flops  = 8.0*(2.0*Dim*(8.0*Dim-2.0) + 12.0*Dim); // per leg: 2 colour matvecs, projection, reconstruction
+  std::vector<int> opts({WilsonKernelsStatic::OptGeneric,WilsonKernelsStatic::OptHandUnroll});
+  for(auto opt : opts){
+    WilsonKernelsStatic::Opt   = opt;
+    WilsonKernelsStatic::Comms = WilsonKernelsStatic::CommsThenCompute;
+    D.Dhop(src,rg,DaggerNo);
+    double t0=usecond();
+    for(int i=0;i<ncall;i++) D.Dhop(src,rg,DaggerNo);
+    double t1=usecond();
+    std::cout<<GridLogMessage << name << (opt==WilsonKernelsStatic::OptGeneric ? " generic " : " unrolled ")
+	     << (t1-t0)/ncall<<" us per Dhop, "<< flops*volume*ncall/(t1-t0)/1000.<<" Gflop/s"<<std::endl;
+  }
+  WilsonKernelsStatic::Opt   = WilsonKernelsStatic::OptGeneric;
+  WilsonKernelsStatic::Comms = WilsonKernelsStatic::CommsAndCompute;
+}
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  GridCartesian         * UGrid   = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplexD::Nsimd()),GridDefaultMpi());
+  GridRedBlackCartesian * UrbGrid = SpaceTimeGrid::makeFourDimRedBlackGrid(UGrid);
+
+  GridParallelRNG RNG4(UGrid);  RNG4.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+
+  LatticeGaugeFieldD Umu(UGrid);
+  SU<Nc>::HotConfiguration(RNG4,Umu);
+
+  WilsonImplParams params;
+  params.boundary_phases[Nd-1] = -1.0;
+  RealD mass=0.1;
+
+  {
+    WilsonFermionD Dw(Umu,*UGrid,*UrbGrid,mass,params);
+    CompareKernels("Fundamental",Dw,UGrid,UrbGrid,RNG4);
+  }
+  {
+    AdjointRepresentation Adj(UGrid);
+    Adj.update_representation(Umu);
+    WilsonAdjFermionD Dw(Adj.U,*UGrid,*UrbGrid,mass,params);
+    CompareKernels("Adjoint",Dw,UGrid,UrbGrid,RNG4);
+  }
+  {
+    TwoIndexSymmetricRepresentation TwoS(UGrid);
+    TwoS.update_representation(Umu);
+    WilsonTwoIndexSymmetricFermionD Dw(TwoS.U,*UGrid,*UrbGrid,mass,params);
+    CompareKernels("Two index symmetric",Dw,UGrid,UrbGrid,RNG4);
+  }
+  {
+    TwoIndexAntiSymmetricRepresentation TwoA(UGrid);
+    TwoA.update_representation(Umu);
+    WilsonTwoIndexAntiSymmetricFermionD Dw(TwoA.U,*UGrid,*UrbGrid,mass,params);
+    CompareKernels("Two index antisymmetric",Dw,UGrid,UrbGrid,RNG4);
+  }
+
+  Grid_finalize();
+}
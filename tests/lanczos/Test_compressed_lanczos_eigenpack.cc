@@ -0,0 +1,115 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/Test_compressed_lanczos_eigenpack.cc
+
+    Copyright (C) 2017
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+/*
+ *  Round trip of the compressed (block basis + coarse coefficient) eigenvector storage,
+ *  and check the lazy deflation against DeflatedGuesser on fully promoted vectors.
+ */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+int main (int argc, char ** argv) {
+
+  Grid_init(&argc,&argv);
+
+  const int nbasis = 8;
+  const int neig   = 12;
+  const int nfull  = 4;
+
+  GridCartesian         * UGrid     = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(),
+								     GridDefaultSimd(Nd,vComplex::Nsimd()),
+								     GridDefaultMpi());
+
+  Coordinate fineLatt = GridDefaultLatt();
+  Coordinate coarseLatt(Nd);
+  for (int d=0;d<Nd;d++){
+    coarseLatt[d] = fineLatt[d]/2;    assert(coarseLatt[d]*2==fineLatt[d]);
+  }
+  GridCartesian         * CoarseGrid = SpaceTimeGrid::makeFourDimGrid(coarseLatt, GridDefaultSimd(Nd,vComplex::Nsimd()),GridDefaultMpi());
+
+  std::vector<int> seeds({1,2,3,4});
+  GridParallelRNG          RNGf(UGrid);      RNGf.SeedFixedIntegers(seeds);
+  GridParallelRNG          RNGc(CoarseGrid); RNGc.SeedFixedIntegers(seeds);
+
+  typedef LocalCoherenceEigenPack<vSpinColourVector,vTComplex,nbasis> EigenPack;
+  typedef EigenPack::CoarseField CoarseField;
+
+  EigenPack pack(UGrid,CoarseGrid,0);
+  pack.resize(neig);
+  for(int b=0;b<nbasis;b++) random(RNGf,pack.subspace[b]);
+  {
+    Lattice<vTComplex> ip(CoarseGrid);
+    blockOrthonormalize(ip,pack.subspace);
+  }
+  for(int i=0;i<neig;i++) {
+    random(RNGc,pack.evec_coarse[i]);
+    pack.eval[i] = 1.0+i;
+  }
+
+  std::string stem("./eigenpack");
+  pack.write(stem,nfull);
+
+  EigenPack check(UGrid,CoarseGrid,0);
+  check.read(stem);
+  assert(check.size()==neig);
+
+  LatticeFermion diff(UGrid);
+  CoarseField    cdiff(CoarseGrid);
+  for(int b=0;b<nbasis;b++){
+    diff = pack.subspace[b]-check.subspace[b];
+    std::cout << GridLogMessage << "basis  " << b << " diff " << norm2(diff) << std::endl;
+    assert(norm2(diff)==0.0);
+  }
+  for(int i=0;i<neig;i++){
+    cdiff = pack.evec_coarse[i]-check.evec_coarse[i];
+    RealD tol = (i<nfull) ? 0.0 : 1.0e-12*norm2(pack.evec_coarse[i]);
+    std::cout << GridLogMessage << "coarse " << i << " diff " << norm2(cdiff) << std::endl;
+    assert(norm2(cdiff)<=tol);
+    assert(check.eval[i]==pack.eval[i]);
+  }
+
+  std::vector<LatticeFermion> evec;
+  check.reconstruct(evec,neig);
+
+  LatticeFermion src(UGrid);   random(RNGf,src);
+  LatticeFermion guess(UGrid);
+  LatticeFermion lazy(UGrid);
+
+  DeflatedGuesser<LatticeFermion>                               Full(evec,check.eval);
+  LocalCoherenceEigenPackGuesser<vSpinColourVector,vTComplex,nbasis> Lazy(check);
+  Full(src,guess);
+  Lazy(src,lazy);
+
+  diff = guess-lazy;
+  std::cout << GridLogMessage << "DeflatedGuesser vs lazy reconstruction diff " << norm2(diff)
+	    << " / " << norm2(guess) << std::endl;
+  assert(norm2(diff) < 1.0e-20*norm2(guess));
+
+  Grid_finalize();
+}
@@ -0,0 +1,134 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid 
+
+    Source file: ./tests/solver/Test_dwf_mrhs_schur_split.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+int main (int argc, char ** argv)
+{
+  typedef typename DomainWallFermionR::FermionField FermionField; 
+
+  const int Ls=4;
+
+  Grid_init(&argc,&argv);
+
+  Coordinate mpi_layout  = GridDefaultMpi();
+  Coordinate mpi_split (mpi_layout.size(),1);
+
+  GridCartesian         * UGrid   = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), 
+								   GridDefaultSimd(Nd,vComplex::Nsimd()),
+								   GridDefaultMpi());
+  GridCartesian         * FGrid   = SpaceTimeGrid::makeFiveDimGrid(Ls,UGrid);
+  GridRedBlackCartesian * rbGrid  = SpaceTimeGrid::makeFourDimRedBlackGrid(UGrid);
+  GridRedBlackCartesian * FrbGrid = SpaceTimeGrid::makeFiveDimRedBlackGrid(Ls,UGrid);
+
+  /////////////////////////////////////////////
+  // Split into 1^4 mpi communicators unless
+  // --split says otherwise; one more source than
+  // subcommunicators so the leftover full grid
+  // path is exercised too. Run with --mpi giving
+  // more ranks than the split, e.g.
+  //   mpirun -np 4 ./Test_dwf_mrhs_schur_split --mpi 1.1.2.2
+  /////////////////////////////////////////////
+  for(int i=0;i<argc;i++){
+    if(std::string(argv[i]) == "--split"){
+      for(int k=0;k<mpi_layout.size();k++){
+	std::stringstream ss; 
+	ss << argv[i+1+k]; 
+	ss >> mpi_split[k];
+      }
+      break;
+    }
+  }
+
+  int nsplit = 1;
+  for(int i=0;i<mpi_layout.size();i++) nsplit *= (mpi_layout[i]/mpi_split[i]);
+  if ( nsplit < 2 ) {
+    std::cout << GridLogError << "Test_dwf_mrhs_schur_split needs more ranks than the split; got "
+	      << mpi_layout << " split " << mpi_split << std::endl;
+    assert(nsplit > 1);
+  }
+
+  int me;
+  GridCartesian         * SGrid = new GridCartesian(GridDefaultLatt(),
+						    GridDefaultSimd(Nd,vComplex::Nsimd()),
+						    mpi_split,
+						    *UGrid,me); 
+
+  GridCartesian         * SFGrid   = SpaceTimeGrid::makeFiveDimGrid(Ls,SGrid);
+  GridRedBlackCartesian * SrbGrid  = SpaceTimeGrid::makeFourDimRedBlackGrid(SGrid);
+  GridRedBlackCartesian * SFrbGrid = SpaceTimeGrid::makeFiveDimRedBlackGrid(Ls,SGrid);
+
+  int nrhs = nsplit+1;
+
+  std::vector<int> seeds({1,2,3,4});
+  GridParallelRNG pRNG(UGrid );  pRNG.SeedFixedIntegers(seeds);
+  GridParallelRNG pRNG5(FGrid);  pRNG5.SeedFixedIntegers(seeds);
+
+  std::vector<FermionField> src(nrhs,FGrid);
+  std::vector<FermionField> result(nrhs,FGrid);
+  FermionField ref(FGrid);
+  FermionField tmp(FGrid);
+  for(int s=0;s<nrhs;s++) random(pRNG5,src[s]);
+  for(int s=0;s<nrhs;s++) result[s]=Zero();
+
+  LatticeGaugeField Umu(UGrid); SU<Nc>::HotConfiguration(pRNG,Umu);
+  LatticeGaugeField s_Umu(SGrid);
+  Grid_split  (Umu,s_Umu);
+
+  RealD mass=0.01;
+  RealD M5=1.8;
+  DomainWallFermionR Ddwf(Umu,*FGrid,*FrbGrid,*UGrid,*rbGrid,mass,M5);
+  DomainWallFermionR Dsplit(s_Umu,*SFGrid,*SFrbGrid,*SGrid,*SrbGrid,mass,M5);
+
+  ConjugateGradient<FermionField> CG(1.0e-10,10000);
+  SchurRedBlackDiagMooeeSolve<FermionField> SchurSolver(CG);
+
+  std::cout << GridLogMessage << "****************************************************************** "<<std::endl;
+  std::cout << GridLogMessage << " Split grid Schur solve for "<<nrhs<<" sources"<<std::endl;
+  std::cout << GridLogMessage << "****************************************************************** "<<std::endl;
+  SchurSolver.SetSplitGridMatrix(Dsplit);
+  assert(SchurSolver.SplitGridCount(Ddwf) == nsplit);
+  SchurSolver(Ddwf,src,result);
+  SchurSolver.ClearSplitGridMatrix();
+
+  std::cout << GridLogMessage << "****************************************************************** "<<std::endl;
+  std::cout << GridLogMessage << " Checking against one source at a time on the full grid"<<std::endl;
+  std::cout << GridLogMessage << "****************************************************************** "<<std::endl;
+  for(int n=0;n<nrhs;n++){
+    ref = Zero();
+    SchurSolver(Ddwf,src[n],ref);
+    tmp = ref - result[n];
+    RealD diff = norm2(tmp)/norm2(ref);
+    std::cout << GridLogMessage<<" rhs["<<n<<"] |split-full|^2/|full|^2 "<< diff <<std::endl;
+    assert(diff < 1.0e-12);
+  }
+
+  Grid_finalize();
+}